@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define ECS_BENCH_FORK
+#endif
+
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/movement.h"
+#include "ecs/query.h"
+#include "ecs/snapshot.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::ConstEntityRef;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Position;
+using engine::ecs::Snapshot;
+using engine::ecs::Velocity;
+using engine::ecs::View;
+
+struct Health {
+  int points{100};
+};
+
+struct Rotation {
+  float angle{0.0F};
+};
+
+namespace {
+
+/**
+ * @brief Number of calls of the global allocation functions since the start of the process.
+ */
+std::atomic<std::size_t> allocation_count{0};
+
+void* Allocate(std::size_t size, std::size_t alignment) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* memory = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    memory = std::malloc(std::max<std::size_t>(size, 1));
+  } else {
+    // aligned_alloc() requires a multiple of the alignment as size.
+    memory = std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment);
+  }
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+}  // namespace
+
+// Every allocation of the process goes through these replacements, so the benchmarks can count them.
+void* operator new(std::size_t size) { return Allocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace {
+
+/**
+ * @brief The world a benchmark runs on, prepared before the measured operation.
+ */
+struct Fixture final {
+  EntityCollection entities;  ///< The benchmarked world.
+  std::vector<EntityID> ids;  ///< IDs the operation works on.
+  EntityCollection clone;     ///< Destination of the clone benchmark.
+};
+
+/**
+ * @brief A benchmarked operation, applied to every entity of a world of a given size.
+ */
+struct Benchmark final {
+  std::string_view name;                              ///< Name of the benchmark in the report.
+  std::function<void(Fixture&, std::size_t)> set_up;  ///< Prepares the world, not measured.
+  std::function<void(Fixture&)> run;                  ///< The measured operation.
+};
+
+/**
+ * @brief The measurements of a benchmark at one world size.
+ */
+struct Measurement final {
+  std::size_t repetitions{0};       ///< Number of measured runs.
+  double best_nanoseconds{0};       ///< Duration of the fastest run.
+  double mean_nanoseconds{0};       ///< Mean duration of the runs.
+  double allocations{0};            ///< Mean number of allocations of a run.
+  std::int64_t peak_rss_bytes{-1};  ///< Peak resident set size of the process that ran it, -1 if unknown.
+};
+
+/**
+ * @brief Minimum measured time per benchmark and size; runs are repeated until it is reached.
+ */
+constexpr std::chrono::milliseconds kMinDuration{200};
+
+/**
+ * @brief Maximum number of measured runs per benchmark and size.
+ */
+constexpr std::size_t kMaxRepetitions = 1000;
+
+ComponentCollection MakePrototype(bool with_all) {
+  ComponentCollection prototype;
+  prototype.Emplace<Position>(1.0F, 2.0F);
+  prototype.Emplace<Velocity>(0.5F, -0.5F);
+  if (with_all) {
+    prototype.Emplace<Health>();
+    prototype.Emplace<Rotation>();
+  }
+  return prototype;
+}
+
+void Populate(Fixture& fixture, std::size_t count, bool with_all = true) {
+  std::span<const EntityID> ids = fixture.entities.InsertBatch(count, MakePrototype(with_all));
+  fixture.ids.assign(ids.begin(), ids.end());
+}
+
+std::vector<Benchmark> MakeBenchmarks() {
+  return {
+      {"create", [](Fixture& fixture, std::size_t count) { fixture.ids.resize(count); },
+       [](Fixture& fixture) {
+         ComponentCollection prototype = MakePrototype(true);
+         for (EntityID& id : fixture.ids) {
+           id = fixture.entities.Insert(prototype).first;
+         }
+       }},
+      {"destroy", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) {
+         for (const EntityID& id : fixture.ids) {
+           fixture.entities.Erase(id);
+         }
+       }},
+      {"add-component", [](Fixture& fixture, std::size_t count) { Populate(fixture, count, false); },
+       [](Fixture& fixture) {
+         for (const EntityID& id : fixture.ids) {
+           fixture.entities.Emplace<Health>(id);
+         }
+       }},
+      {"remove-component", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) {
+         for (const EntityID& id : fixture.ids) {
+           fixture.entities.Remove<Health>(id);
+         }
+       }},
+      {"iterate-1", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) {
+         View<Position>(fixture.entities).Each([](Position& position) { position.x_coord += 1.0F; });
+       }},
+      {"iterate-2", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) {
+         View<Position, const Velocity>(fixture.entities).Each([](Position& position, const Velocity& velocity) {
+           position.x_coord += velocity.x_speed;
+           position.y_coord += velocity.y_speed;
+         });
+       }},
+      {"iterate-4", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) {
+         View<Position, const Velocity, Health, const Rotation>(fixture.entities)
+             .Each([](Position& position, const Velocity& velocity, Health& health, const Rotation& rotation) {
+               position.x_coord += velocity.x_speed * rotation.angle;
+               position.y_coord += velocity.y_speed * rotation.angle;
+               health.points -= 1;
+             });
+       }},
+      {"predicate-filter", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) {
+         std::vector<EntityID> found = fixture.entities.Filter([](const ConstEntityRef& entity) {
+           const auto* health = entity.Get<Health>();
+           return health != nullptr && health->points > 50;
+         });
+         static_cast<void>(found);
+       }},
+      {"hierarchy-erase",
+       [](Fixture& fixture, std::size_t count) {
+         // Roots with seven children each; erasing a root erases its subtree.
+         constexpr std::size_t kSubtreeSize = 8;
+         ComponentCollection prototype = MakePrototype(true);
+         for (std::size_t i = 0; i < count; i += kSubtreeSize) {
+           EntityID root_id = fixture.entities.Insert(prototype).first;
+           static_cast<void>(fixture.entities.InsertBatch(std::min(kSubtreeSize, count - i) - 1, prototype, root_id));
+           fixture.ids.push_back(root_id);
+         }
+       },
+       [](Fixture& fixture) {
+         for (const EntityID& id : fixture.ids) {
+           fixture.entities.Erase(id);
+         }
+       }},
+      {"world-clone", [](Fixture& fixture, std::size_t count) { Populate(fixture, count); },
+       [](Fixture& fixture) { Snapshot::Load(fixture.clone, Snapshot::Save(fixture.entities)); }},
+  };
+}
+
+/**
+ * @brief Runs a benchmark repeatedly on fresh worlds of a given size.
+ */
+Measurement Measure(const Benchmark& benchmark, std::size_t count) {
+  Measurement measurement;
+  std::chrono::nanoseconds total{0};
+  double allocations = 0;
+  measurement.best_nanoseconds = std::numeric_limits<double>::max();
+  while (measurement.repetitions < kMaxRepetitions && (measurement.repetitions == 0 || total < kMinDuration)) {
+    Fixture fixture;
+    benchmark.set_up(fixture, count);
+    std::size_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    benchmark.run(fixture);
+    auto duration = std::chrono::steady_clock::now() - start;
+    allocations += static_cast<double>(allocation_count.load(std::memory_order_relaxed) - allocations_before);
+    total += duration;
+    measurement.best_nanoseconds =
+        std::min(measurement.best_nanoseconds, static_cast<double>(std::chrono::nanoseconds(duration).count()));
+    ++measurement.repetitions;
+  }
+  auto repetitions = static_cast<double>(measurement.repetitions);
+  measurement.mean_nanoseconds = static_cast<double>(total.count()) / repetitions;
+  measurement.allocations = allocations / repetitions;
+  return measurement;
+}
+
+/**
+ * @brief Measures a benchmark in a child process where possible, so that the peak resident set size is its own.
+ */
+Measurement MeasureIsolated(const Benchmark& benchmark, std::size_t count) {
+#ifdef ECS_BENCH_FORK
+  int pipe_ends[2];
+  if (pipe(pipe_ends) == 0) {
+    pid_t child = fork();
+    if (child == 0) {
+      close(pipe_ends[0]);
+      Measurement measurement = Measure(benchmark, count);
+      bool is_written = write(pipe_ends[1], &measurement, sizeof(measurement)) == sizeof(measurement);
+      _exit(is_written ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(pipe_ends[1]);
+    Measurement measurement;
+    bool is_read = child > 0 && read(pipe_ends[0], &measurement, sizeof(measurement)) == sizeof(measurement);
+    close(pipe_ends[0]);
+    int status = 0;
+    rusage usage{};
+    if (is_read && wait4(child, &status, 0, &usage) == child && WIFEXITED(status) &&
+        WEXITSTATUS(status) == EXIT_SUCCESS) {
+#ifdef __APPLE__
+      measurement.peak_rss_bytes = usage.ru_maxrss;
+#else
+      measurement.peak_rss_bytes = static_cast<std::int64_t>(usage.ru_maxrss) * 1024;
+#endif
+      return measurement;
+    }
+    if (child > 0) {
+      waitpid(child, &status, 0);
+    }
+  }
+#endif
+  return Measure(benchmark, count);
+}
+
+void PrintUsage() {
+  std::cerr << "Usage: ecs-bench [--sizes=N,N,...] [benchmark...]\n"
+               "Runs the ECS benchmarks, by default at 1000, 100000 and 1000000 entities, and prints the results as\n"
+               "JSON on the standard output.\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::size_t> sizes{1000, 100000, 1000000};
+  std::vector<std::string_view> selected;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view argument = argv[i];
+    if (argument.starts_with("--sizes=")) {
+      sizes.clear();
+      std::string list(argument.substr(8));
+      for (std::size_t first = 0; first < list.size();) {
+        std::size_t last = std::min(list.find(',', first), list.size());
+        sizes.push_back(std::strtoull(list.substr(first, last - first).c_str(), nullptr, 10));
+        first = last + 1;
+      }
+    } else if (argument == "--help" || argument.starts_with("-")) {
+      PrintUsage();
+      return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else {
+      selected.push_back(argument);
+    }
+  }
+
+  std::vector<Benchmark> benchmarks = MakeBenchmarks();
+  std::cout << "{\n  \"benchmarks\": [";
+  bool is_first = true;
+  for (const Benchmark& benchmark : benchmarks) {
+    if (!selected.empty() && std::find(selected.begin(), selected.end(), benchmark.name) == selected.end()) {
+      continue;
+    }
+    for (std::size_t count : sizes) {
+      if (count == 0) {
+        continue;
+      }
+      Measurement measurement = MeasureIsolated(benchmark, count);
+      auto entities = static_cast<double>(count);
+      std::string peak_rss =
+          measurement.peak_rss_bytes < 0 ? "null" : std::to_string(measurement.peak_rss_bytes);
+      char line[512];
+      std::snprintf(line, sizeof(line),
+                    "%s\n    {\"name\": \"%.*s\", \"entities\": %zu, \"repetitions\": %zu, \"ns_per_entity\": %.3f, "
+                    "\"mean_ns_per_entity\": %.3f, \"allocations_per_entity\": %.4f, \"peak_rss_bytes\": %s}",
+                    is_first ? "" : ",", static_cast<int>(benchmark.name.size()), benchmark.name.data(), count,
+                    measurement.repetitions, measurement.best_nanoseconds / entities,
+                    measurement.mean_nanoseconds / entities, measurement.allocations / entities, peak_rss.c_str());
+      std::cout << line << std::flush;
+      is_first = false;
+    }
+  }
+  std::cout << "\n  ]\n}\n";
+  return EXIT_SUCCESS;
+}
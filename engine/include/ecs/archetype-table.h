@@ -0,0 +1,529 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ecs/change-tick.h"
+#include "ecs/component-base.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-id.h"
+#include "memory/arena.h"
+namespace engine::ecs {
+
+/**
+ * @brief Size in bytes of a single chunk of an archetype table.
+ */
+inline constexpr std::size_t kChunkSize = 16 * 1024;
+
+/**
+ * @brief Alignment in bytes of chunks and of every column inside a chunk.
+ */
+inline constexpr std::size_t kChunkAlignment = 64;
+
+/**
+ * @typedef ArchetypeLayout
+ * @brief A list of component descriptors, sorted by type ID and free of duplicates, that describes the columns of an
+ * archetype table. Tag components have no column.
+ */
+using ArchetypeLayout = std::vector<const ComponentInfo*>;
+
+/**
+ * @brief Builds the layout of the columns of the table that stores the component types of a signature.
+ *
+ * @param[in] signature The component types of the table. Every type must be registered.
+ * @return The layout of the table, without the tag components of the signature.
+ */
+[[nodiscard]] ArchetypeLayout MakeArchetypeLayout(const ComponentSignature& signature);
+
+/**
+ * @brief Computes the signature of the component types of a layout.
+ *
+ * @param[in] layout The layout to describe.
+ * @return The signature of the layout, which holds no tag components.
+ */
+[[nodiscard]] ComponentSignature MakeSignature(const ArchetypeLayout& layout) noexcept;
+
+/**
+ * @class ArchetypeTable
+ * @brief Storage for all entities that share exactly the same set of component types.
+ *
+ * Rows of the table are split into fixed-size chunks of kChunkSize bytes. Inside a chunk every component type owns
+ * one contiguous array (structure of arrays), so iterating one component type over a table reads memory linearly.
+ * Rows are densely packed: every chunk except the last one is full, and removing a row moves the last row into the
+ * freed slot. Tag components are part of the signature of the table but own no column, so tables that differ only
+ * by tags have the same layout and moving an entity between them copies only its data components.
+ *
+ * Rows are addressed by a table-wide index; `row / ChunkCapacity()` is the chunk and `row % ChunkCapacity()` is the
+ * position inside that chunk.
+ *
+ * Every component carries ComponentTicks, and every chunk keeps, per column, the greatest ticks of its rows. New rows
+ * are stamped as added at the current change tick of the owning collection; MarkChanged() stamps mutable accesses.
+ * A stamp of every row of a column of a chunk is recorded once for the chunk instead of once per row, and is spread to
+ * the rows only before a row with older ticks is moved into the chunk.
+ * Chunk ticks never decrease while rows are stored, so a chunk whose ticks are not newer than a reader's tick can be
+ * skipped as a whole. Every chunk also records the tick at which rows were last added to it, removed from it or moved
+ * within it, so that copies of the table (see SnapshotRing) can tell which chunks no longer hold the same entities.
+ */
+class ArchetypeTable final {
+ public:
+  /**
+   * @brief Special value returned by FindColumn() when the table has no column of the requested type.
+   */
+  static constexpr std::size_t kNoColumn = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief Creates an empty table for the specified component types.
+   * @param signature The component types stored by the table. Every type must be registered.
+   * @param arena The arena that provides the chunks of the table, which must outlive the table.
+   * @param change_tick The current change tick of the owning collection, which must outlive the table.
+   */
+  ArchetypeTable(const ComponentSignature& signature, memory::Arena& arena, const std::atomic<Tick>& change_tick);
+
+  /**
+   * @brief Destroys all rows of the table. Its chunks are reclaimed together with the arena.
+   */
+  ~ArchetypeTable();
+
+  ArchetypeTable(const ArchetypeTable&) = delete;
+  ArchetypeTable& operator=(const ArchetypeTable&) = delete;
+
+  /**
+   * @name Table State Methods
+   * @{
+   */
+
+  /**
+   * @brief Retrieves the number of rows in the table.
+   * @return The number of rows in the table.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  /**
+   * @brief Checks if the table has no rows.
+   * @return True if the table is empty, otherwise false.
+   */
+  [[nodiscard]] bool Empty() const noexcept;
+
+  /**
+   * @brief Destroys all rows of the table. Allocated chunks are kept for reuse.
+   */
+  void Clear();
+
+  /**
+   * @brief Retrieves the component types stored by the table.
+   * @return The layout of the table.
+   */
+  [[nodiscard]] const ArchetypeLayout& Layout() const noexcept;
+
+  /**
+   * @brief Retrieves the signature of the component types stored by the table.
+   * @return The signature of the table.
+   */
+  [[nodiscard]] const ComponentSignature& Signature() const noexcept;
+
+  /**
+   * @brief Retrieves the maximum number of rows stored in a single chunk.
+   * @return The capacity of a chunk in rows.
+   */
+  [[nodiscard]] std::size_t ChunkCapacity() const noexcept;
+
+  /**
+   * @brief Retrieves the number of chunks that currently hold at least one row.
+   * @return The number of used chunks.
+   */
+  [[nodiscard]] std::size_t ChunkCount() const noexcept;
+
+  /**
+   * @brief Retrieves the number of rows stored in the specified chunk.
+   * @param chunk_index The index of the chunk, less than ChunkCount().
+   * @return The number of rows in the chunk.
+   */
+  [[nodiscard]] std::size_t ChunkSize(std::size_t chunk_index) const noexcept;
+
+  /**
+   * @brief Retrieves the number of bytes of a single chunk.
+   * @return The size of a chunk in bytes, 0 if the table has no columns and never allocates chunks.
+   */
+  [[nodiscard]] std::size_t ChunkBytes() const noexcept;
+
+  /**
+   * @brief Retrieves the number of chunks held by the table, including unused ones kept for later rows.
+   * @return The number of held chunks, adopted ones included.
+   */
+  [[nodiscard]] std::size_t HeldChunkCount() const noexcept;
+
+  /**
+   * @brief Retrieves the number of chunks handed to the table by AdoptChunks().
+   * @return The number of adopted chunks.
+   */
+  [[nodiscard]] std::size_t AdoptedChunkCount() const noexcept;
+
+  /**
+   * @brief Retrieves the number of heap bytes used by the table outside of its chunks: row owners, change ticks and
+   * the chunk list.
+   * @return The number of reserved bytes of the bookkeeping containers.
+   */
+  [[nodiscard]] std::size_t MetadataBytes() const noexcept;
+
+  /**
+   * @brief Retrieves the offset of a column from the start of every chunk.
+   * @param column The index of the column.
+   * @return The offset of the column in bytes, a multiple of kChunkAlignment.
+   */
+  [[nodiscard]] std::size_t ColumnOffset(std::size_t column) const noexcept;
+
+  /** @} */  // end of Table State Methods
+
+  /**
+   * @name Column Access Methods
+   * @{
+   */
+
+  /**
+   * @brief Finds the column that stores the specified component type.
+   * @param type_id The ID of the component type to look for.
+   * @return The index of the column, or kNoColumn if the table does not store this type.
+   */
+  [[nodiscard]] std::size_t FindColumn(ComponentTypeID type_id) const noexcept;
+
+  /**
+   * @brief Finds the column that stores the specified component type.
+   * @tparam ComponentType The component type to look for.
+   * @return The index of the column, or kNoColumn if the table does not store this type.
+   */
+  template <is_component ComponentType>
+  [[nodiscard]] std::size_t FindColumn() const noexcept;
+
+  /**
+   * @brief Checks if the table stores all of the specified component types.
+   * @tparam ComponentTypes The component types to check.
+   * @return True if every type has a column in the table, otherwise false.
+   */
+  template <is_component... ComponentTypes>
+  [[nodiscard]] bool HasAll() const noexcept;
+
+  /**
+   * @brief Checks if the table stores any of the specified component types.
+   * @tparam ComponentTypes The component types to check.
+   * @return True if at least one type has a column in the table, otherwise false.
+   */
+  template <is_component... ComponentTypes>
+  [[nodiscard]] bool HasAny() const noexcept;
+
+  /**
+   * @brief Retrieves the start of a column inside a chunk.
+   * @param column The index of the column.
+   * @param chunk_index The index of the chunk.
+   * @return A pointer to the first component of the column in the chunk.
+   */
+  [[nodiscard]] void* ColumnData(std::size_t column, std::size_t chunk_index) noexcept;
+
+  /**
+   * @copydoc ColumnData(std::size_t, std::size_t)
+   */
+  [[nodiscard]] const void* ColumnData(std::size_t column, std::size_t chunk_index) const noexcept;
+
+  /**
+   * @brief Retrieves a typed column inside a chunk.
+   * @tparam ComponentType The component type stored in the column.
+   * @param chunk_index The index of the chunk.
+   * @return A pointer to the first component of the column in the chunk, or nullptr if the type is not stored.
+   */
+  template <is_component ComponentType>
+  [[nodiscard]] ComponentType* Column(std::size_t chunk_index) noexcept;
+
+  /**
+   * @brief Retrieves a single component of a row.
+   * @param column The index of the column.
+   * @param row The index of the row.
+   * @return A pointer to the component.
+   */
+  [[nodiscard]] void* At(std::size_t column, std::size_t row) noexcept;
+
+  /**
+   * @copydoc At(std::size_t, std::size_t)
+   */
+  [[nodiscard]] const void* At(std::size_t column, std::size_t row) const noexcept;
+
+  /**
+   * @brief Retrieves the ID of the entity stored in a row.
+   * @param row The index of the row.
+   * @return The ID of the entity.
+   */
+  [[nodiscard]] const EntityID& EntityAt(std::size_t row) const noexcept;
+
+  /**
+   * @brief Retrieves the IDs of all entities stored in the table, in row order.
+   * @return The IDs of the stored entities.
+   */
+  [[nodiscard]] const std::vector<EntityID>& Entities() const noexcept;
+
+  /** @} */  // end of Column Access Methods
+
+  /**
+   * @name Change Detection Methods
+   * @{
+   */
+
+  /**
+   * @brief Retrieves the current change tick of the owning collection.
+   * @return The tick new stamps are made with.
+   */
+  [[nodiscard]] Tick CurrentTick() const noexcept;
+
+  /**
+   * @brief Retrieves the ticks of a single component.
+   * @param column The index of the column.
+   * @param row The index of the row.
+   * @return The ticks of the component, including a stamp of the whole column of its chunk.
+   */
+  [[nodiscard]] ComponentTicks RowTicks(std::size_t column, std::size_t row) const noexcept;
+
+  /**
+   * @brief Retrieves the greatest ticks of a column inside a chunk.
+   * @param column The index of the column.
+   * @param chunk_index The index of the chunk.
+   * @return Ticks that are not older than the ticks of any component of the column in the chunk.
+   */
+  [[nodiscard]] const ComponentTicks& ChunkTicks(std::size_t column, std::size_t chunk_index) const noexcept;
+
+  /**
+   * @brief Retrieves the tick at which the set or the order of the rows of a chunk last changed.
+   * @param chunk_index The index of the chunk.
+   * @return The tick of the last row added to, removed from or moved within the chunk.
+   */
+  [[nodiscard]] Tick ChunkRowsTick(std::size_t chunk_index) const noexcept;
+
+  /**
+   * @brief Stamps a component as changed at the current tick.
+   *
+   * Safe to call concurrently for distinct rows, even of one chunk, as long as no row is added, removed or moved.
+   *
+   * @param column The index of the column.
+   * @param row The index of the row.
+   */
+  void MarkChanged(std::size_t column, std::size_t row) noexcept;
+
+  /**
+   * @brief Stamps a range of components of a column as changed at the current tick.
+   * @param column The index of the column.
+   * @param first_row The index of the first row.
+   * @param count The number of rows, which must all belong to the chunk of `first_row`.
+   */
+  void MarkChanged(std::size_t column, std::size_t first_row, std::size_t count) noexcept;
+
+  /** @} */  // end of Change Detection Methods
+
+  /**
+   * @name Row Manipulation Methods
+   * @{
+   */
+
+  /**
+   * @brief Appends a row for the specified entity.
+   *
+   * The components of the new row are left uninitialized: the caller must construct every column of the row before
+   * the table is used again. They are stamped as added at the current tick.
+   *
+   * @param entity_id The ID of the entity that owns the row.
+   * @return The index of the new row.
+   */
+  [[nodiscard]] std::size_t PushBack(const EntityID& entity_id);
+
+  /**
+   * @brief Appends rows for the specified entities, allocating every missing chunk at once.
+   *
+   * The components of the new rows are left uninitialized, like for PushBack(const EntityID&). ConstructRows() and
+   * CopyConstructRows() initialize whole column ranges of them.
+   *
+   * @param entity_ids The IDs of the entities that own the rows, in row order.
+   * @return The index of the first new row.
+   */
+  [[nodiscard]] std::size_t PushBack(std::span<const EntityID> entity_ids);
+
+  /**
+   * @brief Default-constructs the components of a column over a range of uninitialized rows.
+   * @param column The index of the column.
+   * @param first_row The index of the first row.
+   * @param count The number of rows.
+   */
+  void ConstructRows(std::size_t column, std::size_t first_row, std::size_t count);
+
+  /**
+   * @brief Copy-constructs the components of a column over a range of uninitialized rows from a single value.
+   * @param column The index of the column.
+   * @param first_row The index of the first row.
+   * @param count The number of rows.
+   * @param source The component to copy, of the type stored in the column.
+   */
+  void CopyConstructRows(std::size_t column, std::size_t first_row, std::size_t count, const void* source);
+
+  /**
+   * @brief Copies consecutive components into a column over a range of rows with memcpy.
+   *
+   * The rows may be uninitialized or hold components, which are overwritten without being destroyed.
+   *
+   * @param column The index of the column, whose type must be trivially copyable.
+   * @param first_row The index of the first row.
+   * @param count The number of rows.
+   * @param source The first of `count` consecutive components of the type stored in the column.
+   */
+  void CopyRows(std::size_t column, std::size_t first_row, std::size_t count, const void* source);
+
+  /**
+   * @brief Hands chunks that live outside of the arena to an empty table, for its next rows to be stored in.
+   *
+   * The chunks are used before the chunks the table already owns, so rows appended by PushBack() take their
+   * components from them: a chunk whose columns were filled beforehand holds initialized rows right away. The memory
+   * must be writable, aligned to kChunkAlignment, ChunkBytes() long per chunk, and must outlive the table or its next
+   * Reset() by the owning collection.
+   *
+   * @param chunks The chunks to adopt, in row order.
+   */
+  void AdoptChunks(std::span<std::byte* const> chunks);
+
+  /**
+   * @brief Destroys a row and fills the gap with the last row of the table.
+   *
+   * After the call, if `row < Size()`, the entity returned by EntityAt(row) has been moved into the row.
+   *
+   * @param row The index of the row to remove.
+   */
+  void SwapRemove(std::size_t row);
+
+  /**
+   * @brief Moves a row into another table.
+   *
+   * Components whose types are stored by both tables are moved, components missing in the destination are
+   * destroyed, and columns of the destination that are missing in this table are left uninitialized for the caller
+   * to construct. Moved components keep their ticks. The gap left in this table is filled with its last row, like
+   * SwapRemove() does.
+   *
+   * @param row The index of the row to move.
+   * @param destination The table that receives the row.
+   * @return The index of the row in the destination table.
+   */
+  [[nodiscard]] std::size_t MoveRow(std::size_t row, ArchetypeTable& destination);
+
+  /**
+   * @brief Changes the number of rows of a table without constructing or destroying components.
+   *
+   * Meant for bringing a table back to a saved state. Every column of the table must be trivially copyable. New rows
+   * are owned by the root ID and their components are uninitialized until SetEntities() and CopyRows() fill them.
+   *
+   * @param row_count The new number of rows.
+   */
+  void Resize(std::size_t row_count);
+
+  /**
+   * @brief Replaces the owners of a range of rows.
+   * @param first_row The index of the first row.
+   * @param entity_ids The IDs of the new owners, in row order.
+   */
+  void SetEntities(std::size_t first_row, std::span<const EntityID> entity_ids);
+
+  /** @} */  // end of Row Manipulation Methods
+
+ private:
+  /**
+   * @brief Takes a new chunk from the arena and appends it to the table.
+   */
+  void AllocateChunk();
+
+  /**
+   * @brief Appends uninitialized rows owned by the root ID, allocating every missing chunk at once.
+   * @param count The number of rows.
+   * @return The index of the first new row.
+   */
+  std::size_t AppendRows(std::size_t count);
+
+  /**
+   * @brief Stamps the rows of the chunks that hold a range of rows as changed at the current tick.
+   * @param first_row The index of the first row.
+   * @param count The number of rows.
+   */
+  void MarkRowsChanged(std::size_t first_row, std::size_t count) noexcept;
+
+  /**
+   * @brief Raises the chunk ticks of a column to include the ticks of a row.
+   * @param column The index of the column.
+   * @param row The index of the row.
+   */
+  void RaiseChunkTicks(std::size_t column, std::size_t row) noexcept;
+
+  /**
+   * @brief Writes the whole-chunk stamps of a chunk into the ticks of its rows, then clears them, so that a row with
+   * older ticks can be moved into the chunk.
+   * @param chunk_index The index of the chunk.
+   */
+  void SpreadChunkStamps(std::size_t chunk_index) noexcept;
+
+  /**
+   * @brief Relocates the last row into `row` without destroying the components of `row`, then shrinks the table.
+   * @param row The index of the row whose components have already been destroyed or moved out.
+   */
+  void FillGap(std::size_t row);
+
+  /**
+   * @brief Calls a function for every chunk-contiguous part of a range of rows.
+   * @tparam Function A callable invoked as `function(std::byte* components, std::size_t count)`.
+   * @param column The index of the column.
+   * @param first_row The index of the first row.
+   * @param count The number of rows.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void ForEachSegment(std::size_t column, std::size_t first_row, std::size_t count, Function&& function);
+
+  /**
+   * @brief Marker stored in column_indices_ for component types without a column.
+   */
+  static constexpr std::uint16_t kNoColumnIndex = 0xFFFF;
+
+  ComponentSignature signature_;                                  ///< Component types stored by the table.
+  ArchetypeLayout layout_;                                        ///< Descriptors of the columns, in column order.
+  std::array<std::uint16_t, kMaxComponentTypes> column_indices_;  ///< Column of every component type ID.
+  std::vector<std::size_t> column_offsets_;                       ///< Offset of every column inside a chunk.
+  std::size_t chunk_capacity_{0};                                 ///< Number of rows per chunk.
+  std::size_t chunk_bytes_{0};                                    ///< Number of bytes allocated per chunk.
+  memory::Arena* arena_;                                          ///< Provider of the chunks.
+  std::vector<std::byte*> chunks_;                                ///< Allocated chunks, unused ones last.
+  std::size_t adopted_chunk_count_{0};                            ///< Number of chunks handed by AdoptChunks().
+  std::vector<EntityID> entities_;                                ///< Owner of every row, in row order.
+  const std::atomic<Tick>* change_tick_;                          ///< Current tick of the owning collection.
+  std::vector<std::vector<ComponentTicks>> row_ticks_;            ///< Ticks of every component, per column.
+  std::vector<ComponentTicks> chunk_ticks_;                       ///< Greatest ticks per chunk and column.
+  std::vector<Tick> chunk_rows_ticks_;                            ///< Tick of the last change of the rows per chunk.
+  std::vector<Tick> chunk_stamps_;                                ///< Stamp of every row per chunk and column.
+};
+
+template <is_component ComponentType>
+std::size_t ArchetypeTable::FindColumn() const noexcept {
+  return FindColumn(ComponentTypeIDOf<ComponentType>());
+}
+
+template <is_component... ComponentTypes>
+bool ArchetypeTable::HasAll() const noexcept {
+  return signature_.ContainsAll(ComponentSignatureOf<ComponentTypes...>());
+}
+
+template <is_component... ComponentTypes>
+bool ArchetypeTable::HasAny() const noexcept {
+  return signature_.ContainsAny(ComponentSignatureOf<ComponentTypes...>());
+}
+
+template <is_component ComponentType>
+ComponentType* ArchetypeTable::Column(std::size_t chunk_index) noexcept {
+  std::size_t column = FindColumn<ComponentType>();
+  if (column == kNoColumn) {
+    return nullptr;
+  }
+  return static_cast<ComponentType*>(ColumnData(column, chunk_index));
+}
+
+}  // namespace engine::ecs
@@ -1,7 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "ecs/archetype-table.h"
 #include "ecs/component-base.h"
 #include "ecs/component-collection.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/entity-ref.h"
 namespace engine::ecs {
 
 /**
@@ -11,6 +21,9 @@ namespace engine::ecs {
  * within a component collection in an ECS system. It provides functionality to check for required components,
  * create new instances of component collections, and supplement existing collections with missing components.
  *
+ * An Archetype also describes the ArchetypeTable that stores its entities inside an EntityCollection: Signature()
+ * is the identity of that table, and CreateInstance(EntityCollection&) constructs an entity directly in it.
+ *
  * @tparam RequiredComponentTypes Variadic template parameters representing the component types required by this
  * Archetype.
  */
@@ -28,6 +41,26 @@ class Archetype final {
    */
   [[nodiscard]] static bool IsPresentedIn(const ComponentCollection& collection) noexcept;
 
+  /**
+   * @brief Checks if all the required component types are stored by the given archetype table.
+   *
+   * Every entity of a matching table has all the required component types, so a single check covers the whole table.
+   *
+   * @param[in] table The archetype table to check against.
+   * @return true If all required component types are stored by the table, false otherwise.
+   */
+  [[nodiscard]] static bool IsPresentedIn(const ArchetypeTable& table) noexcept;
+
+  /**
+   * @brief Retrieves the signature of the required component types.
+   *
+   * The signature identifies the archetype table that stores exactly the required component types, and is the mask
+   * used by IsPresentedIn().
+   *
+   * @return The signature of the required component types.
+   */
+  [[nodiscard]] static const ComponentSignature& Signature() noexcept;
+
   /**
    * @brief Creates a new component collection instance containing all the required component types.
    *
@@ -38,6 +71,32 @@ class Archetype final {
    */
   [[nodiscard]] static ComponentCollection CreateInstance();
 
+  /**
+   * @brief Creates a new entity with default-constructed required components inside an entity collection.
+   *
+   * The components are constructed directly in the archetype table described by Signature(), without an intermediate
+   * component collection.
+   *
+   * @param[in] entities The entity collection that receives the new entity.
+   * @param[in] parent_id The ID of the parent entity to associate the new entity with.
+   * @return An ID-value pair indicating whether the insertion was successful and the ID of the new entity.
+   */
+  [[nodiscard]] static std::pair<EntityID, bool> CreateInstance(EntityCollection& entities,
+                                                                const EntityID& parent_id = EntityID::GetRootID());
+
+  /**
+   * @brief Creates many entities with default-constructed required components inside an entity collection.
+   *
+   * See EntityCollection::InsertBatch() for the guarantees of the batched insertion.
+   *
+   * @param[in] entities The entity collection that receives the new entities.
+   * @param[in] count The number of entities to create.
+   * @param[in] parent_id The ID of the parent entity to associate the new entities with.
+   * @return The IDs of the new entities, valid until the next structural change of the collection.
+   */
+  [[nodiscard]] static std::span<const EntityID> CreateInstances(EntityCollection& entities, std::size_t count,
+                                                                 const EntityID& parent_id = EntityID::GetRootID());
+
   /**
    * @brief Ensures the given component collection contains all the required component types.
    *
@@ -48,11 +107,32 @@ class Archetype final {
    * @return true If all required component types are successfully added to the collection, false otherwise.
    */
   [[maybe_unused]] static bool Supplement(ComponentCollection& collection);
+
+  /**
+   * @brief Adds the missing required component types to an existing entity, default-constructed.
+   *
+   * However many types are missing, the entity is moved between archetype tables at most once.
+   *
+   * @param[in] entities The entity collection that holds the entity.
+   * @param[in] entity_id The ID of the entity to supplement.
+   * @return true If the entity exists, false otherwise.
+   */
+  [[maybe_unused]] static bool Supplement(EntityCollection& entities, const EntityID& entity_id);
 };
 
 template <is_component... RequiredComponentTypes>
 bool Archetype<RequiredComponentTypes...>::IsPresentedIn(const ComponentCollection& collection) noexcept {
-  return collection.HasAll<RequiredComponentTypes...>();
+  return collection.GetSignature().ContainsAll(Signature());
+}
+
+template <is_component... RequiredComponentTypes>
+bool Archetype<RequiredComponentTypes...>::IsPresentedIn(const ArchetypeTable& table) noexcept {
+  return table.Signature().ContainsAll(Signature());
+}
+
+template <is_component... RequiredComponentTypes>
+const ComponentSignature& Archetype<RequiredComponentTypes...>::Signature() noexcept {
+  return ComponentSignatureOf<RequiredComponentTypes...>();
 }
 
 template <is_component... RequiredComponentTypes>
@@ -62,9 +142,31 @@ ComponentCollection Archetype<RequiredComponentTypes...>::CreateInstance() {
   return new_instance;
 }
 
+template <is_component... RequiredComponentTypes>
+std::pair<EntityID, bool> Archetype<RequiredComponentTypes...>::CreateInstance(EntityCollection& entities,
+                                                                             const EntityID& parent_id) {
+  return entities.InsertDefault(Signature(), parent_id);
+}
+
+template <is_component... RequiredComponentTypes>
+std::span<const EntityID> Archetype<RequiredComponentTypes...>::CreateInstances(EntityCollection& entities,
+                                                                              std::size_t count,
+                                                                              const EntityID& parent_id) {
+  return entities.InsertBatch(count, Signature(), parent_id);
+}
+
 template <is_component... RequiredComponentTypes>
 bool Archetype<RequiredComponentTypes...>::Supplement(ComponentCollection& collection) {
   return (collection.Emplace<RequiredComponentTypes>() && ...);
 }
 
-}  // namespace engine::ecs
\ No newline at end of file
+template <is_component... RequiredComponentTypes>
+bool Archetype<RequiredComponentTypes...>::Supplement(EntityCollection& entities, const EntityID& entity_id) {
+  if (!entities.Contains(entity_id)) {
+    return false;
+  }
+  ComponentSignature signature = std::as_const(entities).At(entity_id).GetSignature() | Signature();
+  return entities.Reshape(entity_id, signature, {});
+}
+
+}  // namespace engine::ecs
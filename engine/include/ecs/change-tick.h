@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ecs/component-signature.h"
+#include "ecs/entity-id.h"
+namespace engine::ecs {
+
+/**
+ * @typedef Tick
+ * @brief A point in the history of an EntityCollection, used to detect changes of components.
+ *
+ * Every collection keeps a monotonically increasing change tick, advanced by the Scheduler before every system runs.
+ * Component writes are stamped with the current tick, and a change is reported to a reader if its tick is greater
+ * than the tick the reader last looked at. Tick 0 lies before every change. The ticks are 64 bits wide so that they
+ * never wrap around.
+ */
+using Tick = std::uint64_t;
+
+/**
+ * @brief The ticks at which a component was added to its entity and last accessed mutably.
+ */
+struct ComponentTicks final {
+  Tick added{0};    ///< Tick of the insertion of the component.
+  Tick changed{0};  ///< Tick of the last mutable access, or of the insertion.
+};
+
+/**
+ * @brief A record of a component type that was removed from an entity that stays alive.
+ */
+struct RemovedComponent final {
+  EntityID entity_id;       ///< ID of the entity.
+  ComponentTypeID type_id;  ///< Type of the removed component.
+  Tick tick;                ///< Tick of the removal.
+};
+
+}  // namespace engine::ecs
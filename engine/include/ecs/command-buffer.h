@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ecs/component-base.h"
+#include "ecs/component-collection.h"
+#include "ecs/component-info.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/tag-component.h"
+#include "memory/pool-allocator.h"
+namespace engine::ecs {
+
+/**
+ * @class CommandBuffer
+ * @brief Records structural changes of an EntityCollection and applies them later, in one batch.
+ *
+ * Structural changes (inserting and erasing entities, emplacing and removing components) invalidate the references
+ * and iterators of a collection, so they cannot be made while a query runs. A command buffer records them instead,
+ * and Flush() applies them at a sync point where nothing iterates the collection.
+ *
+ * At flush time, commands are sorted by entity and coalesced: all commands recorded for the same entity are replayed
+ * against its component types first, and the entity is then moved between archetype tables at most once. The result
+ * is the same as applying the commands one by one, in recording order.
+ *
+ * A command buffer is not thread-safe; threads record into their own buffers (see CommandQueue).
+ */
+class CommandBuffer final {
+ public:
+  /**
+   * @brief Constructs an empty command buffer.
+   */
+  CommandBuffer() = default;
+
+  /**
+   * @brief Retrieves the number of recorded commands.
+   * @return The number of recorded commands.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  /**
+   * @brief Checks if no command is recorded.
+   * @return True if the buffer is empty, otherwise false.
+   */
+  [[nodiscard]] bool Empty() const noexcept;
+
+  /**
+   * @brief Discards every recorded command.
+   */
+  void Clear();
+
+  /**
+   * @brief Records the insertion of a new entity.
+   * @param entity_data The components of the new entity.
+   * @param parent_id The ID of the parent entity to associate the new entity with.
+   */
+  void Insert(ComponentCollection entity_data, const EntityID& parent_id = EntityID::GetRootID());
+
+  /**
+   * @brief Records the removal of an entity and its children.
+   * @param entity_id The ID of the entity to erase.
+   */
+  void Erase(const EntityID& entity_id);
+
+  /**
+   * @brief Records the addition of a component to an entity.
+   *
+   * As with EntityCollection::Emplace(), the command has no effect if the entity already has a component of this
+   * type when the command is applied.
+   *
+   * @tparam ComponentType The type of the component to be added.
+   * @tparam Args Types of the arguments to pass to the component's constructor.
+   * @param entity_id The ID of the entity.
+   * @param arguments The arguments forwarded to the constructor, which is called immediately.
+   */
+  template <is_component ComponentType, typename... Args>
+  void Emplace(const EntityID& entity_id, Args&&... arguments);
+
+  /**
+   * @brief Records the removal of a component from an entity.
+   * @tparam ComponentType The type of the component to be removed.
+   * @param entity_id The ID of the entity.
+   */
+  template <is_component ComponentType>
+  void Remove(const EntityID& entity_id);
+
+  /**
+   * @brief Moves the commands of another buffer after the commands of this one.
+   * @param other The buffer to take the commands from, left empty.
+   */
+  void Append(CommandBuffer&& other);
+
+  /**
+   * @brief Applies and discards every recorded command.
+   *
+   * Commands that target entities which no longer exist are ignored. Entities are inserted after all other commands
+   * have been applied, in recording order.
+   *
+   * @param entities The collection to change.
+   * @return The IDs of the inserted entities, in recording order.
+   */
+  [[maybe_unused]] std::vector<EntityID> Flush(EntityCollection& entities);
+
+ private:
+  /**
+   * @brief The kind of a recorded command that targets an existing entity.
+   */
+  enum class CommandType : std::uint8_t {
+    kErase,    ///< Erase the entity.
+    kEmplace,  ///< Add a component.
+    kRemove,   ///< Remove a component.
+  };
+
+  /**
+   * @brief A recorded command that targets an existing entity.
+   */
+  struct Command final {
+    EntityID entity_id;               ///< The target entity.
+    CommandType type;                 ///< The kind of change.
+    const ComponentInfo* info;        ///< Type of the added or removed component, nullptr for kErase.
+    std::shared_ptr<void> component;  ///< Value of the added component, only for kEmplace of data components.
+  };
+
+  /**
+   * @brief A recorded insertion of a new entity.
+   */
+  struct Insertion final {
+    ComponentCollection entity_data;  ///< Components of the new entity.
+    EntityID parent_id;               ///< Parent of the new entity.
+  };
+
+  /**
+   * @brief Applies the commands recorded for a single entity.
+   * @param entities The collection to change.
+   * @param commands The commands of the entity, in recording order.
+   */
+  static void ApplyEntityCommands(EntityCollection& entities, std::span<Command> commands);
+
+  std::vector<Command> commands_;      ///< Commands that target existing entities.
+  std::vector<Insertion> insertions_;  ///< Insertions of new entities.
+};
+
+/**
+ * @class CommandQueue
+ * @brief A set of command buffers, one per recording thread.
+ *
+ * Parallel systems record through Local(), which hands every thread its own buffer, so recording needs no
+ * synchronization beyond the first lookup of a job. Flush() applies the buffers one after another, in the order in
+ * which the threads first recorded. Commands recorded by different threads for the same entity should therefore not
+ * depend on each other.
+ */
+class CommandQueue final {
+ public:
+  /**
+   * @brief Constructs a queue without buffers.
+   */
+  CommandQueue() = default;
+
+  CommandQueue(const CommandQueue& other) = delete;
+  CommandQueue& operator=(const CommandQueue& other) = delete;
+
+  /**
+   * @brief Retrieves the buffer of the calling thread, creating it on first use.
+   *
+   * The lookup takes a lock, so jobs should fetch the buffer once and keep the reference.
+   *
+   * @return A reference to the buffer of the calling thread.
+   */
+  [[nodiscard]] CommandBuffer& Local();
+
+  /**
+   * @brief Applies and discards the commands of every buffer.
+   * @param entities The collection to change.
+   * @return The IDs of the inserted entities.
+   */
+  [[maybe_unused]] std::vector<EntityID> Flush(EntityCollection& entities);
+
+ private:
+  std::mutex mutex_;  ///< Protects the list of buffers.
+  /// Buffers of the recording threads, in the order of their first use.
+  std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>> buffers_;
+};
+
+template <is_component ComponentType, typename... Args>
+void CommandBuffer::Emplace(const EntityID& entity_id, Args&&... arguments) {
+  std::shared_ptr<void> component;
+  if constexpr (!is_tag_component<ComponentType>) {
+    component =
+        std::allocate_shared<ComponentType>(memory::PoolAllocator<ComponentType>{}, std::forward<Args>(arguments)...);
+  }
+  commands_.push_back({.entity_id = entity_id,
+                       .type = CommandType::kEmplace,
+                       .info = &ComponentInfo::Of<ComponentType>(),
+                       .component = std::move(component)});
+}
+
+template <is_component ComponentType>
+void CommandBuffer::Remove(const EntityID& entity_id) {
+  commands_.push_back({.entity_id = entity_id,
+                       .type = CommandType::kRemove,
+                       .info = &ComponentInfo::Of<ComponentType>(),
+                       .component = nullptr});
+}
+
+}  // namespace engine::ecs
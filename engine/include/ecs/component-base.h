@@ -5,10 +5,12 @@
 namespace engine::ecs {
 
 /**
- * @brief Base structure for components in a entity-component-system (ECS).
+ * @brief Optional base structure for components in a entity-component-system (ECS).
  *
- * This structure provides a base structure for all components. It includes
- * default constructors, destructors, and assignment operators.
+ * This structure provides a polymorphic base for components that need one. It includes
+ * default constructors, destructors, and assignment operators. Components do not have to
+ * derive from it: plain structs avoid the vtable pointer and, when trivially copyable, are
+ * copied and relocated with memcpy.
  */
 struct ComponentBase {
  public:
@@ -50,15 +52,18 @@ struct ComponentBase {
  * @brief Concept to check if a type is a valid component.
  *
  * This concept checks whether a type `T` satisfies the following conditions:
- * - It must be derived from `ComponentBase`.
+ * - It must be a class type without cv-qualifiers.
  * - It must be default constructible.
  * - It must be copy constructible.
  * - It must be copy assignable.
  *
+ * Components are handled through their ComponentInfo, so they do not need to derive from `ComponentBase`.
+ *
  * @tparam T The type to be checked against the concept requirements.
  */
 template <typename T>
-concept is_component = std::derived_from<T, ComponentBase> && std::is_default_constructible_v<T> &&
-                       std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>;
+concept is_component = std::is_class_v<T> && std::same_as<T, std::remove_cv_t<T>> &&
+                       std::is_default_constructible_v<T> && std::is_copy_constructible_v<T> &&
+                       std::is_copy_assignable_v<T>;
 
 }  // namespace engine::ecs
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
-#include <typeindex>
 #include <unordered_map>
 #include <utility>
 
 #include "component-base.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/tag-component.h"
+#include "memory/pool-allocator.h"
 
 namespace engine::ecs {
 
@@ -25,7 +29,10 @@ namespace engine::ecs {
  *
  * This class handles components in a type-safe way, allowing for adding, removing,
  * and querying components at runtime. Components are stored using a type-based key
- * (std::type_index) and shared ownership is ensured through std::shared_ptr.
+ * (ComponentTypeID) and shared ownership is ensured through std::shared_ptr. Every component is copied through the
+ * ComponentInfo of its type, so copies never slice and components need no common base. The collection also keeps the
+ * ComponentSignature of its component types, so queries never touch the map. Tag components carry no data and are
+ * recorded only in the signature, so adding or removing a tag never allocates.
  */
 class ComponentCollection final {
  public:
@@ -59,6 +66,25 @@ class ComponentCollection final {
    * @return A reference to the current instance.
    */
   ComponentCollection& operator=(const ComponentCollection& other);
+
+  /**
+   * @brief Move constructor.
+   *
+   * Takes over the components of the specified collection, leaving it empty.
+   *
+   * @param other The collection to move from.
+   */
+  ComponentCollection(ComponentCollection&& other) noexcept;
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Replaces the components of the current collection with those of the specified collection, leaving it empty.
+   *
+   * @param other The collection to move from.
+   * @return A reference to the current instance.
+   */
+  ComponentCollection& operator=(ComponentCollection&& other) noexcept;
   /** @} */  // end of Constructors
 
   /**
@@ -120,25 +146,59 @@ class ComponentCollection final {
   /**
    * @brief Extract and remove a component of the specified type.
    *
-   * Removes the component from the collection and returns it as a shared pointer.
+   * Removes the component from the collection and returns it as a typed shared pointer. Tag components have no
+   * instance to extract; use Erase() for them.
    *
    * @tparam ComponentType The type of the component to extract.
    * @return A shared pointer to the extracted component, or nullptr if it does not exist.
    */
   template <is_component ComponentType>
-  [[nodiscard]] std::shared_ptr<ComponentBase> Extract();
+    requires(!is_tag_component<ComponentType>)
+  [[nodiscard]] std::shared_ptr<ComponentType> Extract();
 
   /**
    * @brief Get a weak reference to a component of the specified type.
    *
-   * Returns a weak pointer to the component if it exists in the collection.
+   * Returns a weak pointer to the component if it exists in the collection. Tag components have no instance; use
+   * HasAll() for them.
    *
    * @tparam ComponentType The type of the component to get.
    * @return A weak pointer to the requested component, or an expired weak pointer if the component is not found.
    */
   template <is_component ComponentType>
+    requires(!is_tag_component<ComponentType>)
   [[nodiscard]] std::weak_ptr<ComponentType> Get() const noexcept;
 
+  /**
+   * @brief Emplace a copy of a component known only through its descriptor.
+   *
+   * Copies the component located at `source` into the collection. If a component of this type already exists, it is
+   * not replaced.
+   *
+   * @param info The descriptor of the component type.
+   * @param source A pointer to the component to copy, ignored for tag components.
+   * @return true if the component was successfully emplaced, false if it already exists.
+   */
+  [[maybe_unused]] bool EmplaceCopy(const ComponentInfo& info, const void* source);
+
+  /**
+   * @brief Visit every component in the collection. Tag components are not visited.
+   *
+   * @tparam Visitor A callable invoked as `visitor(const ComponentInfo&, const void*)` for every component.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const;
+
+  /**
+   * @brief Visit every component in the collection with mutable access. Tag components are not visited.
+   *
+   * @tparam Visitor A callable invoked as `visitor(const ComponentInfo&, void*)` for every component.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor);
+
   /** @} */  // end of Component Manipulation Methods
 
   /**
@@ -179,57 +239,111 @@ class ComponentCollection final {
   template <is_component... ComponentTypes>
   [[nodiscard]] bool HasNoneOf() const noexcept;
 
+  /**
+   * @brief Get the signature of the component types present in the collection.
+   *
+   * @return The signature of the collection.
+   */
+  [[nodiscard]] const ComponentSignature& GetSignature() const noexcept;
+
   /** @} */  // end of Component Query Methods
 
  private:
+  /**
+   * @brief A stored component together with the descriptor used to copy and relocate it.
+   */
+  struct StoredComponent final {
+    const ComponentInfo* info{nullptr};  ///< Descriptor of the component type.
+    std::shared_ptr<void> instance;      ///< The component itself.
+  };
+
   // Internal storage for components.
-  std::unordered_map<std::type_index, std::shared_ptr<ComponentBase>> inner_components_;
+  std::unordered_map<ComponentTypeID, StoredComponent, std::hash<ComponentTypeID>, std::equal_to<ComponentTypeID>,
+                     memory::PoolAllocator<std::pair<const ComponentTypeID, StoredComponent>>>
+      inner_components_;
+  // Component types present in the collection.
+  ComponentSignature signature_;
 };
 
 template <is_component ComponentType, typename... Args>
 bool ComponentCollection::Emplace(Args&&... arguments) {
-  auto new_component = std::make_shared<ComponentType>(std::forward<Args>(arguments)...);
-  return inner_components_.try_emplace(typeid(ComponentType), std::move(new_component)).second;
+  const ComponentInfo& info = ComponentInfo::Of<ComponentType>();
+  if (signature_.Test(info.id)) {
+    return false;
+  }
+  if constexpr (!is_tag_component<ComponentType>) {
+    auto new_component =
+        std::allocate_shared<ComponentType>(memory::PoolAllocator<ComponentType>{}, std::forward<Args>(arguments)...);
+    inner_components_.try_emplace(info.id, StoredComponent{&info, std::move(new_component)});
+  }
+  signature_.Set(info.id);
+  return true;
 }
 
 template <is_component ComponentType>
 bool ComponentCollection::Erase() {
-  return inner_components_.erase(typeid(ComponentType)) > 0;
+  ComponentTypeID type_id = ComponentTypeIDOf<ComponentType>();
+  if (!signature_.Test(type_id)) {
+    return false;
+  }
+  signature_.Reset(type_id);
+  if constexpr (!is_tag_component<ComponentType>) {
+    inner_components_.erase(type_id);
+  }
+  return true;
 }
 
 template <is_component ComponentType>
-std::shared_ptr<ComponentBase> ComponentCollection::Extract() {
-  std::shared_ptr<ComponentBase> extracted_component{nullptr};
-  if (inner_components_.contains(typeid(ComponentType))) {
-    auto node = inner_components_.extract(typeid(ComponentType));
-    extracted_component = std::move(node.mapped());
+  requires(!is_tag_component<ComponentType>)
+std::shared_ptr<ComponentType> ComponentCollection::Extract() {
+  std::shared_ptr<ComponentType> extracted_component{nullptr};
+  ComponentTypeID type_id = ComponentTypeIDOf<ComponentType>();
+  if (signature_.Test(type_id)) {
+    signature_.Reset(type_id);
+    auto node = inner_components_.extract(type_id);
+    extracted_component = std::static_pointer_cast<ComponentType>(std::move(node.mapped().instance));
   }
   return extracted_component;
 }
 
 template <is_component ComponentType>
+  requires(!is_tag_component<ComponentType>)
 std::weak_ptr<ComponentType> ComponentCollection::Get() const noexcept {
   std::shared_ptr<ComponentType> found_component{nullptr};
-  auto iter = inner_components_.find(typeid(ComponentType));
+  auto iter = inner_components_.find(ComponentTypeIDOf<ComponentType>());
   if (iter != inner_components_.end()) {
-    found_component = std::dynamic_pointer_cast<ComponentType>(iter->second);
+    found_component = std::static_pointer_cast<ComponentType>(iter->second.instance);
   }
   return found_component;
 }
 
+template <typename Visitor>
+void ComponentCollection::ForEach(Visitor&& visitor) const {
+  for (const auto& [key, stored] : inner_components_) {
+    visitor(*stored.info, static_cast<const void*>(stored.instance.get()));
+  }
+}
+
+template <typename Visitor>
+void ComponentCollection::ForEach(Visitor&& visitor) {
+  for (auto& [key, stored] : inner_components_) {
+    visitor(*stored.info, static_cast<void*>(stored.instance.get()));
+  }
+}
+
 template <is_component... ComponentTypes>
 bool ComponentCollection::HasAll() const noexcept {
-  return (inner_components_.contains(typeid(ComponentTypes)) && ...);
+  return signature_.ContainsAll(ComponentSignatureOf<ComponentTypes...>());
 }
 
 template <is_component... ComponentTypes>
 bool ComponentCollection::HasAny() const noexcept {
-  return (inner_components_.contains(typeid(ComponentTypes)) || ...);
+  return signature_.ContainsAny(ComponentSignatureOf<ComponentTypes...>());
 }
 
 template <is_component... ComponentTypes>
 bool ComponentCollection::HasNoneOf() const noexcept {
-  return !HasAll<ComponentTypes...>();
+  return !signature_.ContainsAny(ComponentSignatureOf<ComponentTypes...>());
 }
 
 }  // namespace engine::ecs
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "ecs/change-tick.h"
+#include "ecs/component-base.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query-cache.h"
+#include "ecs/query.h"
+namespace engine::ecs {
+
+/**
+ * @class ComponentIndexSync
+ * @brief The bookkeeping shared by the indexes that mirror one component type of an EntityCollection, such as the
+ * SpatialIndex and the ValueIndex.
+ *
+ * The sync keeps one slot per entity ID index, which records the ID of the indexed entity and where the index stored
+ * it, and brings an index up to date incrementally through the change ticks of the collection:
+ * - components removed since the previous update are found in the removal log of the collection;
+ * - components added or written since the previous update are visited with a Changed query, and an entity whose
+ *   slot still holds an erased entity with the same index first has that entity removed;
+ * - erased entities, and entities that lost the component without a removal record, such as after a rollback, are
+ *   found by checking the number of indexed entities against the number of live components, at the cost of a scan
+ *   of the slots on updates that follow them.
+ *
+ * The index itself only supplies how an entity is placed in, and detached from, its own storage.
+ *
+ * @tparam ComponentType The indexed component type.
+ * @tparam Location Where the index stored an entity, such as a bucket and a position in it.
+ */
+template <is_component ComponentType, typename Location>
+class ComponentIndexSync final {
+ public:
+  /**
+   * @brief Constructs a sync with no indexed entity.
+   */
+  ComponentIndexSync() = default;
+
+  /**
+   * @brief Brings an index up to date with the components of a collection.
+   *
+   * Advances the change tick of the collection, so that every later write of the component is seen by the next
+   * update. Updating with another collection than the previous one rebuilds the index.
+   *
+   * @tparam Clear A callable invoked as `clear()`, which empties the storage of the index.
+   * @tparam Place A callable invoked as `place(const EntityID&, const ComponentType&, Location&, bool is_indexed)`
+   * for every added or written component. If the entity is already indexed, the location holds where it is stored;
+   * the callable stores the entity, or updates it, and writes its new location.
+   * @tparam Detach A callable invoked as `detach(Location&)`, which removes an indexed entity from the storage.
+   * @param entities The collection to index.
+   * @param clear The callable that empties the storage.
+   * @param place The callable that stores an entity.
+   * @param detach The callable that removes an entity from the storage.
+   */
+  template <typename Clear, typename Place, typename Detach>
+  void Update(EntityCollection& entities, Clear&& clear, Place&& place, Detach&& detach);
+
+  /**
+   * @brief Retrieves the number of indexed entities.
+   * @return The number of indexed entities.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+  /**
+   * @brief Retrieves where an indexed entity is stored, for an index that moves entities within its storage.
+   * @param entity_id The ID of an indexed entity.
+   * @return The location of the entity.
+   */
+  [[nodiscard]] Location& LocationOf(const EntityID& entity_id) noexcept {
+    return slots_[entity_id.GetIndex()].location;
+  }
+
+ private:
+  /**
+   * @brief An indexed entity, indexed by the index of its ID.
+   */
+  struct Slot final {
+    EntityID entity_id;   ///< ID of the entity, the root ID if the slot is unused.
+    Location location{};  ///< Where the index stored the entity.
+  };
+
+  std::vector<Slot> slots_;                    ///< Every indexed entity, by index of the ID.
+  std::size_t size_{0};                        ///< Number of indexed entities.
+  const EntityCollection* entities_{nullptr};  ///< Indexed collection.
+  Tick synced_tick_{0};                        ///< Change tick of the collection at the previous update.
+  QueryCache changed_cache_;                   ///< Tables scanned for changed components.
+  QueryCache count_cache_;                     ///< Tables whose components are counted.
+};
+
+template <is_component ComponentType, typename Location>
+template <typename Clear, typename Place, typename Detach>
+void ComponentIndexSync<ComponentType, Location>::Update(EntityCollection& entities, Clear&& clear, Place&& place,
+                                                         Detach&& detach) {
+  if (entities_ != &entities) {
+    clear();
+    slots_.clear();
+    size_ = 0;
+    entities_ = &entities;
+    synced_tick_ = 0;
+  }
+  auto forget = [this, &detach](Slot& slot) {
+    detach(slot.location);
+    slot.entity_id = EntityID::GetRootID();
+    --size_;
+  };
+
+  // Removals come first, so that a component removed and added again since the last update is indexed again.
+  Query<With<>, Without<>, Removed<ComponentType>>(entities, synced_tick_)
+      .Each([this, &forget](const EntityID& entity_id) {
+        std::size_t index = entity_id.GetIndex();
+        if (index < slots_.size() && slots_[index].entity_id == entity_id) {
+          forget(slots_[index]);
+        }
+      });
+  Query<With<const ComponentType>, Without<>, Changed<ComponentType>>(entities, changed_cache_, synced_tick_)
+      .Each([this, &forget, &place](const EntityID& entity_id, const ComponentType& component) {
+        std::size_t index = entity_id.GetIndex();
+        if (index >= slots_.size()) {
+          slots_.resize(index + 1);
+        }
+        Slot& slot = slots_[index];
+        if (slot.entity_id != EntityID::GetRootID() && slot.entity_id != entity_id) {
+          // The index of an erased entity was reused.
+          forget(slot);
+        }
+        bool is_indexed = slot.entity_id == entity_id;
+        place(entity_id, component, slot.location, is_indexed);
+        if (!is_indexed) {
+          slot.entity_id = entity_id;
+          ++size_;
+        }
+      });
+
+  // Every live component is indexed now, so any surplus belongs to erased entities, or to entities whose component
+  // was dropped without a removal record, as when the collection is restored from a snapshot.
+  if (size_ > View<const ComponentType>(entities, count_cache_).Count()) {
+    auto has_component = [&entities](const EntityID& entity_id) {
+      return entities.Contains(entity_id) && std::as_const(entities).At(entity_id).template HasAll<ComponentType>();
+    };
+    for (Slot& slot : slots_) {
+      if (slot.entity_id != EntityID::GetRootID() && !has_component(slot.entity_id)) {
+        forget(slot);
+      }
+    }
+  }
+
+  synced_tick_ = entities.GetChangeTick();
+  entities.AdvanceChangeTick();
+}
+
+}  // namespace engine::ecs
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+
+#include "ecs/component-base.h"
+#include "ecs/component-signature.h"
+#include "ecs/tag-component.h"
+#include "memory/pool-allocator.h"
+namespace engine::ecs {
+
+/**
+ * @brief Type-erased description of a component type.
+ *
+ * A ComponentInfo stores the size, the alignment and the lifetime operations of a single component type. Containers
+ * that keep components of many types in raw memory (such as archetype tables) use it to construct, relocate and
+ * destroy components without knowing their static type. Trivially copyable components are copied and relocated with
+ * memcpy instead of the lifetime operations, and need no destruction.
+ *
+ * Tag components carry no data: they are recorded only in signatures, and containers never allocate storage for them.
+ *
+ * Exactly one descriptor exists per component type; it is obtained through ComponentInfo::Of(). The first call
+ * registers the type and assigns it a dense ComponentTypeID, which is then used for signatures and column lookups.
+ */
+struct ComponentInfo final {
+  ComponentTypeID id;     ///< Dense identifier of the component type.
+  std::type_index type;   ///< Runtime identity of the component type.
+  std::size_t size;       ///< Size of a single component in bytes.
+  std::size_t alignment;  ///< Required alignment of a single component in bytes.
+  bool is_tag;            ///< Whether the type is a tag component, stored only as a signature bit.
+  bool is_trivial;        ///< Whether the type is trivially copyable, so memcpy may copy and relocate it.
+
+  void (*default_construct)(void* destination);                   ///< Default-constructs a component in place.
+  void (*copy_construct)(void* destination, const void* source);  ///< Copy-constructs a component in place.
+  void (*move_construct)(void* destination, void* source);        ///< Move-constructs a component in place.
+  void (*destroy)(void* target) noexcept;                         ///< Destroys a component in place.
+  std::shared_ptr<void> (*make_shared_copy)(const void* source);  ///< Copies a component into the pools.
+
+  /**
+   * @brief Retrieves the descriptor of the specified component type.
+   *
+   * @tparam ComponentType The component type to describe.
+   * @return A reference to the unique descriptor of the component type.
+   */
+  template <is_component ComponentType>
+  [[nodiscard]] static const ComponentInfo& Of() noexcept;
+
+  /**
+   * @brief Retrieves the descriptor of a registered component type by its ID.
+   *
+   * @param type_id The ID of the component type.
+   * @return A pointer to the descriptor, or nullptr if no type is registered under this ID.
+   */
+  [[nodiscard]] static const ComponentInfo* Find(ComponentTypeID type_id) noexcept;
+
+  /**
+   * @brief Reserves the next free component type ID.
+   *
+   * Registering more than kMaxComponentTypes types terminates the program.
+   *
+   * @return The reserved ID.
+   */
+  [[nodiscard]] static ComponentTypeID ReserveID() noexcept;
+
+  /**
+   * @brief Makes a descriptor discoverable through Find().
+   *
+   * @param info The descriptor to register, whose ID was obtained from ReserveID().
+   * @return Always true.
+   */
+  [[maybe_unused]] static bool Register(const ComponentInfo& info) noexcept;
+};
+
+/**
+ * @brief Retrieves the dense ID of the specified component type.
+ *
+ * @tparam ComponentType The component type.
+ * @return The ID of the component type.
+ */
+template <is_component ComponentType>
+[[nodiscard]] ComponentTypeID ComponentTypeIDOf() noexcept {
+  return ComponentInfo::Of<ComponentType>().id;
+}
+
+/**
+ * @brief Retrieves the signature made of the specified component types.
+ *
+ * The signature is built once per list of types and cached, so testing it against another signature costs a few
+ * word-wide operations.
+ *
+ * @tparam ComponentTypes The component types of the signature.
+ * @return A reference to the cached signature.
+ */
+template <is_component... ComponentTypes>
+[[nodiscard]] const ComponentSignature& ComponentSignatureOf() noexcept {
+  static const ComponentSignature kSignature = [] {
+    ComponentSignature signature;
+    (signature.Set(ComponentTypeIDOf<ComponentTypes>()), ...);
+    return signature;
+  }();
+  return kSignature;
+}
+
+template <is_component ComponentType>
+const ComponentInfo& ComponentInfo::Of() noexcept {
+  static const ComponentInfo kInfo{
+      .id = ReserveID(),
+      .type = typeid(ComponentType),
+      .size = sizeof(ComponentType),
+      .alignment = alignof(ComponentType),
+      .is_tag = is_tag_component<ComponentType>,
+      .is_trivial = std::is_trivially_copyable_v<ComponentType>,
+      .default_construct = [](void* destination) { ::new (destination) ComponentType(); },
+      .copy_construct =
+          [](void* destination, const void* source) {
+            ::new (destination) ComponentType(*static_cast<const ComponentType*>(source));
+          },
+      .move_construct =
+          [](void* destination, void* source) {
+            ::new (destination) ComponentType(std::move(*static_cast<ComponentType*>(source)));
+          },
+      .destroy = [](void* target) noexcept { static_cast<ComponentType*>(target)->~ComponentType(); },
+      .make_shared_copy = [](const void* source) -> std::shared_ptr<void> {
+        return std::allocate_shared<ComponentType>(memory::PoolAllocator<ComponentType>{},
+                                                   *static_cast<const ComponentType*>(source));
+      },
+  };
+  [[maybe_unused]] static const bool kIsRegistered = Register(kInfo);
+  return kInfo;
+}
+
+}  // namespace engine::ecs
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+namespace engine::ecs {
+
+/**
+ * @brief Maximum number of distinct component types in a program.
+ */
+inline constexpr std::size_t kMaxComponentTypes = 256;
+
+/**
+ * @typedef ComponentTypeID
+ * @brief Dense identifier of a component type, less than kMaxComponentTypes.
+ */
+using ComponentTypeID = std::uint32_t;
+
+/**
+ * @class ComponentSignature
+ * @brief A fixed-width set of component types, stored as one bit per ComponentTypeID.
+ *
+ * Signatures describe which component types an entity or an archetype table has. Testing a signature against
+ * another one is a handful of word-wide AND operations, independent of the number of types involved.
+ */
+class ComponentSignature final {
+ public:
+  /**
+   * @brief Constructs an empty signature.
+   */
+  constexpr ComponentSignature() noexcept = default;
+
+  /**
+   * @brief Adds a component type to the signature.
+   * @param type_id The ID of the component type.
+   */
+  constexpr void Set(ComponentTypeID type_id) noexcept { words_[type_id / kWordBits] |= Bit(type_id); }
+
+  /**
+   * @brief Removes a component type from the signature.
+   * @param type_id The ID of the component type.
+   */
+  constexpr void Reset(ComponentTypeID type_id) noexcept { words_[type_id / kWordBits] &= ~Bit(type_id); }
+
+  /**
+   * @brief Checks if a component type is in the signature.
+   * @param type_id The ID of the component type.
+   * @return True if the type is in the signature, otherwise false.
+   */
+  [[nodiscard]] constexpr bool Test(ComponentTypeID type_id) const noexcept {
+    return (words_[type_id / kWordBits] & Bit(type_id)) != 0;
+  }
+
+  /**
+   * @brief Checks if every component type of the mask is in the signature.
+   * @param mask The component types to look for.
+   * @return True if the signature is a superset of the mask, otherwise false.
+   */
+  [[nodiscard]] constexpr bool ContainsAll(const ComponentSignature& mask) const noexcept {
+    std::uint64_t missing = 0;
+    for (std::size_t word = 0; word < kWordCount; ++word) {
+      missing |= mask.words_[word] & ~words_[word];
+    }
+    return missing == 0;
+  }
+
+  /**
+   * @brief Checks if at least one component type of the mask is in the signature.
+   * @param mask The component types to look for.
+   * @return True if the signature and the mask intersect, otherwise false.
+   */
+  [[nodiscard]] constexpr bool ContainsAny(const ComponentSignature& mask) const noexcept {
+    std::uint64_t common = 0;
+    for (std::size_t word = 0; word < kWordCount; ++word) {
+      common |= mask.words_[word] & words_[word];
+    }
+    return common != 0;
+  }
+
+  /**
+   * @brief Retrieves the number of component types in the signature.
+   * @return The number of set bits.
+   */
+  [[nodiscard]] constexpr std::size_t Count() const noexcept {
+    std::size_t count = 0;
+    for (std::uint64_t word : words_) {
+      count += static_cast<std::size_t>(std::popcount(word));
+    }
+    return count;
+  }
+
+  /**
+   * @brief Checks if the signature has no component types.
+   * @return True if the signature is empty, otherwise false.
+   */
+  [[nodiscard]] constexpr bool Empty() const noexcept { return Count() == 0; }
+
+  /**
+   * @brief Calls a function for every component type in the signature, in ascending order of IDs.
+   * @tparam Visitor A callable invoked as `visitor(ComponentTypeID)`.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  constexpr void ForEach(Visitor&& visitor) const {
+    for (std::size_t word = 0; word < kWordCount; ++word) {
+      for (std::uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+        visitor(static_cast<ComponentTypeID>(word * kWordBits + std::countr_zero(bits)));
+      }
+    }
+  }
+
+  /**
+   * @brief Computes the union of two signatures.
+   * @param other The other signature.
+   * @return A signature with the component types of both signatures.
+   */
+  [[nodiscard]] constexpr ComponentSignature operator|(const ComponentSignature& other) const noexcept {
+    ComponentSignature result;
+    for (std::size_t word = 0; word < kWordCount; ++word) {
+      result.words_[word] = words_[word] | other.words_[word];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Computes the component types of this signature that are missing in another one.
+   * @param other The other signature.
+   * @return A signature with the component types of this signature that are not in `other`.
+   */
+  [[nodiscard]] constexpr ComponentSignature operator-(const ComponentSignature& other) const noexcept {
+    ComponentSignature result;
+    for (std::size_t word = 0; word < kWordCount; ++word) {
+      result.words_[word] = words_[word] & ~other.words_[word];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Checks if two signatures have the same component types.
+   * @param other The other signature.
+   * @return True if the signatures are equal, otherwise false.
+   */
+  [[nodiscard]] constexpr bool operator==(const ComponentSignature& other) const noexcept = default;
+
+  /**
+   * @brief A class to compute the hash value of a signature.
+   */
+  struct Hash final {
+   public:
+    /**
+     * @brief Computes the hash value of the given signature.
+     * @param[in] signature The signature to hash.
+     * @return The computed hash value.
+     */
+    [[nodiscard]] std::size_t operator()(const ComponentSignature& signature) const noexcept {
+      std::uint64_t value = 0;
+      for (std::uint64_t word : signature.words_) {
+        value = (value ^ word) * 0x100000001b3ULL;
+        value ^= value >> 29U;
+      }
+      return static_cast<std::size_t>(value);
+    }
+  };
+
+ private:
+  static constexpr std::size_t kWordBits = 64;
+  static constexpr std::size_t kWordCount = kMaxComponentTypes / kWordBits;
+
+  [[nodiscard]] static constexpr std::uint64_t Bit(ComponentTypeID type_id) noexcept {
+    return std::uint64_t{1} << (type_id % kWordBits);
+  }
+
+  std::array<std::uint64_t, kWordCount> words_{};  ///< One bit per component type.
+};
+
+}  // namespace engine::ecs
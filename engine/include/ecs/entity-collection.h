@@ -1,20 +1,53 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <new>
+#include <span>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "ecs/archetype-table.h"
+#include "ecs/change-tick.h"
 #include "ecs/component-collection.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-hierarchy.h"
+#include "ecs/entity-id-allocator.h"
 #include "ecs/entity-id.h"
+#include "ecs/entity-ref.h"
 #include "ecs/entity.h"
+#include "ecs/memory-statistics.h"
+#include "ecs/tag-component.h"
+#include "jobs/job-system.h"
+#include "memory/arena.h"
+#include "profiling/profiler.h"
 namespace engine::ecs {
+
+class Snapshot;
+class SnapshotRing;
+
 /**
  * @typedef Predicate
- * @brief A function that takes in a constant ComponentCollection reference and returns a boolean value.
+ * @brief A function that takes in a read-only reference to an entity and returns a boolean value.
+ *
+ * Predicates are evaluated for every entity of the collection. Code that only needs entities with a given set of
+ * component types should prefer the typed Query and View from `ecs/query.h`, which skip non-matching tables.
  */
-using Predicate = std::function<bool(const ComponentCollection&)>;
+using Predicate = std::function<bool(const ConstEntityRef&)>;
+
+/**
+ * @brief A type-erased component value owned by the caller.
+ */
+struct ComponentValue final {
+  const ComponentInfo* info;  ///< Descriptor of the component type.
+  void* component;            ///< Pointer to the component.
+};
 
 /**
  * @class EntityCollection
@@ -22,6 +55,16 @@ using Predicate = std::function<bool(const ComponentCollection&)>;
  *
  * The EntityCollection class provides a way to manage collections of Entity objects,
  * allowing for insertion, extraction, and search operations.
+ *
+ * Components are not stored per entity: entities that have the same set of component types share one
+ * ArchetypeTable, where every component type is kept in contiguous, chunked arrays. Inserting an entity or changing
+ * its set of component types moves its components into the matching table.
+ *
+ * Components carry change ticks (see `ecs/change-tick.h`), and removals of components from live entities are
+ * recorded, which lets queries report only what was added, changed or removed since a given tick.
+ *
+ * Entities may be attached to a parent entity. The relations are kept in an EntityHierarchy, and erasing an entity
+ * erases its whole subtree.
  */
 class EntityCollection final {
  public:
@@ -44,13 +87,63 @@ class EntityCollection final {
 
   /**
    * @brief Clears the collection by removing all entities.
+   *
+   * Archetype tables and their chunks are kept, so refilling the collection with similar entities allocates nothing.
    */
   void Clear();
 
+  /**
+   * @brief Removes all entities and archetype tables, and rewinds the arena that holds the chunks in one step.
+   *
+   * Meant for unloading a level: the memory of the arena is kept for the next level, but the tables are rebuilt.
+   */
+  void Reset();
+
+  /**
+   * @brief Retrieves the arena that holds the chunks of the archetype tables.
+   * @return A reference to the arena.
+   */
+  [[nodiscard]] const memory::Arena& GetArena() const noexcept;
+
+  /**
+   * @brief Measures the memory held by the collection, broken down by component type, table and container.
+   *
+   * The cost grows with the number of tables and of their columns, not with the number of entities, so the
+   * statistics may be sampled every frame.
+   *
+   * @return The statistics of the collection.
+   */
+  [[nodiscard]] MemoryStatistics GetMemoryStatistics() const;
+
+  /**
+   * @brief Retrieves the current change tick, which new stamps of components are made with.
+   * @return The current change tick.
+   */
+  [[nodiscard]] Tick GetChangeTick() const noexcept;
+
+  /**
+   * @brief Advances the change tick. Safe to call concurrently with readers of the tick.
+   * @return The new change tick.
+   */
+  [[maybe_unused]] Tick AdvanceChangeTick() noexcept;
+
+  /**
+   * @brief Retrieves the records of components removed from live entities, oldest first.
+   * @return The records that have not been cleared yet.
+   */
+  [[nodiscard]] const std::vector<RemovedComponent>& GetRemovedComponents() const noexcept;
+
+  /**
+   * @brief Forgets the records of removals that no reader needs anymore.
+   * @param tick The greatest tick that no reader looks past; records with a tick not greater than it are cleared.
+   */
+  void ClearRemovedComponents(Tick tick);
+
   /**
    * @brief Inserts a new entity into the collection.
    * @param entity_data The data associated with the new entity.
-   * @param parent_id The ID of the parent entity to associate the new entity with.
+   * @param parent_id The ID of the parent entity to attach the new entity to. The new entity becomes a root if the
+   * ID is the root ID or is not alive.
    * @return An ID-value pair indicating whether the insertion was successful and the ID of the new entity.
    */
   [[nodiscard]] std::pair<EntityID, bool> Insert(const ComponentCollection& entity_data,
@@ -59,21 +152,73 @@ class EntityCollection final {
   /**
    * @brief Inserts a new entity into the collection, using move semantics.
    * @param entity_data The data associated with the new entity, moved.
-   * @param parent_id The ID of the parent entity to associate the new entity with.
+   * @param parent_id The ID of the parent entity to attach the new entity to. The new entity becomes a root if the
+   * ID is the root ID or is not alive.
    * @return An ID-value pair indicating whether the insertion was successful and the ID of the new entity.
    */
   [[nodiscard]] std::pair<EntityID, bool> Insert(ComponentCollection&& entity_data,
                                                  const EntityID& parent_id = EntityID::GetRootID());
 
+  /**
+   * @brief Inserts a new entity whose components are default-constructed.
+   * @param signature The component types of the new entity.
+   * @param parent_id The ID of the parent entity to attach the new entity to. The new entity becomes a root if the
+   * ID is the root ID or is not alive.
+   * @return An ID-value pair indicating whether the insertion was successful and the ID of the new entity.
+   */
+  [[nodiscard]] std::pair<EntityID, bool> InsertDefault(const ComponentSignature& signature,
+                                                        const EntityID& parent_id = EntityID::GetRootID());
+
+  /**
+   * @brief Inserts many entities with default-constructed components at once.
+   *
+   * The entities are appended to a single archetype table whose chunks are allocated up front, and every column is
+   * constructed range by range.
+   *
+   * @param count The number of entities to insert.
+   * @param signature The component types of the new entities.
+   * @param parent_id The ID of the parent entity to attach the new entities to. The new entities become roots if
+   * the ID is the root ID or is not alive.
+   * @return The IDs of the new entities. The span points into the table and stays valid until the next structural
+   * change of the collection.
+   */
+  [[nodiscard]] std::span<const EntityID> InsertBatch(std::size_t count, const ComponentSignature& signature,
+                                                      const EntityID& parent_id = EntityID::GetRootID());
+
+  /**
+   * @brief Inserts many entities whose components are copies of a prototype.
+   * @param count The number of entities to insert.
+   * @param prototype The components every new entity receives a copy of.
+   * @param parent_id The ID of the parent entity to attach the new entities to. The new entities become roots if
+   * the ID is the root ID or is not alive.
+   * @return The IDs of the new entities. The span points into the table and stays valid until the next structural
+   * change of the collection.
+   */
+  [[nodiscard]] std::span<const EntityID> InsertBatch(std::size_t count, const ComponentCollection& prototype,
+                                                      const EntityID& parent_id = EntityID::GetRootID());
+
   /**
    * @brief Extracts the ComponentCollection associated with the specified entity ID.
+   *
+   * The children of the extracted entity stay in the collection and become roots.
+   *
    * @param target_id The ID of the entity to extract.
    * @return An ID-value pair indicating whether the extraction was successful and the associated ComponentCollection.
    */
   [[nodiscard]] std::pair<ComponentCollection, bool> Extract(const EntityID& target_id);
 
   /**
-   * @brief Erases the entity associated with the specified entity ID.
+   * @brief Copies the components of the specified entity into a ComponentCollection.
+   * @param source_id The ID of the entity to copy.
+   * @return An ID-value pair indicating whether the entity exists and the copied ComponentCollection.
+   */
+  [[nodiscard]] std::pair<ComponentCollection, bool> Copy(const EntityID& source_id) const;
+
+  /**
+   * @brief Erases the entity associated with the specified entity ID, together with all of its descendants.
+   *
+   * The subtree is erased leaves first, without recursion.
+   *
    * @param entity_id The ID of the entity to erase.
    * @return True if the entity was successfully erased, otherwise false.
    */
@@ -87,18 +232,103 @@ class EntityCollection final {
   [[maybe_unused]] bool EraseIf(const Predicate& predicate);
 
   /**
-   * @brief Retrieves the ComponentCollection associated with the specified entity ID.
+   * @brief Erases many entities and their children at once.
+   *
+   * IDs that are stale, duplicated or not in the collection are skipped.
+   *
+   * @param entity_ids The IDs of the entities to erase.
+   * @return The number of erased entities, children included.
+   */
+  [[maybe_unused]] std::size_t EraseBatch(std::span<const EntityID> entity_ids);
+
+  /**
+   * @brief Retrieves the parent of an entity.
+   * @param entity_id The ID of the entity.
+   * @return The ID of the parent, or the root ID if the entity is a root or is not in the collection.
+   */
+  [[nodiscard]] EntityID GetParent(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Moves an entity, together with its subtree, under a new parent.
+   * @param entity_id The ID of the entity to move.
+   * @param parent_id The ID of the new parent, or the root ID to make the entity a root.
+   * @return True if the entity was moved, false if either entity is not in the collection or the new parent is a
+   * descendant of the entity.
+   */
+  [[maybe_unused]] bool SetParent(const EntityID& entity_id, const EntityID& parent_id);
+
+  /**
+   * @brief Retrieves the depth of an entity in the hierarchy.
+   * @param entity_id The ID of the entity.
+   * @return The number of ancestors of the entity, 0 for roots and for entities that are not in the collection.
+   */
+  [[nodiscard]] std::size_t GetDepth(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Retrieves the parent/child relations of the entities.
+   * @return A read-only reference to the hierarchy, which only holds alive entities.
+   */
+  [[nodiscard]] const EntityHierarchy& GetHierarchy() const noexcept;
+
+  /**
+   * @brief Emplaces a new component into an existing entity.
+   *
+   * The entity is moved into the archetype table that matches its new set of component types. Tag components are not
+   * constructed at all; only the signature of the entity changes.
+   *
+   * @tparam ComponentType The type of the component to be added.
+   * @tparam Args Types of the arguments to pass to the component's constructor.
+   * @param entity_id The ID of the entity.
+   * @param arguments The arguments forwarded to the constructor.
+   * @return True if the component was emplaced, false if the entity does not exist or already has such component.
+   */
+  template <is_component ComponentType, typename... Args>
+  [[maybe_unused]] bool Emplace(const EntityID& entity_id, Args&&... arguments);
+
+  /**
+   * @brief Removes a component from an existing entity.
+   *
+   * The entity is moved into the archetype table that matches its new set of component types, and the removal is
+   * recorded for change detection.
+   *
+   * @tparam ComponentType The type of the component to be removed.
+   * @param entity_id The ID of the entity.
+   * @return True if the component was removed, false if the entity does not exist or has no such component.
+   */
+  template <is_component ComponentType>
+  [[maybe_unused]] bool Remove(const EntityID& entity_id);
+
+  /**
+   * @brief Changes the component types of an existing entity with at most one move between archetype tables.
+   *
+   * Components whose types are kept retain their values, unless a new value is given in `components`. Values given
+   * for types that the entity did not have are move-constructed into the new table, and the remaining new types are
+   * default-constructed. Values given for types outside of `signature` are ignored. Kept components that receive a
+   * new value are stamped as changed, and dropped types are recorded as removed.
+   *
+   * @param entity_id The ID of the entity.
+   * @param signature The new component types of the entity.
+   * @param components The new component values, moved from.
+   * @return True if the entity was changed, false if it does not exist.
+   */
+  [[maybe_unused]] bool Reshape(const EntityID& entity_id, const ComponentSignature& signature,
+                                std::span<const ComponentValue> components = {});
+
+  /**
+   * @brief Retrieves the components of the entity with the specified entity ID.
    * @param entity_id The ID of the entity to retrieve.
-   * @return A mutable reference to the associated ComponentCollection.
+   * @return A reference granting mutable access to the components of the entity.
+   * @throw std::out_of_range If the entity is not in the collection or the ID is stale.
    */
-  [[nodiscard]] ComponentCollection& At(const EntityID& entity_id);
+  [[nodiscard]] EntityRef At(const EntityID& entity_id);
 
   /**
-   * @brief Retrieves the ComponentCollection associated with the specified entity ID.
+   * @brief Retrieves the components of the entity with the specified entity ID.
    * @param entity_id The ID of the entity to retrieve.
-   * @return A constant reference to the associated ComponentCollection.
+   * @return A reference granting read-only access to the components of the entity.
+   * @throw std::out_of_range If the entity is not in the collection or the ID is stale.
    */
-  [[nodiscard]] const ComponentCollection& At(const EntityID& entity_id) const;
+  [[nodiscard]] ConstEntityRef At(const EntityID& entity_id) const;
 
   /**
    * @brief Counts the number of entities that meet a certain predicate.
@@ -114,6 +344,25 @@ class EntityCollection final {
    */
   [[nodiscard]] std::vector<EntityID> Filter(const Predicate& predicate) const noexcept;
 
+  /**
+   * @brief Counts the number of entities that meet a certain predicate, evaluating it in parallel.
+   * @param predicate The predicate function, which must be safe to call concurrently.
+   * @param jobs The job system to run on.
+   * @return The number of entities that meet the predicate.
+   */
+  [[nodiscard]] std::size_t CountIf(const Predicate& predicate, jobs::JobSystem& jobs) const;
+
+  /**
+   * @brief Retrieves all entity IDs that meet a certain predicate, evaluating it in parallel.
+   *
+   * The IDs are returned in the same order as by the serial Filter(), independently of scheduling.
+   *
+   * @param predicate The predicate function, which must be safe to call concurrently.
+   * @param jobs The job system to run on.
+   * @return A vector containing all entity IDs that meet the predicate.
+   */
+  [[nodiscard]] std::vector<EntityID> Filter(const Predicate& predicate, jobs::JobSystem& jobs) const;
+
   /**
    * @brief Checks if the entity with the specified entity ID exists in the collection.
    * @param entity_id The ID of the entity to search for.
@@ -121,7 +370,222 @@ class EntityCollection final {
    */
   [[nodiscard]] bool Contains(const EntityID& entity_id) const noexcept;
 
+  /**
+   * @brief Retrieves the number of archetype tables created so far.
+   * @return The number of archetype tables.
+   */
+  [[nodiscard]] std::size_t TableCount() const noexcept;
+
+  /**
+   * @brief Retrieves the number of times the archetype tables were dropped by Reset().
+   *
+   * Tables are only ever appended between two resets, so a table index stays valid, and keeps designating the same
+   * set of component types, as long as the generation does not change.
+   *
+   * @return The generation of the tables.
+   */
+  [[nodiscard]] std::size_t GetTableGeneration() const noexcept;
+
+  /**
+   * @brief Retrieves an archetype table by its index.
+   * @param table_index The index of the table, less than TableCount().
+   * @return A reference to the table.
+   */
+  [[nodiscard]] ArchetypeTable& GetTable(std::size_t table_index) noexcept;
+
+  /**
+   * @copydoc GetTable(std::size_t)
+   */
+  [[nodiscard]] const ArchetypeTable& GetTable(std::size_t table_index) const noexcept;
+
  private:
-  std::unordered_map<EntityID, Entity, EntityID::Hash> inner_entities_;  ///< The map of entity IDs to entities.
+  friend class Snapshot;
+  friend class SnapshotRing;
+
+  /**
+   * @brief Finds the record of an alive entity.
+   * @param entity_id The ID of the entity.
+   * @return A pointer to the record, or nullptr if the ID is not alive.
+   */
+  [[nodiscard]] Entity* FindEntity(const EntityID& entity_id) noexcept;
+
+  /**
+   * @copydoc FindEntity(const EntityID&)
+   */
+  [[nodiscard]] const Entity* FindEntity(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Finds the table for the specified component types, creating it if it does not exist yet.
+   * @param signature The component types of the table.
+   * @return The index of the table.
+   */
+  [[nodiscard]] std::size_t FindOrCreateTable(const ComponentSignature& signature);
+
+  /**
+   * @brief The transitions of a table: the tables reached by adding or by removing a single component type.
+   */
+  struct TableEdges final {
+    std::array<std::uint32_t, kMaxComponentTypes> added;    ///< Table reached by adding every type, or kNoEdge.
+    std::array<std::uint32_t, kMaxComponentTypes> removed;  ///< Table reached by removing every type, or kNoEdge.
+  };
+
+  /**
+   * @brief Marks a transition that was not followed yet.
+   */
+  static constexpr std::uint32_t kNoEdge = ~std::uint32_t{0};
+
+  /**
+   * @brief Retrieves the transitions of a table, creating them on the first call.
+   * @param table_index The index of the table.
+   * @return The transitions of the table.
+   */
+  [[nodiscard]] TableEdges& GetTableEdges(std::size_t table_index);
+
+  /**
+   * @brief Finds the table reached by adding a component type to, or removing it from, the types of a table.
+   *
+   * The destination is looked up once and kept as an edge of the table, together with the reverse edge of the
+   * destination, so that repeated transitions cost a single array access.
+   *
+   * @param table_index The index of the table left.
+   * @param type_id The component type to add or remove. Must be absent from the table if added, present if removed.
+   * @param is_added Whether the type is added rather than removed.
+   * @return The index of the destination table.
+   */
+  [[nodiscard]] std::size_t FindOrCreateNeighbor(std::size_t table_index, ComponentTypeID type_id, bool is_added);
+
+  /**
+   * @brief Finds the table for the specified component types, starting from the table of an entity.
+   *
+   * Signatures one component type away are found through the edges of the table, others through the table index.
+   *
+   * @param table_index The index of the table left.
+   * @param signature The component types of the destination.
+   * @return The index of the destination table.
+   */
+  [[nodiscard]] std::size_t FindOrCreateDestination(std::size_t table_index, const ComponentSignature& signature);
+
+  /**
+   * @brief Appends a row for a new entity to the table that matches the specified component types.
+   *
+   * The components of the row are left uninitialized for the caller to construct.
+   *
+   * @param signature The component types of the new entity.
+   * @param parent_id The ID of the parent entity.
+   * @return The ID of the new entity.
+   */
+  [[nodiscard]] EntityID InsertRow(const ComponentSignature& signature, const EntityID& parent_id);
+
+  /**
+   * @brief Allocates IDs and uninitialized rows for many new entities in the table that matches a signature.
+   * @param count The number of entities.
+   * @param signature The component types of the new entities.
+   * @param parent_id The ID of the parent entity.
+   * @return The index of the table and the index of the first new row.
+   */
+  [[nodiscard]] EntityLocation InsertRows(std::size_t count, const ComponentSignature& signature,
+                                          const EntityID& parent_id);
+
+  /**
+   * @brief Moves an entity into another table, in a single step whatever the number of changed component types.
+   *
+   * Columns of the new table that are missing in the old one are left uninitialized for the caller to construct.
+   * Component types missing in the new table are recorded as removed.
+   *
+   * @param entity The record of the entity to move.
+   * @param table_index The index of the destination table.
+   * @return The new location of the entity.
+   */
+  [[nodiscard]] EntityLocation MoveEntity(Entity& entity, std::size_t table_index);
+
+  /**
+   * @brief Copies the components of a row, tags included, into a ComponentCollection.
+   * @param location The location of the row.
+   * @return The copied components.
+   */
+  [[nodiscard]] ComponentCollection CopyRow(const EntityLocation& location) const;
+
+  /**
+   * @brief Removes the row of an entity and updates the location of the entity moved into the freed row.
+   * @param location The location of the row to remove.
+   */
+  void RemoveRow(const EntityLocation& location);
+
+  /**
+   * @brief Updates the location of the entity currently stored in the specified row, if the row exists.
+   * @param location The location that may now hold a different entity.
+   */
+  void RefreshLocation(const EntityLocation& location);
+
+  /// Provides the chunks of the tables. Held by pointer so that tables keep a stable reference when the collection
+  /// is moved.
+  std::unique_ptr<memory::Arena> arena_{std::make_unique<memory::Arena>()};
+  /// Current change tick, held by pointer for the same reason as the arena.
+  std::unique_ptr<std::atomic<Tick>> change_tick_{std::make_unique<std::atomic<Tick>>(1)};
+  /// Memory outside of the arena whose chunks were adopted by the tables, such as mapped snapshot files. Declared
+  /// before the tables so that it is released after them.
+  std::vector<std::shared_ptr<void>> adopted_storage_;
+  EntityIDAllocator ids_;                                 ///< Issues and recycles entity IDs.
+  std::vector<Entity> inner_entities_;                    ///< Entity records, indexed by the slot of their ID.
+  EntityHierarchy hierarchy_;                             ///< Parent/child relations of the entities.
+  std::vector<std::unique_ptr<ArchetypeTable>> tables_;   ///< Archetype tables, only removed by Reset().
+  std::size_t table_generation_{0};                       ///< Number of times the tables were removed.
+  std::vector<std::unique_ptr<TableEdges>> table_edges_;  ///< Transitions of every table, created on first use.
+  /// Index of the table of every set of component types.
+  std::unordered_map<ComponentSignature, std::size_t, ComponentSignature::Hash> table_indices_;
+  std::vector<RemovedComponent> removed_components_;  ///< Components removed from live entities, oldest first.
+  /// Tick of the last change of the IDs, the rows or the relations of the entities.
+  Tick structure_tick_{0};
+  /// Scratch buffers of the batch operations, kept between calls so that steady-state frames do not allocate.
+  std::vector<EntityID> inserted_ids_;
+  std::vector<EntityID> pending_erasures_;
+  std::vector<EntityLocation> erased_locations_;
 };
-}  // namespace engine::ecs
\ No newline at end of file
+
+template <is_component ComponentType, typename... Args>
+bool EntityCollection::Emplace(const EntityID& entity_id, Args&&... arguments) {
+  ENGINE_PROFILE_ZONE("EntityCollection::Emplace");
+  Entity* entity = FindEntity(entity_id);
+  if (entity == nullptr) {
+    return false;
+  }
+  const ArchetypeTable& old_table = *tables_[entity->GetLocation().table];
+  ComponentTypeID type_id = ComponentTypeIDOf<ComponentType>();
+  if (old_table.Signature().Test(type_id)) {
+    return false;
+  }
+
+  std::size_t table_index = FindOrCreateNeighbor(entity->GetLocation().table, type_id, true);
+  if constexpr (is_tag_component<ComponentType>) {
+    // Tags carry no data, so adding one only moves the entity into the table of the new signature.
+    static_cast<void>(MoveEntity(*entity, table_index));
+  } else {
+    // Construct the component first, so a throwing constructor leaves the entity untouched.
+    ComponentType new_component(std::forward<Args>(arguments)...);
+    EntityLocation location = MoveEntity(*entity, table_index);
+
+    ArchetypeTable& new_table = *tables_[location.table];
+    void* destination = new_table.At(new_table.FindColumn(type_id), location.row);
+    ::new (destination) ComponentType(std::move(new_component));
+  }
+  return true;
+}
+
+template <is_component ComponentType>
+bool EntityCollection::Remove(const EntityID& entity_id) {
+  ENGINE_PROFILE_ZONE("EntityCollection::Remove");
+  Entity* entity = FindEntity(entity_id);
+  if (entity == nullptr) {
+    return false;
+  }
+  const ArchetypeTable& old_table = *tables_[entity->GetLocation().table];
+  ComponentTypeID type_id = ComponentTypeIDOf<ComponentType>();
+  if (!old_table.Signature().Test(type_id)) {
+    return false;
+  }
+
+  static_cast<void>(MoveEntity(*entity, FindOrCreateNeighbor(entity->GetLocation().table, type_id, false)));
+  return true;
+}
+
+}  // namespace engine::ecs
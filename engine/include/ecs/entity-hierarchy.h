@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ecs/entity-id.h"
+namespace engine::ecs {
+
+/**
+ * @class EntityHierarchy
+ * @brief Parent/child relations of entities, stored as flat arrays of links.
+ *
+ * Every entity has one node, indexed by the slot of its ID, that holds the slot of its parent, the slot of its first
+ * child, the slots of its previous and next siblings, and its depth. Entities without a parent are roots and are
+ * linked into a list of roots through their sibling links.
+ *
+ * Linking and unlinking a node is O(1). Traversals follow the links without recursion or auxiliary storage, so deep
+ * hierarchies neither overflow the stack nor allocate. The hierarchy does not check whether IDs are alive; this is
+ * the job of the owning EntityCollection.
+ */
+class EntityHierarchy final {
+ public:
+  /**
+   * @brief Default constructor for EntityHierarchy.
+   */
+  EntityHierarchy() = default;
+
+  /**
+   * @brief Adds a new entity as the first child of a parent, or as a root.
+   * @param entity_id The ID of the new entity, which must not be in the hierarchy.
+   * @param parent_id The ID of an entity in the hierarchy, or the root ID.
+   */
+  void Insert(const EntityID& entity_id, const EntityID& parent_id);
+
+  /**
+   * @brief Removes an entity from the hierarchy. Its children become roots.
+   * @param entity_id The ID of an entity in the hierarchy.
+   */
+  void Remove(const EntityID& entity_id);
+
+  /**
+   * @brief Moves an entity, together with its subtree, under a new parent.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @param parent_id The ID of another entity in the hierarchy, or the root ID to make the entity a root.
+   * @return True if the entity was moved, false if the new parent is inside the subtree of the entity.
+   */
+  [[maybe_unused]] bool SetParent(const EntityID& entity_id, const EntityID& parent_id);
+
+  /**
+   * @brief Removes all entities.
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Retrieves the number of heap bytes reserved by the hierarchy.
+   * @return The number of bytes of the link array.
+   */
+  [[nodiscard]] std::size_t BytesReserved() const noexcept;
+
+  /**
+   * @brief Retrieves the parent of an entity.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @return The ID of the parent, or the root ID if the entity is a root.
+   */
+  [[nodiscard]] EntityID GetParent(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Retrieves the first child of an entity.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @return The ID of the most recently attached child, or the root ID if the entity has no children.
+   */
+  [[nodiscard]] EntityID GetFirstChild(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Retrieves the sibling that follows an entity in the children of its parent, or in the roots.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @return The ID of the next sibling, or the root ID if the entity is the last one.
+   */
+  [[nodiscard]] EntityID GetNextSibling(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Retrieves the depth of an entity.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @return The number of ancestors of the entity, 0 for roots.
+   */
+  [[nodiscard]] std::size_t GetDepth(const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Checks if an entity is an ancestor of another one.
+   * @param ancestor_id The ID of the potential ancestor.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @return True if `ancestor_id` is on the path from the entity to its root, the entity excluded.
+   */
+  [[nodiscard]] bool IsAncestorOf(const EntityID& ancestor_id, const EntityID& entity_id) const noexcept;
+
+  /**
+   * @brief Visits the direct children of an entity, most recently attached first.
+   * @tparam Visitor A callable invoked as `visitor(const EntityID&)`. It must not change the hierarchy.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void ForEachChild(const EntityID& entity_id, Visitor&& visitor) const;
+
+  /**
+   * @brief Visits all descendants of an entity, every parent before its children.
+   * @tparam Visitor A callable invoked as `visitor(const EntityID&)`. It must not change the hierarchy.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void ForEachDescendant(const EntityID& entity_id, Visitor&& visitor) const;
+
+  /**
+   * @brief Visits an entity and its descendants, every parent before its children, skipping pruned subtrees.
+   * @tparam Visitor A callable invoked as `visitor(const EntityID&)`, returning false to skip the descendants of the
+   * visited entity. It must not change the hierarchy.
+   * @param entity_id The ID of an entity in the hierarchy.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void WalkSubtree(const EntityID& entity_id, Visitor&& visitor) const;
+
+  /**
+   * @brief Visits the roots of the hierarchy.
+   * @tparam Visitor A callable invoked as `visitor(const EntityID&)`. It must not change the hierarchy.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void ForEachRoot(Visitor&& visitor) const;
+
+  /**
+   * @brief Visits all entities in depth order: every root is followed by its subtree, parents before children.
+   * @tparam Visitor A callable invoked as `visitor(const EntityID&)`. It must not change the hierarchy.
+   * @param visitor The callable to invoke.
+   */
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const;
+
+ private:
+  /**
+   * @brief Slot index that marks a missing link.
+   */
+  static constexpr std::uint32_t kNoIndex = ~std::uint32_t{0};
+
+  /**
+   * @brief Links of a single entity.
+   */
+  struct Node final {
+    EntityID id;                          ///< ID of the entity.
+    std::uint32_t parent{kNoIndex};       ///< Slot of the parent.
+    std::uint32_t first_child{kNoIndex};  ///< Slot of the first child.
+    std::uint32_t previous{kNoIndex};     ///< Slot of the previous sibling.
+    std::uint32_t next{kNoIndex};         ///< Slot of the next sibling.
+    std::uint32_t depth{0};               ///< Number of ancestors.
+  };
+
+  /**
+   * @brief Links a node as the first child of a parent, or as the first root.
+   * @param index The slot of the node, which must be unlinked.
+   * @param parent The slot of the parent, or kNoIndex.
+   */
+  void Link(std::uint32_t index, std::uint32_t parent) noexcept;
+
+  /**
+   * @brief Unlinks a node from its parent and its siblings. Its children stay attached to it.
+   * @param index The slot of the node.
+   */
+  void Unlink(std::uint32_t index) noexcept;
+
+  /**
+   * @brief Recomputes the depth of every descendant of a node from the depth of the node.
+   * @param index The slot of the node.
+   */
+  void UpdateDepths(std::uint32_t index) noexcept;
+
+  /**
+   * @brief Finds the node that follows another one in a pre-order walk of a subtree.
+   * @param index The slot of the current node.
+   * @param subtree The slot of the root of the walked subtree.
+   * @return The slot of the next node, or kNoIndex once the subtree is exhausted.
+   */
+  [[nodiscard]] std::uint32_t NextInSubtree(std::uint32_t index, std::uint32_t subtree) const noexcept;
+
+  /**
+   * @brief Finds the node that follows the descendants of another one in a pre-order walk of a subtree.
+   * @param index The slot of the current node.
+   * @param subtree The slot of the root of the walked subtree.
+   * @return The slot of the next node, or kNoIndex once the subtree is exhausted.
+   */
+  [[nodiscard]] std::uint32_t NextAfterDescendants(std::uint32_t index, std::uint32_t subtree) const noexcept;
+
+  std::vector<Node> nodes_;             ///< Links of every entity, indexed by the slot of its ID.
+  std::uint32_t first_root_{kNoIndex};  ///< Slot of the first root.
+};
+
+template <typename Visitor>
+void EntityHierarchy::ForEachChild(const EntityID& entity_id, Visitor&& visitor) const {
+  for (std::uint32_t child = nodes_[entity_id.GetIndex()].first_child; child != kNoIndex; child = nodes_[child].next) {
+    visitor(nodes_[child].id);
+  }
+}
+
+template <typename Visitor>
+void EntityHierarchy::ForEachDescendant(const EntityID& entity_id, Visitor&& visitor) const {
+  std::uint32_t subtree = entity_id.GetIndex();
+  for (std::uint32_t index = NextInSubtree(subtree, subtree); index != kNoIndex;
+       index = NextInSubtree(index, subtree)) {
+    visitor(nodes_[index].id);
+  }
+}
+
+template <typename Visitor>
+void EntityHierarchy::WalkSubtree(const EntityID& entity_id, Visitor&& visitor) const {
+  std::uint32_t subtree = entity_id.GetIndex();
+  std::uint32_t index = subtree;
+  while (index != kNoIndex) {
+    index = visitor(nodes_[index].id) ? NextInSubtree(index, subtree) : NextAfterDescendants(index, subtree);
+  }
+}
+
+template <typename Visitor>
+void EntityHierarchy::ForEachRoot(Visitor&& visitor) const {
+  for (std::uint32_t root = first_root_; root != kNoIndex; root = nodes_[root].next) {
+    visitor(nodes_[root].id);
+  }
+}
+
+template <typename Visitor>
+void EntityHierarchy::ForEach(Visitor&& visitor) const {
+  for (std::uint32_t root = first_root_; root != kNoIndex; root = nodes_[root].next) {
+    visitor(nodes_[root].id);
+    ForEachDescendant(nodes_[root].id, visitor);
+  }
+}
+
+}  // namespace engine::ecs
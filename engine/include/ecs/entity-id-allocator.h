@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ecs/entity-id.h"
+namespace engine::ecs {
+
+/**
+ * @class EntityIDAllocator
+ * @brief Issues Entity IDs and recycles the slots of released IDs.
+ *
+ * Every slot has a generation. Releasing an ID increments the generation of its slot and puts the slot on a free
+ * list, so the next allocation reuses the slot under a new generation, and the released ID is no longer alive.
+ * All operations are O(1).
+ */
+class EntityIDAllocator final {
+ public:
+  /**
+   * @brief Default constructor for EntityIDAllocator.
+   */
+  EntityIDAllocator() = default;
+
+  /**
+   * @brief Retrieves the number of alive IDs.
+   * @return The number of IDs that were allocated and not released.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  /**
+   * @brief Retrieves the number of slots, alive or free.
+   * @return The number of slots. Every alive ID has an index less than this value.
+   */
+  [[nodiscard]] std::size_t Capacity() const noexcept;
+
+  /**
+   * @brief Retrieves the number of heap bytes reserved by the allocator.
+   * @return The number of bytes of the slot and free-index arrays.
+   */
+  [[nodiscard]] std::size_t BytesReserved() const noexcept;
+
+  /**
+   * @brief Issues a new ID, reusing a free slot if there is one.
+   * @return The new ID.
+   */
+  [[nodiscard]] EntityID Allocate();
+
+  /**
+   * @brief Releases an alive ID so its slot can be reused.
+   * @param id The ID to release.
+   * @return True if the ID was alive and has been released, otherwise false.
+   */
+  [[maybe_unused]] bool Release(const EntityID& id);
+
+  /**
+   * @brief Checks if the ID was allocated and not released yet.
+   * @param id The ID to check.
+   * @return True if the ID is alive, otherwise false.
+   */
+  [[nodiscard]] bool IsAlive(const EntityID& id) const noexcept;
+
+  /**
+   * @brief Releases all alive IDs.
+   */
+  void Clear();
+
+  /**
+   * @brief Retrieves the generation of a slot.
+   * @param index The index of the slot, less than Capacity().
+   * @return The generation of the alive ID of the slot, or of the next ID issued from a free slot.
+   */
+  [[nodiscard]] std::uint32_t GetGeneration(std::uint32_t index) const noexcept;
+
+  /**
+   * @brief Retrieves the indices of the free slots.
+   * @return The free slots, the one reused first being the last.
+   */
+  [[nodiscard]] std::span<const std::uint32_t> GetFreeIndices() const noexcept;
+
+  /**
+   * @brief Replaces the state of the allocator with a saved one.
+   *
+   * Slots that are not listed as free are alive, so the allocator continues exactly where the saved one stopped.
+   *
+   * @param generations The generation of every slot, indexed by slot index.
+   * @param free_indices The indices of the free slots, as returned by GetFreeIndices().
+   */
+  void Restore(std::span<const std::uint32_t> generations, std::span<const std::uint32_t> free_indices);
+
+ private:
+  /**
+   * @brief State of a single slot.
+   */
+  struct Slot final {
+    std::uint32_t generation{0};  ///< Generation of the current or of the next ID of the slot.
+    bool is_alive{false};         ///< Whether the slot is used by an alive ID.
+  };
+
+  std::vector<Slot> slots_;                  ///< State of every slot, indexed by slot index.
+  std::vector<std::uint32_t> free_indices_;  ///< Indices of the free slots, reused last in first out.
+  std::size_t alive_count_{0};               ///< Number of alive IDs.
+};
+
+}  // namespace engine::ecs
@@ -1,40 +1,67 @@
 #pragma once
 
+#include <compare>
 #include <cstddef>
-#include <string>
+#include <cstdint>
 namespace engine::ecs {
 
 /**
  * @brief A class to represent an Entity ID in an ECS (Entity-Component-System) framework.
  *
- * This class is used to uniquely identify entities within an ECS system. It includes functionality to
- * generate new IDs, retrieve the root ID, and compute hashes for the IDs. It also supports comparison
- * operators.
+ * This class is used to uniquely identify entities within an ECS system. An Entity ID is a trivially copyable 64-bit
+ * value made of a slot index and a generation. The index addresses the slot of the entity inside its collection, and
+ * the generation tells apart entities that reuse the same slot, so handles to destroyed entities can be detected.
+ *
+ * New IDs are issued by an EntityIDAllocator. A default-constructed Entity ID equals the root ID.
  */
 class EntityID final {
  public:
   /**
-   * @brief Constructs a new Entity ID.
+   * @brief Constructs the root Entity ID.
+   */
+  constexpr EntityID() noexcept = default;
+
+  /**
+   * @brief Constructs an Entity ID from its parts.
+   *
+   * @param[in] index The index of the slot of the entity.
+   * @param[in] generation The generation of the slot at the moment the entity was created.
+   */
+  constexpr EntityID(std::uint32_t index, std::uint32_t generation) noexcept
+      : inner_data_(static_cast<std::uint64_t>(generation) << 32U | index) {}
+
+  /**
+   * @brief Retrieves the index of the slot of the entity.
+   *
+   * @return The slot index.
+   */
+  [[nodiscard]] constexpr std::uint32_t GetIndex() const noexcept { return static_cast<std::uint32_t>(inner_data_); }
+
+  /**
+   * @brief Retrieves the generation of the slot at the moment the entity was created.
    *
-   * This constructor generates a unique ID based on the current thread ID and the current time in nanoseconds.
+   * @return The generation.
    */
-  EntityID();
+  [[nodiscard]] constexpr std::uint32_t GetGeneration() const noexcept {
+    return static_cast<std::uint32_t>(inner_data_ >> 32U);
+  }
 
   /**
-   * @brief Retrieves the internal string representation of the Entity ID.
+   * @brief Retrieves the internal 64-bit representation of the Entity ID.
    *
-   * @return std::string The internal string representation of the Entity ID.
+   * @return The generation in the upper 32 bits and the index in the lower 32 bits.
    */
-  [[nodiscard]] std::string GetInnerData() const noexcept;
+  [[nodiscard]] constexpr std::uint64_t GetInnerData() const noexcept { return inner_data_; }
 
   /**
    * @brief Retrieves the root Entity ID.
    *
    * The root ID is a special ID that represents the root or default Entity ID, typically used as a placeholder.
+   * It is never issued by an EntityIDAllocator.
    *
    * @return EntityID The root Entity ID.
    */
-  [[nodiscard]] static EntityID GetRootID() noexcept;
+  [[nodiscard]] static constexpr EntityID GetRootID() noexcept { return {}; }
 
   /**
    * @brief Compares this Entity ID with another for ordering.
@@ -44,7 +71,7 @@ class EntityID final {
    * @param[in] other The other Entity ID to compare with.
    * @return std::strong_ordering The result of the comparison.
    */
-  [[nodiscard]] bool operator<=>(const EntityID& other) const = default;
+  [[nodiscard]] constexpr std::strong_ordering operator<=>(const EntityID& other) const noexcept = default;
 
   /**
    * @brief A class to compute the hash value of an Entity ID.
@@ -63,7 +90,7 @@ class EntityID final {
   };
 
  private:
-  std::string inner_data_;  // The internal string representation of the Entity ID.
+  std::uint64_t inner_data_{~std::uint64_t{0}};  // Generation in the upper half, slot index in the lower half.
 };
 
-}  // namespace engine::ecs
\ No newline at end of file
+}  // namespace engine::ecs
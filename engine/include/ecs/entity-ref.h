@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "ecs/archetype-table.h"
+#include "ecs/component-base.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-id.h"
+#include "ecs/tag-component.h"
+namespace engine::ecs {
+
+/**
+ * @class BasicEntityRef
+ * @brief A lightweight reference to the components of a single entity stored in an archetype table.
+ *
+ * The reference stays valid until the next structural change of the EntityCollection it was obtained from
+ * (insertion or removal of entities, addition or removal of components).
+ *
+ * @tparam TableType Either `ArchetypeTable` for mutable access or `const ArchetypeTable` for read-only access.
+ */
+template <typename TableType>
+class BasicEntityRef final {
+ public:
+  /**
+   * @brief Constructs a reference to a row of an archetype table.
+   * @param table The table that stores the entity.
+   * @param row The row of the entity inside the table.
+   */
+  BasicEntityRef(TableType& table, std::size_t row) noexcept : table_(&table), row_(row) {}
+
+  /**
+   * @brief Retrieves the ID of the referenced entity.
+   * @return The ID of the entity.
+   */
+  [[nodiscard]] const EntityID& GetID() const noexcept { return table_->EntityAt(row_); }
+
+  /**
+   * @brief Retrieves the component types of the referenced entity.
+   * @return The signature of the table that stores the entity.
+   */
+  [[nodiscard]] const ComponentSignature& GetSignature() const noexcept { return table_->Signature(); }
+
+  /**
+   * @brief Get a component of the specified type.
+   *
+   * Through a mutable reference, the component is stamped as changed for change detection. Tag components have no
+   * storage; use HasAll() for them.
+   *
+   * @tparam ComponentType The type of the component to get.
+   * @return A pointer to the component, or nullptr if the entity has no component of this type.
+   */
+  template <is_component ComponentType>
+    requires(!is_tag_component<ComponentType>)
+  [[nodiscard]] auto* Get() const noexcept;
+
+  /**
+   * @brief Check if all specified component types are present in the entity.
+   * @tparam ComponentTypes The types of components to check.
+   * @return true if all components are present, false otherwise.
+   */
+  template <is_component... ComponentTypes>
+  [[nodiscard]] bool HasAll() const noexcept;
+
+  /**
+   * @brief Check if any of the specified component types are present in the entity.
+   * @tparam ComponentTypes The types of components to check.
+   * @return true if any of the components are present, false otherwise.
+   */
+  template <is_component... ComponentTypes>
+  [[nodiscard]] bool HasAny() const noexcept;
+
+  /**
+   * @brief Check if none of the specified component types are present in the entity.
+   * @tparam ComponentTypes The types of components to check.
+   * @return true if none of the components are present, false otherwise.
+   */
+  template <is_component... ComponentTypes>
+  [[nodiscard]] bool HasNoneOf() const noexcept;
+
+ private:
+  TableType* table_;  ///< Table that stores the entity.
+  std::size_t row_;   ///< Row of the entity inside the table.
+};
+
+/**
+ * @typedef EntityRef
+ * @brief A reference that grants mutable access to the components of an entity.
+ */
+using EntityRef = BasicEntityRef<ArchetypeTable>;
+
+/**
+ * @typedef ConstEntityRef
+ * @brief A reference that grants read-only access to the components of an entity.
+ */
+using ConstEntityRef = BasicEntityRef<const ArchetypeTable>;
+
+template <typename TableType>
+template <is_component ComponentType>
+  requires(!is_tag_component<ComponentType>)
+auto* BasicEntityRef<TableType>::Get() const noexcept {
+  using Result = std::conditional_t<std::is_const_v<TableType>, const ComponentType, ComponentType>;
+  std::size_t column = table_->template FindColumn<ComponentType>();
+  if (column == ArchetypeTable::kNoColumn) {
+    return static_cast<Result*>(nullptr);
+  }
+  if constexpr (!std::is_const_v<TableType>) {
+    table_->MarkChanged(column, row_);
+  }
+  return static_cast<Result*>(table_->At(column, row_));
+}
+
+template <typename TableType>
+template <is_component... ComponentTypes>
+bool BasicEntityRef<TableType>::HasAll() const noexcept {
+  return table_->template HasAll<ComponentTypes...>();
+}
+
+template <typename TableType>
+template <is_component... ComponentTypes>
+bool BasicEntityRef<TableType>::HasAny() const noexcept {
+  return table_->template HasAny<ComponentTypes...>();
+}
+
+template <typename TableType>
+template <is_component... ComponentTypes>
+bool BasicEntityRef<TableType>::HasNoneOf() const noexcept {
+  return !table_->template HasAny<ComponentTypes...>();
+}
+
+}  // namespace engine::ecs
@@ -1,17 +1,22 @@
 #pragma once
 
-#include <unordered_set>
-
-#include "ecs/component-collection.h"
-#include "ecs/entity-id.h"
+#include <cstddef>
 namespace engine::ecs {
 
+/**
+ * @brief The place where the components of an entity are stored.
+ */
+struct EntityLocation final {
+  std::size_t table{0};  ///< Index of the archetype table inside the owning EntityCollection.
+  std::size_t row{0};    ///< Index of the row inside the archetype table.
+};
+
 /**
  * @class Entity
- * @brief A class representing an entity in a relationship hierarchy.
+ * @brief A class representing the record of an entity inside an EntityCollection.
  *
- * The Entity class allows for the management of parent-child relationships
- * and the associated components of the entity.
+ * The Entity class remembers where the components of the entity are stored. Parent/child relations are kept apart,
+ * in the EntityHierarchy of the owning collection.
  */
 class Entity final {
  public:
@@ -21,91 +26,19 @@ class Entity final {
   Entity() = default;
 
   /**
-   * @brief Retrieves the ID of the parent entity.
-   * @return The ID of the parent entity.
-   */
-  [[nodiscard]] EntityID GetParentID() const noexcept;
-
-  /**
-   * @brief Remembers a new parent entity by its ID.
-   * @param new_parent_id The ID of the new parent entity.
-   */
-  void RememberParent(const EntityID& new_parent_id);
-
-  /**
-   * @brief Checks if this entity is a child of the specified entity.
-   * @param entity_id The ID of the potential parent entity.
-   * @return True if this entity is a child of the specified entity, otherwise false.
-   */
-  [[nodiscard]] bool IsChildOf(const EntityID& entity_id) const noexcept;
-
-  /**
-   * @brief Retrieves the IDs of all child entities.
-   * @return A set of IDs representing the children of this entity.
-   */
-  [[nodiscard]] std::unordered_set<EntityID, EntityID::Hash> GetChildrenIDs() const noexcept;
-
-  /**
-   * @brief Attempts to remember a new child entity by its ID.
-   * @param new_child_id The ID of the new child entity.
-   * @return True if the child was successfully remembered, otherwise false.
-   */
-  [[maybe_unused]] bool RememberChild(const EntityID& new_child_id);
-
-  /**
-   * @brief Attempts to forget a child entity by its ID.
-   * @param target_child_id The ID of the child entity to forget.
-   * @return True if the child was successfully forgotten, otherwise false.
+   * @brief Retrieves the location of the components of this entity.
+   * @return The archetype table and row that store the components.
    */
-  [[maybe_unused]] bool ForgetChild(const EntityID& target_child_id);
+  [[nodiscard]] EntityLocation GetLocation() const noexcept;
 
   /**
-   * @brief Forgets all child entities.
+   * @brief Remembers a new location of the components of this entity.
+   * @param new_location The archetype table and row that now store the components.
    */
-  void ForgetChildren();
-
-  /**
-   * @brief Checks if this entity is a parent of the specified child entity.
-   * @param target_child_id The ID of the potential child entity.
-   * @return True if this entity is a parent of the specified child, otherwise false.
-   */
-  [[nodiscard]] bool IsParentOf(const EntityID& target_child_id) const noexcept;
-
-  /**
-   * @brief Retrieves the components associated with this entity.
-   * @return A constant reference to the component collection.
-   */
-  [[nodiscard]] const ComponentCollection& GetComponents() const noexcept;
-
-  /**
-   * @brief Retrieves the components associated with this entity.
-   * @return A reference to the component collection.
-   */
-  [[nodiscard]] ComponentCollection& GetComponents() noexcept;
-
-  /**
-   * @brief Sets the components for this entity.
-   * @param new_data The new component collection to set.
-   */
-  void SetComponents(const ComponentCollection& new_data);
-
-  /**
-   * @brief Sets the components for this entity using move semantics.
-   * @param new_data The new component collection to set, moved.
-   */
-  void SetComponents(ComponentCollection&& new_data);
-
-  /**
-   * @brief Clones the components of this entity.
-   * @return A new component collection that is a clone of the original.
-   */
-  [[nodiscard]] ComponentCollection CloneComponents() const noexcept;
+  void SetLocation(const EntityLocation& new_location) noexcept;
 
  private:
-  EntityID parent_id_{EntityID::GetRootID()};                  ///< ID of the parent entity.
-  std::unordered_set<EntityID, EntityID::Hash> children_ids_;  ///< ID of child entities.
-
-  ComponentCollection data_;  ///< Inner components of this entity.
+  EntityLocation location_;  ///< Location of the components of this entity.
 };
 
 }  // namespace engine::ecs
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+namespace engine::ecs {
+
+/**
+ * @brief Memory used by the components of one type across every table of a collection.
+ */
+struct ComponentMemoryStatistics final {
+  const ComponentInfo* info{nullptr};  ///< Descriptor of the component type.
+  std::size_t count{0};                ///< Number of entities that have the component.
+  std::size_t bytes{0};                ///< Bytes of the stored components, zero for tags.
+  std::size_t tick_bytes{0};           ///< Bytes of the change ticks of the stored components.
+};
+
+/**
+ * @brief Memory used by one ArchetypeTable of a collection.
+ */
+struct ArchetypeMemoryStatistics final {
+  ComponentSignature signature;    ///< Component types of the table.
+  std::size_t entity_count{0};     ///< Number of rows.
+  std::size_t chunk_count{0};      ///< Number of chunks held, including unused and adopted ones.
+  std::size_t chunk_capacity{0};   ///< Number of rows per chunk.
+  std::size_t chunk_bytes{0};      ///< Bytes of the held chunks.
+  std::size_t component_bytes{0};  ///< Bytes of the stored components, the part of the chunks in use.
+  std::size_t metadata_bytes{0};   ///< Heap bytes of the row owners, change ticks and chunk list.
+
+  /**
+   * @brief Computes the fraction of the rows of the held chunks that store an entity.
+   * @return The occupancy, between 0 and 1, or 1 if the table holds no chunk.
+   */
+  [[nodiscard]] double Occupancy() const noexcept;
+};
+
+/**
+ * @brief A breakdown of the memory used by an EntityCollection, see EntityCollection::GetMemoryStatistics().
+ *
+ * Only memory owned by the collection is counted. Heap memory owned by the components themselves, such as the values
+ * of a SharedComponent, is not visible to the collection and is left out. Sizes of hash maps are estimated from their
+ * bucket and node counts.
+ */
+struct MemoryStatistics final {
+  std::size_t entity_count{0};                        ///< Number of entities.
+  std::vector<ComponentMemoryStatistics> components;  ///< Every stored component type, by ascending type ID.
+  std::vector<ArchetypeMemoryStatistics> archetypes;  ///< Every table, in order of creation.
+  std::size_t chunk_bytes{0};                         ///< Bytes of the chunks held by every table.
+  std::size_t component_bytes{0};                     ///< Bytes of the stored components.
+  std::size_t table_bytes{0};                         ///< Heap bytes of tables, their index and edges, but not chunks.
+  std::size_t hierarchy_bytes{0};                     ///< Heap bytes of the parent/child relations.
+  std::size_t id_bytes{0};                            ///< Heap bytes of the ID allocator and of the entity records.
+  std::size_t other_bytes{0};                         ///< Heap bytes of the removal log and of the scratch buffers.
+  std::size_t arena_reserved_bytes{0};                ///< Bytes of the blocks of the chunk arena.
+  std::size_t arena_used_bytes{0};                    ///< Bytes of the chunk arena handed to the tables.
+  std::size_t adopted_bytes{0};                       ///< Bytes of the chunks adopted from outside of the arena.
+
+  /**
+   * @brief Computes the number of bytes held by the collection.
+   * @return The sum of the arena blocks, the adopted chunks and the heap bytes of every other container.
+   */
+  [[nodiscard]] std::size_t TotalBytes() const noexcept;
+
+  /**
+   * @brief Computes the number of held bytes that store no component: free space of the arena, empty rows of the
+   * chunks, and padding between the columns of the chunks.
+   * @return The number of unused bytes.
+   */
+  [[nodiscard]] std::size_t FragmentationBytes() const noexcept;
+};
+
+/**
+ * @brief Writes memory statistics as a single-line JSON object, for logs.
+ * @param output The stream to write to.
+ * @param statistics The statistics to write.
+ */
+void WriteMemoryStatistics(std::ostream& output, const MemoryStatistics& statistics);
+
+}  // namespace engine::ecs
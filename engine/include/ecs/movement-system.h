@@ -0,0 +1,100 @@
+#pragma once
+
+#include <span>
+
+#include "ecs/entity-collection.h"
+#include "ecs/movement.h"
+#include "ecs/query-cache.h"
+#include "ecs/system.h"
+#include "jobs/job-system.h"
+namespace engine::ecs {
+
+/**
+ * @brief The instruction sets a movement kernel can be written in.
+ */
+enum class SimdLevel {
+  kScalar,  ///< Plain C++, available everywhere.
+  kSse,     ///< 128-bit SSE vectors, 2 entities per instruction.
+  kAvx2,    ///< 256-bit AVX2 vectors, 4 entities per instruction.
+};
+
+/**
+ * @class MovementSystem
+ * @brief Advances the Position of every entity by its Velocity times a fixed time step.
+ *
+ * Entities are processed a chunk at a time: the Position and Velocity columns of a chunk are integrated as two flat
+ * arrays of floats by a kernel that uses the widest instruction set the CPU supports, detected once at run time.
+ * Every kernel computes `position + velocity * time_step` with a separate multiplication and addition, so all of them
+ * produce the same bits and a simulation stays deterministic across machines.
+ *
+ * With a job system, the chunks are spread over the workers.
+ */
+class MovementSystem final : public System {
+ public:
+  /**
+   * @brief Constructs the system with the fastest supported kernel.
+   * @param time_step The time elapsed per frame, in the unit of the velocities.
+   * @param jobs The job system that processes chunks in parallel, or nullptr to process them on the calling thread.
+   * It must outlive the system.
+   */
+  explicit MovementSystem(float time_step = 1.0F, jobs::JobSystem* jobs = nullptr);
+
+  /**
+   * @brief Moves every entity that has both a Position and a Velocity.
+   * @param entities The collection to update.
+   */
+  void Update(EntityCollection& entities) override;
+
+  /**
+   * @brief Retrieves the time elapsed per frame.
+   * @return The time step.
+   */
+  [[nodiscard]] float GetTimeStep() const noexcept;
+
+  /**
+   * @brief Changes the time elapsed per frame.
+   * @param time_step The new time step.
+   */
+  void SetTimeStep(float time_step) noexcept;
+
+  /**
+   * @brief Retrieves the instruction set of the kernel in use.
+   * @return The instruction set.
+   */
+  [[nodiscard]] SimdLevel GetSimdLevel() const noexcept;
+
+  /**
+   * @brief Selects the kernel written in a given instruction set, for instance to compare kernels.
+   * @param level The instruction set.
+   * @throw std::invalid_argument If the CPU does not support the instruction set.
+   */
+  void SetSimdLevel(SimdLevel level);
+
+  /**
+   * @brief Detects the widest instruction set the CPU supports.
+   * @return The widest supported instruction set, kScalar on CPUs other than x86.
+   */
+  [[nodiscard]] static SimdLevel DetectSimdLevel() noexcept;
+
+  /**
+   * @brief Advances positions by velocities.
+   *
+   * The spans may start at any address and have any length; the kernel aligns its stores with a scalar prologue and
+   * finishes the elements that do not fill a vector with a scalar epilogue.
+   *
+   * @param positions The positions to advance.
+   * @param velocities The velocities, one per position.
+   * @param time_step The time elapsed.
+   * @param level The instruction set of the kernel, which must be supported by the CPU.
+   */
+  static void Integrate(std::span<Position> positions, std::span<const Velocity> velocities, float time_step,
+                        SimdLevel level) noexcept;
+
+ private:
+  jobs::JobSystem* jobs_;   ///< Runs the chunks in parallel, may be nullptr.
+  float time_step_;         ///< Time elapsed per frame.
+  SimdLevel level_;         ///< Instruction set of the kernel in use.
+  QueryCache query_cache_;  ///< Tables that hold positions and velocities.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <type_traits>
+
+namespace engine::ecs {
+
+/**
+ * @brief The location of an entity in the world, advanced by the MovementSystem.
+ *
+ * Both movement components are plain trivially copyable pairs of floats, so a column of either one is a contiguous
+ * array of interleaved coordinates that the MovementSystem integrates with vector instructions.
+ */
+struct Position final {
+ public:
+  Position() = default;
+  Position(float x, float y) : x_coord(x), y_coord(y) {}
+
+  float x_coord{}, y_coord{};  ///< Coordinates in the world.
+};
+
+/**
+ * @brief The displacement of an entity per unit of time, applied to its Position by the MovementSystem.
+ */
+struct Velocity final {
+ public:
+  Velocity() = default;
+  Velocity(float x, float y) : x_speed(x), y_speed(y) {}
+
+  float x_speed{}, y_speed{};  ///< Displacement per unit of time along each axis.
+};
+
+static_assert(sizeof(Position) == 2 * sizeof(float) && std::is_trivially_copyable_v<Position>,
+              "The movement kernels read Position columns as arrays of floats");
+static_assert(sizeof(Velocity) == sizeof(Position) && std::is_trivially_copyable_v<Velocity>,
+              "The movement kernels pair every Velocity float with a Position float");
+
+}  // namespace engine::ecs
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ecs/component-base.h"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+namespace engine::ecs {
+
+/**
+ * @class Prefab
+ * @brief A template of an entity with fully populated components and child entities, instantiated in bulk.
+ *
+ * Instantiating a prefab N times inserts the N copies of every entity of the template into a single archetype table
+ * at once, copying each column range by range (with memcpy for trivially copyable components), instead of
+ * default-constructing the entities and emplacing values one by one.
+ *
+ * Large read-only data should be stored in SharedComponent, which the instances share by reference until one of them
+ * writes to it.
+ */
+class Prefab final {
+ public:
+  /**
+   * @brief Constructs a prefab without components and children.
+   */
+  Prefab() = default;
+
+  /**
+   * @brief Constructs a prefab without children.
+   * @param components The components of the root entity of the template.
+   */
+  explicit Prefab(ComponentCollection components);
+
+  /**
+   * @brief Captures an entity and its subtree as a prefab.
+   * @param entities The collection that stores the entity.
+   * @param entity_id The ID of the entity.
+   * @return The prefab, empty if the entity does not exist.
+   */
+  [[nodiscard]] static Prefab Capture(const EntityCollection& entities, const EntityID& entity_id);
+
+  /**
+   * @brief Emplaces a component into the root entity of the template.
+   * @tparam ComponentType The type of the component to be added.
+   * @tparam Args Types of the arguments to pass to the component's constructor.
+   * @param arguments The arguments forwarded to the constructor.
+   * @return True if the component was emplaced, false if the template already has such component.
+   */
+  template <is_component ComponentType, typename... Args>
+  [[maybe_unused]] bool Emplace(Args&&... arguments);
+
+  /**
+   * @brief Adds a child entity to the template.
+   * @param child The template of the child, with its own children.
+   * @return A reference to the stored child, valid until the next child is added.
+   */
+  [[maybe_unused]] Prefab& AddChild(Prefab child);
+
+  /**
+   * @brief Retrieves the components of the root entity of the template.
+   * @return A read-only reference to the components.
+   */
+  [[nodiscard]] const ComponentCollection& GetComponents() const noexcept;
+
+  /**
+   * @brief Retrieves the children of the template.
+   * @return The children, in the order in which EntityHierarchy::ForEachChild() visits the instantiated children.
+   */
+  [[nodiscard]] const std::vector<Prefab>& GetChildren() const noexcept;
+
+  /**
+   * @brief Instantiates the template many times.
+   * @param entities The collection that receives the new entities.
+   * @param count The number of instances.
+   * @param parent_id The ID of the parent of every instance, or the root ID.
+   * @return The IDs of the root entities of the instances.
+   */
+  [[nodiscard]] std::vector<EntityID> Instantiate(EntityCollection& entities, std::size_t count,
+                                                  const EntityID& parent_id = EntityID::GetRootID()) const;
+
+ private:
+  /**
+   * @brief Instantiates the template once under each of the specified parents.
+   * @param entities The collection that receives the new entities.
+   * @param parent_ids The IDs of the parents, one per instance.
+   */
+  void InstantiateUnder(EntityCollection& entities, std::span<const EntityID> parent_ids) const;
+
+  /**
+   * @brief Instantiates the children of the template under the root entities of its instances.
+   * @param entities The collection that receives the new entities.
+   * @param instance_ids The IDs of the root entities of the instances.
+   */
+  void InstantiateChildren(EntityCollection& entities, std::span<const EntityID> instance_ids) const;
+
+  ComponentCollection components_;  ///< Components of the root entity of the template.
+  std::vector<Prefab> children_;    ///< Templates of the children.
+};
+
+template <is_component ComponentType, typename... Args>
+bool Prefab::Emplace(Args&&... arguments) {
+  return components_.Emplace<ComponentType>(std::forward<Args>(arguments)...);
+}
+
+}  // namespace engine::ecs
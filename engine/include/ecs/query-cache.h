@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+namespace engine::ecs {
+
+/**
+ * @class QueryCache
+ * @brief The list of the archetype tables of an EntityCollection that a query matches, kept between runs.
+ *
+ * Tables are only appended to a collection, so the list is brought up to date by testing the tables created since
+ * the previous update, and a run of the query costs no signature test at all once no new archetype appears. The list
+ * is rebuilt when the cache is used with another collection or another query, or after the collection was reset.
+ *
+ * A cache is usually a member of the System that runs the query, and is handed to the Query on every run:
+ * `Query<With<Position>, Without<>>(entities, cache_)`.
+ */
+class QueryCache final {
+ public:
+  /**
+   * @typedef Matcher
+   * @brief The function that decides if a query matches a table, such as Query::Matches().
+   */
+  using Matcher = bool (*)(const ComponentSignature& signature) noexcept;
+
+  /**
+   * @brief Constructs an empty cache, filled by the first update.
+   */
+  QueryCache() = default;
+
+  /**
+   * @brief Brings the list up to date with the tables of a collection.
+   * @param entities The collection whose tables are matched.
+   * @param matcher The function that decides if a table is matched.
+   */
+  void Update(const EntityCollection& entities, Matcher matcher);
+
+  /**
+   * @brief Retrieves the indices of the matched tables, as of the last update.
+   * @return The indices of the matched tables, in ascending order. Some of the tables may be empty.
+   */
+  [[nodiscard]] std::span<const std::size_t> GetTableIndices() const noexcept;
+
+  /**
+   * @brief Retrieves the number of table signatures tested by the cache since its construction.
+   * @return The number of tests.
+   */
+  [[nodiscard]] std::size_t GetTestCount() const noexcept;
+
+ private:
+  const EntityCollection* entities_{nullptr};  ///< Collection of the tables.
+  std::size_t table_generation_{0};            ///< Generation of the tables of the collection.
+  Matcher matcher_{nullptr};                   ///< Function the tables were tested with.
+  std::size_t tested_table_count_{0};          ///< Number of tables of the collection already tested.
+  std::vector<std::size_t> table_indices_;     ///< Indices of the matched tables.
+  std::size_t test_count_{0};                  ///< Number of tests since construction.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,668 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ecs/archetype-table.h"
+#include "ecs/change-tick.h"
+#include "ecs/component-base.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query-cache.h"
+#include "ecs/tag-component.h"
+#include "jobs/job-system.h"
+namespace engine::ecs {
+
+/**
+ * @brief Concept to check if a type can be requested by a query.
+ *
+ * A query accepts component types, optionally const-qualified to request read-only access.
+ *
+ * @tparam T The type to be checked against the concept requirements.
+ */
+template <typename T>
+concept is_query_component = is_component<std::remove_const_t<T>>;
+
+/**
+ * @brief List of component types an entity must have to be matched by a Query.
+ *
+ * The components are handed to the callbacks of the query, as references or as columns.
+ *
+ * @tparam ComponentTypes The required component types, const-qualified for read-only access.
+ */
+template <is_query_component... ComponentTypes>
+struct With final {};
+
+/**
+ * @brief List of component types an entity must not have to be matched by a Query.
+ *
+ * @tparam ComponentTypes The excluded component types.
+ */
+template <is_component... ComponentTypes>
+struct Without final {};
+
+/**
+ * @brief Filter of a Query that matches entities having a component, without handing it to the callbacks.
+ *
+ * This is how queries require tag components, which carry no data and therefore cannot be listed in `With` by
+ * callback APIs.
+ *
+ * @tparam ComponentType The required component type.
+ */
+template <is_component ComponentType>
+struct Has final {};
+
+/**
+ * @brief Filter of a Query that matches entities whose component was added after the tick of the query.
+ *
+ * The component type must also be present on the entity; it is not handed to the callbacks unless it is listed in
+ * `With`. Tag components have no ticks and cannot be filtered this way.
+ *
+ * @tparam ComponentType The filtered component type.
+ */
+template <is_component ComponentType>
+struct Added final {};
+
+/**
+ * @brief Filter of a Query that matches entities whose component was added or accessed mutably after the tick of the
+ * query.
+ *
+ * @tparam ComponentType The filtered component type.
+ */
+template <is_component ComponentType>
+struct Changed final {};
+
+/**
+ * @brief Filter of a Query that matches entities from which the component was removed after the tick of the query.
+ *
+ * The entity must still be alive, must match the rest of the query and must not have regained the component.
+ * Removals are read from the log of the collection, so a query takes at most one Removed filter and cannot combine
+ * it with Added or Changed filters.
+ *
+ * @tparam ComponentType The filtered component type.
+ */
+template <is_component ComponentType>
+struct Removed final {};
+
+/**
+ * @brief Properties of a query filter. The primary template is undefined.
+ * @tparam Filter The filter type.
+ */
+template <typename Filter>
+struct QueryFilterTraits;
+
+template <is_component ComponentType>
+struct QueryFilterTraits<Has<ComponentType>> final {
+  using Component = ComponentType;
+  static constexpr bool kIsTick = false;
+  static constexpr bool kIsRemoved = false;
+};
+
+template <is_component ComponentType>
+struct QueryFilterTraits<Added<ComponentType>> final {
+  static_assert(!is_tag_component<ComponentType>, "Tag components have no change ticks");
+  using Component = ComponentType;
+  static constexpr bool kIsTick = true;
+  static constexpr bool kIsRemoved = false;
+  static bool Test(const ComponentTicks& ticks, Tick since) noexcept { return ticks.added > since; }
+};
+
+template <is_component ComponentType>
+struct QueryFilterTraits<Changed<ComponentType>> final {
+  static_assert(!is_tag_component<ComponentType>, "Tag components have no change ticks");
+  using Component = ComponentType;
+  static constexpr bool kIsTick = true;
+  static constexpr bool kIsRemoved = false;
+  static bool Test(const ComponentTicks& ticks, Tick since) noexcept { return ticks.changed > since; }
+};
+
+template <is_component ComponentType>
+struct QueryFilterTraits<Removed<ComponentType>> final {
+  using Component = ComponentType;
+  static constexpr bool kIsTick = false;
+  static constexpr bool kIsRemoved = true;
+};
+
+/**
+ * @brief Concept to check if a type is a filter of a query: Has, Added, Changed or Removed.
+ * @tparam T The type to be checked against the concept requirements.
+ */
+template <typename T>
+concept is_query_filter = requires { typename QueryFilterTraits<T>::Component; };
+
+/**
+ * @brief A typed query over the archetype tables of an EntityCollection.
+ *
+ * The primary template is undefined; use `Query<With<...>, Without<...>, Filters...>`.
+ */
+template <typename IncludeList, typename ExcludeList = Without<>, typename... Filters>
+class Query;
+
+/**
+ * @class Query
+ * @brief A typed query over the archetype tables of an EntityCollection.
+ *
+ * A query visits only the tables whose component types contain every `With` type and none of the `Without` types.
+ * The match is decided once per table; inside a matching table the callbacks receive typed references that point
+ * straight into the chunk columns, so there is no per-entity lookup, virtual call or intermediate container.
+ *
+ * Without a QueryCache, every run tests the signature of every table of the collection. A query created with a
+ * QueryCache kept between runs only visits the tables listed by the cache, which tests the tables created since its
+ * previous update; empty tables are skipped either way.
+ *
+ * Added and Changed filters compare the ComponentTicks of the entities with the tick the query was created with,
+ * usually the tick of the last run of the system (see System::GetLastRunTick()). Chunks whose greatest ticks are not
+ * newer are skipped as a whole; the per-entity APIs then test every row, while EachChunk() and ParEachChunk() hand
+ * over whole chunks that contain at least one matching entity. Every non-const `With` type that is handed to a
+ * callback is stamped as changed.
+ *
+ * Tag components own no storage, so callbacks cannot receive them; a query requires them with a Has filter, and the
+ * test costs nothing beyond the signature match of the table.
+ *
+ * The collection must not be structurally changed (entities inserted or erased, components emplaced or removed)
+ * while a query runs.
+ *
+ * @tparam IncludedTypes The component types handed to the callbacks, const-qualified for read-only access.
+ * @tparam ExcludedTypes The component types that exclude an entity from the query.
+ * @tparam Filters Has, Added, Changed or Removed filters.
+ */
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+class Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...> final {
+  static constexpr bool kHasTickFilters = (QueryFilterTraits<Filters>::kIsTick || ...);
+  static constexpr bool kHasRemovedFilter = (QueryFilterTraits<Filters>::kIsRemoved || ...);
+  static_assert((std::size_t{QueryFilterTraits<Filters>::kIsRemoved} + ... + 0) <= 1,
+                "A query takes at most one Removed filter");
+  static_assert(!kHasTickFilters || !kHasRemovedFilter, "A Removed filter cannot be combined with Added or Changed");
+
+ public:
+  /**
+   * @brief Creates a query over an entity collection.
+   * @param entities The collection to query.
+   * @param since The tick the filters compare against. Only changes after this tick are matched.
+   */
+  explicit Query(EntityCollection& entities, Tick since = 0) noexcept : entities_(&entities), since_(since) {}
+
+  /**
+   * @brief Creates a query over an entity collection that visits the tables listed by a cache.
+   * @param entities The collection to query.
+   * @param cache The cache of the query, brought up to date with the tables of the collection. Must outlive the
+   * query, and must only be used by queries of this type.
+   * @param since The tick the filters compare against. Only changes after this tick are matched.
+   */
+  Query(EntityCollection& entities, QueryCache& cache, Tick since = 0)
+      : entities_(&entities), since_(since), cache_(&cache) {
+    cache.Update(entities, &Matches);
+  }
+
+  /**
+   * @brief Checks if a set of component types is matched by the query.
+   * @param signature The component types of an entity or of a table.
+   * @return True if the query matches the signature, otherwise false.
+   */
+  [[nodiscard]] static bool Matches(const ComponentSignature& signature) noexcept;
+
+  /**
+   * @brief Calls a function for every matching entity.
+   *
+   * With a Removed filter, the entities are found in the removal log of the collection, and the function is called
+   * once per recorded removal.
+   *
+   * @tparam Function A callable invoked as `function(IncludedTypes&...)` or as
+   * `function(const EntityID&, IncludedTypes&...)`.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void Each(Function&& function);
+
+  /**
+   * @brief Calls a function for every chunk of matching entities.
+   *
+   * This is the entry point for kernels that process whole columns at once. Added and Changed filters are applied
+   * per chunk, and every non-const column of a visited chunk is stamped as changed.
+   *
+   * @tparam Function A callable invoked as `function(std::span<const EntityID>, std::span<IncludedTypes>...)`, where
+   * every span has the number of entities of the chunk.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void EachChunk(Function&& function);
+
+  /**
+   * @brief Calls a function for every matching entity, spreading the chunks over the workers of a job system.
+   *
+   * Each chunk is processed by a single thread, and the call returns once every chunk has been processed.
+   *
+   * @tparam Function A callable with the same signatures as for Each(), which must be safe to call concurrently for
+   * different entities.
+   * @param jobs The job system to run on.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void ParEach(jobs::JobSystem& jobs, Function&& function);
+
+  /**
+   * @brief Calls a function for every chunk of matching entities, spreading the chunks over the workers of a job
+   * system.
+   *
+   * @tparam Function A callable with the same signature as for EachChunk(), which must be safe to call concurrently
+   * for different chunks.
+   * @param jobs The job system to run on.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void ParEachChunk(jobs::JobSystem& jobs, Function&& function);
+
+  /**
+   * @brief Reduces the matching entities in parallel.
+   *
+   * Every chunk is folded from `identity` in row order, and the partial results of the chunks are combined on the
+   * calling thread in storage order. The result therefore depends only on the contents of the collection, never on
+   * the number of workers or on scheduling, even for non-associative operations such as floating-point addition.
+   *
+   * @tparam T The type of the result.
+   * @tparam Map A callable invoked as `map(IncludedTypes&...)`, returning a `T`.
+   * @tparam Combine A callable invoked as `combine(T accumulated, T partial)`, returning a `T`.
+   * @param jobs The job system to run on.
+   * @param identity The initial value of the reduction.
+   * @param map The callable that maps an entity to a value.
+   * @param combine The callable that combines two values.
+   * @return The combined result.
+   */
+  template <typename T, typename Map, typename Combine>
+  [[nodiscard]] T ParReduce(jobs::JobSystem& jobs, T identity, Map&& map, Combine&& combine);
+
+  /**
+   * @brief Counts the matching entities.
+   * @return The number of matching entities.
+   */
+  [[nodiscard]] std::size_t Count() const noexcept;
+
+ private:
+  /**
+   * @brief A chunk of a matching table.
+   */
+  struct ChunkRef final {
+    ArchetypeTable* table;  ///< Table that owns the chunk.
+    std::size_t chunk;      ///< Index of the chunk inside the table.
+  };
+
+  /**
+   * @brief Collects the non-empty chunks of every matching table that pass the filters, in storage order.
+   * @return The matching chunks.
+   */
+  [[nodiscard]] std::vector<ChunkRef> CollectChunks() const;
+
+  /**
+   * @brief Calls a function for every non-empty matching table, in storage order.
+   * @tparam Function A callable invoked as `function(ArchetypeTable&)`.
+   */
+  template <typename Function>
+  void ForEachTable(Function&& function) const;
+
+  /**
+   * @brief Checks if a chunk may contain entities that pass the Added and Changed filters.
+   * @param table A matching table.
+   * @param chunk_index The index of a chunk of the table.
+   * @return True if the greatest ticks of the chunk pass every filter.
+   */
+  [[nodiscard]] bool ChunkPasses(const ArchetypeTable& table, std::size_t chunk_index) const noexcept;
+
+  /**
+   * @brief Checks if an entity passes the Added and Changed filters.
+   * @param table A matching table.
+   * @param row The row of the entity.
+   * @return True if the ticks of the entity pass every filter.
+   */
+  [[nodiscard]] bool RowPasses(const ArchetypeTable& table, std::size_t row) const noexcept;
+
+  /**
+   * @brief Stamps the non-const included components of a range of rows as changed.
+   * @param table A matching table.
+   * @param first_row The index of the first row.
+   * @param count The number of rows, which must all belong to the chunk of `first_row`.
+   */
+  static void MarkChanged(ArchetypeTable& table, std::size_t first_row, std::size_t count) noexcept;
+
+  /**
+   * @brief Calls a function for every entity of a chunk that passes the filters.
+   * @tparam Function A callable with the same signatures as for Each().
+   * @param chunk The chunk to visit.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void EachInChunk(const ChunkRef& chunk, Function& function) const;
+
+  /**
+   * @brief Calls a function for every entity of the removal log that passes the Removed filter.
+   * @tparam Function A callable invoked as `function(const EntityID&)`.
+   * @param function The callable to invoke.
+   */
+  template <typename Function>
+  void EachRemoved(Function&& function) const;
+
+  /**
+   * @brief Retrieves a component of an entity, stamping it as changed unless it is requested read-only.
+   * @tparam IncludedType One of the included types.
+   * @param entity_id The ID of an entity that has the component.
+   * @return A reference to the component.
+   */
+  template <typename IncludedType>
+  [[nodiscard]] IncludedType& GetComponent(const EntityID& entity_id) const;
+
+  /**
+   * @brief Calls a function for a chunk of a matching table.
+   * @tparam Function A callable invoked as `function(std::span<const EntityID>, std::span<IncludedTypes>...)`.
+   * @param chunk The chunk to visit.
+   * @param function The callable to invoke.
+   */
+  template <typename Function, std::size_t... Indices>
+  static void VisitChunk(const ChunkRef& chunk, Function& function, std::index_sequence<Indices...>);
+
+  /**
+   * @brief Calls a function for every entity of a chunk, with or without the ID of the entity.
+   * @tparam Function A callable with the same signatures as for Each().
+   * @param function The callable to invoke.
+   * @param ids The IDs of the entities of the chunk.
+   * @param columns The columns of the chunk.
+   */
+  template <typename Function>
+  static void InvokeEach(Function& function, std::span<const EntityID> ids, std::span<IncludedTypes>... columns);
+
+  EntityCollection* entities_;  ///< The queried collection.
+  Tick since_;                  ///< Tick the filters compare against.
+  QueryCache* cache_{nullptr};  ///< Matching tables, nullptr to test every table.
+};
+
+/**
+ * @typedef View
+ * @brief A query that matches every entity having all of the specified component types.
+ *
+ * @tparam ComponentTypes The required component types, const-qualified for read-only access.
+ */
+template <is_query_component... ComponentTypes>
+using View = Query<With<ComponentTypes...>, Without<>>;
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+bool Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::Matches(
+    const ComponentSignature& signature) noexcept {
+  ComponentSignature required = ComponentSignatureOf<std::remove_const_t<IncludedTypes>...>();
+  (
+      [&required] {
+        if constexpr (!QueryFilterTraits<Filters>::kIsRemoved) {
+          required.Set(ComponentTypeIDOf<typename QueryFilterTraits<Filters>::Component>());
+        }
+      }(),
+      ...);
+  return signature.ContainsAll(required) && !signature.ContainsAny(ComponentSignatureOf<ExcludedTypes...>());
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::Each(Function&& function) {
+  if constexpr (kHasRemovedFilter) {
+    EachRemoved([this, &function](const EntityID& entity_id) {
+      if constexpr (std::is_invocable_v<Function&, const EntityID&, IncludedTypes&...>) {
+        function(entity_id, GetComponent<IncludedTypes>(entity_id)...);
+      } else {
+        function(GetComponent<IncludedTypes>(entity_id)...);
+      }
+    });
+  } else {
+    for (const ChunkRef& chunk : CollectChunks()) {
+      EachInChunk(chunk, function);
+    }
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::EachChunk(Function&& function) {
+  static_assert(!kHasRemovedFilter, "Removed filters are only supported by Each() and Count()");
+  for (const ChunkRef& chunk : CollectChunks()) {
+    VisitChunk(chunk, function, std::index_sequence_for<IncludedTypes...>{});
+    MarkChanged(*chunk.table, chunk.chunk * chunk.table->ChunkCapacity(), chunk.table->ChunkSize(chunk.chunk));
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::ParEach(jobs::JobSystem& jobs,
+                                                                                   Function&& function) {
+  static_assert(!kHasRemovedFilter, "Removed filters are only supported by Each() and Count()");
+  std::vector<ChunkRef> chunks = CollectChunks();
+  jobs.ParallelFor(chunks.size(), 1, [this, &chunks, &function](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      EachInChunk(chunks[i], function);
+    }
+  });
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::ParEachChunk(jobs::JobSystem& jobs,
+                                                                                        Function&& function) {
+  static_assert(!kHasRemovedFilter, "Removed filters are only supported by Each() and Count()");
+  std::vector<ChunkRef> chunks = CollectChunks();
+  jobs.ParallelFor(chunks.size(), 1, [&chunks, &function](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const ChunkRef& chunk = chunks[i];
+      VisitChunk(chunk, function, std::index_sequence_for<IncludedTypes...>{});
+      MarkChanged(*chunk.table, chunk.chunk * chunk.table->ChunkCapacity(), chunk.table->ChunkSize(chunk.chunk));
+    }
+  });
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename T, typename Map, typename Combine>
+T Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::ParReduce(jobs::JobSystem& jobs, T identity,
+                                                                                  Map&& map, Combine&& combine) {
+  static_assert(!kHasRemovedFilter, "Removed filters are only supported by Each() and Count()");
+  std::vector<ChunkRef> chunks = CollectChunks();
+  auto reduce_chunk = [&](std::size_t chunk_index, std::size_t) {
+    T partial = identity;
+    auto fold = [&](IncludedTypes&... components) { partial = combine(std::move(partial), map(components...)); };
+    EachInChunk(chunks[chunk_index], fold);
+    return partial;
+  };
+  return jobs.ParallelReduce(chunks.size(), 1, identity, reduce_chunk, combine);
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+std::size_t Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::Count() const noexcept {
+  std::size_t count = 0;
+  if constexpr (kHasRemovedFilter) {
+    EachRemoved([&count](const EntityID&) { ++count; });
+    return count;
+  }
+  ForEachTable([this, &count](const ArchetypeTable& table) {
+    if constexpr (!kHasTickFilters) {
+      count += table.Size();
+    } else {
+      for (std::size_t chunk = 0; chunk < table.ChunkCount() && table.ChunkSize(chunk) > 0; ++chunk) {
+        if (!ChunkPasses(table, chunk)) {
+          continue;
+        }
+        std::size_t first_row = chunk * table.ChunkCapacity();
+        for (std::size_t row = first_row; row < first_row + table.ChunkSize(chunk); ++row) {
+          count += RowPasses(table, row) ? 1 : 0;
+        }
+      }
+    }
+  });
+  return count;
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+auto Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::CollectChunks() const
+    -> std::vector<ChunkRef> {
+  std::vector<ChunkRef> chunks;
+  ForEachTable([this, &chunks](ArchetypeTable& table) {
+    for (std::size_t chunk = 0; chunk < table.ChunkCount() && table.ChunkSize(chunk) > 0; ++chunk) {
+      if (ChunkPasses(table, chunk)) {
+        chunks.push_back({&table, chunk});
+      }
+    }
+  });
+  return chunks;
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::ForEachTable(Function&& function) const {
+  if (cache_ != nullptr) {
+    for (std::size_t table_index : cache_->GetTableIndices()) {
+      ArchetypeTable& table = entities_->GetTable(table_index);
+      if (!table.Empty()) {
+        function(table);
+      }
+    }
+    return;
+  }
+  for (std::size_t table_index = 0; table_index < entities_->TableCount(); ++table_index) {
+    ArchetypeTable& table = entities_->GetTable(table_index);
+    if (!table.Empty() && Matches(table.Signature())) {
+      function(table);
+    }
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+bool Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::ChunkPasses(
+    const ArchetypeTable& table, std::size_t chunk_index) const noexcept {
+  if constexpr (!kHasTickFilters) {
+    return true;
+  } else {
+    return ([&] {
+      using Traits = QueryFilterTraits<Filters>;
+      if constexpr (!Traits::kIsTick) {
+        return true;
+      } else {
+        return Traits::Test(table.ChunkTicks(table.FindColumn<typename Traits::Component>(), chunk_index), since_);
+      }
+    }() && ...);
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+bool Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::RowPasses(const ArchetypeTable& table,
+                                                                                     std::size_t row) const noexcept {
+  if constexpr (!kHasTickFilters) {
+    return true;
+  } else {
+    return ([&] {
+      using Traits = QueryFilterTraits<Filters>;
+      if constexpr (!Traits::kIsTick) {
+        return true;
+      } else {
+        return Traits::Test(table.RowTicks(table.FindColumn<typename Traits::Component>(), row), since_);
+      }
+    }() && ...);
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::MarkChanged(ArchetypeTable& table,
+                                                                                       std::size_t first_row,
+                                                                                       std::size_t count) noexcept {
+  (
+      [&] {
+        if constexpr (!std::is_const_v<IncludedTypes>) {
+          table.MarkChanged(table.FindColumn<IncludedTypes>(), first_row, count);
+        }
+      }(),
+      ...);
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::EachInChunk(const ChunkRef& chunk,
+                                                                                       Function& function) const {
+  ArchetypeTable& table = *chunk.table;
+  std::size_t first_row = chunk.chunk * table.ChunkCapacity();
+  auto visit_chunk = [&](std::span<const EntityID> ids, std::span<IncludedTypes>... columns) {
+    if constexpr (!kHasTickFilters) {
+      InvokeEach(function, ids, columns...);
+      MarkChanged(table, first_row, ids.size());
+    } else {
+      for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (RowPasses(table, first_row + i)) {
+          InvokeEach(function, ids.subspan(i, 1), columns.subspan(i, 1)...);
+          MarkChanged(table, first_row + i, 1);
+        }
+      }
+    }
+  };
+  VisitChunk(chunk, visit_chunk, std::index_sequence_for<IncludedTypes...>{});
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::EachRemoved(Function&& function) const {
+  ComponentTypeID removed_type{};
+  (
+      [&removed_type] {
+        if constexpr (QueryFilterTraits<Filters>::kIsRemoved) {
+          removed_type = ComponentTypeIDOf<typename QueryFilterTraits<Filters>::Component>();
+        }
+      }(),
+      ...);
+  for (const RemovedComponent& removal : entities_->GetRemovedComponents()) {
+    if (removal.type_id != removed_type || removal.tick <= since_ || !entities_->Contains(removal.entity_id)) {
+      continue;
+    }
+    const ComponentSignature& signature = std::as_const(*entities_).At(removal.entity_id).GetSignature();
+    if (Matches(signature) && !signature.Test(removed_type)) {
+      function(removal.entity_id);
+    }
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename IncludedType>
+IncludedType& Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::GetComponent(
+    const EntityID& entity_id) const {
+  static_assert(!is_tag_component<std::remove_const_t<IncludedType>>,
+                "Tag components carry no data; require them with Has<> instead of With<>");
+  if constexpr (std::is_const_v<IncludedType>) {
+    return *std::as_const(*entities_).At(entity_id).template Get<std::remove_const_t<IncludedType>>();
+  } else {
+    return *entities_->At(entity_id).template Get<IncludedType>();
+  }
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function, std::size_t... Indices>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::VisitChunk(const ChunkRef& chunk,
+                                                                                      Function& function,
+                                                                                      std::index_sequence<Indices...>) {
+  static_assert((!is_tag_component<std::remove_const_t<IncludedTypes>> && ...),
+                "Tag components carry no data; require them with Has<> instead of With<>");
+  ArchetypeTable& table = *chunk.table;
+  const std::array<std::size_t, sizeof...(IncludedTypes)> columns{
+      table.FindColumn<std::remove_const_t<IncludedTypes>>()...};
+  std::size_t count = table.ChunkSize(chunk.chunk);
+  std::span<const EntityID> ids{table.Entities().data() + chunk.chunk * table.ChunkCapacity(), count};
+  function(ids, std::span<IncludedTypes>{
+                    static_cast<IncludedTypes*>(table.ColumnData(columns[Indices], chunk.chunk)), count}...);
+}
+
+template <is_query_component... IncludedTypes, is_component... ExcludedTypes, is_query_filter... Filters>
+template <typename Function>
+void Query<With<IncludedTypes...>, Without<ExcludedTypes...>, Filters...>::InvokeEach(
+    Function& function, std::span<const EntityID> ids, std::span<IncludedTypes>... columns) {
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    if constexpr (std::is_invocable_v<Function&, const EntityID&, IncludedTypes&...>) {
+      function(ids[i], columns[i]...);
+    } else {
+      function(columns[i]...);
+    }
+  }
+}
+
+}  // namespace engine::ecs
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ecs/entity-collection.h"
+#include "ecs/system.h"
+#include "jobs/job-system.h"
+namespace engine::ecs {
+
+/**
+ * @brief The longest chain of dependent systems of a frame.
+ */
+struct CriticalPath final {
+  std::vector<std::size_t> systems;   ///< Indices of the systems on the path, in execution order.
+  std::chrono::nanoseconds duration;  ///< Sum of the durations of the systems on the path.
+};
+
+/**
+ * @class Scheduler
+ * @brief Runs systems once per frame, in parallel where their declared accesses allow it.
+ *
+ * The scheduler keeps a dependency graph of its systems. Whenever two systems conflict (see System::ConflictsWith()),
+ * the one registered first runs first, so every frame has the same result as running the systems serially in
+ * registration order. Systems that do not conflict have no ordering between them and may run at the same time.
+ *
+ * The duration of every system is measured each frame, which allows to inspect the critical path of the last frame.
+ *
+ * Every system runs at a change tick of its own (see System::GetLastRunTick()), and records of removed components
+ * are cleared once every system has run past them.
+ */
+class Scheduler final {
+ public:
+  /**
+   * @brief Constructs a scheduler without systems.
+   */
+  Scheduler() = default;
+
+  Scheduler(const Scheduler& other) = delete;
+  Scheduler& operator=(const Scheduler& other) = delete;
+
+  /**
+   * @brief Adds a system after all previously added ones.
+   * @param system The system to add.
+   * @return A reference to the added system.
+   */
+  System& Add(std::unique_ptr<System> system);
+
+  /**
+   * @brief Constructs a system in place and adds it after all previously added ones.
+   * @tparam SystemType The type of the system.
+   * @tparam Args The types of the arguments to construct the system.
+   * @param args The arguments to construct the system.
+   * @return A reference to the added system.
+   */
+  template <typename SystemType, typename... Args>
+  SystemType& Emplace(Args&&... args) {
+    auto system = std::make_unique<SystemType>(std::forward<Args>(args)...);
+    SystemType& reference = *system;
+    Add(std::move(system));
+    return reference;
+  }
+
+  /**
+   * @brief Retrieves the number of systems.
+   * @return The number of systems.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  /**
+   * @brief Retrieves a system by its registration index.
+   * @param index The index of the system, less than Size().
+   * @return A reference to the system.
+   */
+  [[nodiscard]] const System& GetSystem(std::size_t index) const noexcept;
+
+  /**
+   * @brief Retrieves the systems that run after a system because they conflict with it.
+   * @param index The index of the system, less than Size().
+   * @return The indices of the dependent systems, in ascending order.
+   */
+  [[nodiscard]] const std::vector<std::size_t>& GetSuccessors(std::size_t index) const noexcept;
+
+  /**
+   * @brief Runs every system once, serially in registration order.
+   * @param entities The collection to update.
+   */
+  void Run(EntityCollection& entities);
+
+  /**
+   * @brief Runs every system once, running non-conflicting systems at the same time.
+   * @param entities The collection to update.
+   * @param jobs The job system to run on.
+   */
+  void Run(EntityCollection& entities, jobs::JobSystem& jobs);
+
+  /**
+   * @brief Retrieves the duration of a system in the last frame.
+   * @param index The index of the system, less than Size().
+   * @return The measured duration, or zero if no frame has run yet.
+   */
+  [[nodiscard]] std::chrono::nanoseconds GetLastDuration(std::size_t index) const noexcept;
+
+  /**
+   * @brief Computes the critical path of the last frame.
+   *
+   * The critical path is the chain of dependent systems with the largest total duration. It bounds the duration of
+   * a frame no matter how many threads are available.
+   *
+   * @return The critical path, empty if there are no systems.
+   */
+  [[nodiscard]] CriticalPath GetCriticalPath() const;
+
+  /**
+   * @brief Describes the dependency graph in the Graphviz DOT language.
+   *
+   * Nodes are labeled with the names of the systems and their durations in the last frame, and the nodes and edges
+   * of the critical path are highlighted.
+   *
+   * @return The DOT description of the graph.
+   */
+  [[nodiscard]] std::string ToDot() const;
+
+ private:
+  /**
+   * @brief A system and its place in the dependency graph.
+   */
+  struct Node final {
+    std::unique_ptr<System> system;            ///< The system.
+    std::vector<std::size_t> successors;       ///< Systems that must wait for this one.
+    std::size_t predecessor_count{0};          ///< Number of systems this one waits for.
+    std::chrono::nanoseconds last_duration{};  ///< Duration of the system in the last frame.
+    const char* zone_name{nullptr};            ///< Name of the profiling zone of the system.
+  };
+
+  /**
+   * @brief Advances the change tick, then runs a system and measures its duration.
+   * @param node The node of the system.
+   * @param entities The collection to update.
+   */
+  static void RunNode(Node& node, EntityCollection& entities);
+
+  /**
+   * @brief Clears the records of removed components that every system has already seen.
+   * @param entities The collection whose records are cleared.
+   */
+  void ClearRemovedComponents(EntityCollection& entities) const;
+
+  std::vector<Node> nodes_;  ///< Systems in registration order, which is a topological order of the graph.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "memory/pool-allocator.h"
+namespace engine::ecs {
+
+/**
+ * @class SharedComponent
+ * @brief A component that shares a read-only value between entities until one of them writes to it.
+ *
+ * Copying a SharedComponent copies a reference, so thousands of entities instantiated from the same Prefab hold one
+ * stat table or sprite description. Mutate() detaches the calling entity first: when the value is shared, it is
+ * copied and only the copy is changed.
+ *
+ * Different entities may read and mutate their own SharedComponent concurrently. A single SharedComponent must not be
+ * mutated while it is being copied.
+ *
+ * @tparam T The type of the shared value, which must be copy constructible.
+ */
+template <typename T>
+class SharedComponent final {
+ public:
+  /**
+   * @brief Constructs a component that holds a default-constructed value.
+   */
+  SharedComponent() : value_(std::allocate_shared<T>(memory::PoolAllocator<T>{})) {}
+
+  /**
+   * @brief Constructs a component that holds a new value.
+   * @param value The value to share.
+   */
+  explicit SharedComponent(T value) : value_(std::allocate_shared<T>(memory::PoolAllocator<T>{}, std::move(value))) {}
+
+  /**
+   * @brief Copy constructor. Shares the value of the other component.
+   *
+   * No move operations are declared, so moves copy the reference as well and the value is never null.
+   *
+   * @param other The component to share the value of.
+   */
+  SharedComponent(const SharedComponent& other) = default;
+
+  /**
+   * @brief Copy assignment operator. Shares the value of the other component.
+   * @param other The component to share the value of.
+   * @return A reference to this component.
+   */
+  SharedComponent& operator=(const SharedComponent& other) = default;
+
+  /**
+   * @brief Retrieves the shared value.
+   * @return A read-only reference to the value.
+   */
+  [[nodiscard]] const T& Get() const noexcept { return *value_; }
+
+  /**
+   * @brief Retrieves the value for writing, copying it first if other components still share it.
+   * @return A reference to a value owned by this component alone.
+   */
+  [[nodiscard]] T& Mutate() {
+    if (value_.use_count() > 1) {
+      value_ = std::allocate_shared<T>(memory::PoolAllocator<T>{}, std::as_const(*value_));
+    }
+    return *value_;
+  }
+
+  /**
+   * @brief Checks if the value is shared with other components.
+   * @return True if another component references the same value.
+   */
+  [[nodiscard]] bool IsShared() const noexcept { return value_.use_count() > 1; }
+
+ private:
+  std::shared_ptr<T> value_;  ///< The value, never null.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ecs/archetype-table.h"
+#include "ecs/change-tick.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-hierarchy.h"
+#include "ecs/entity-id-allocator.h"
+#include "ecs/entity-id.h"
+#include "ecs/entity.h"
+namespace engine::ecs {
+
+/**
+ * @class SnapshotRing
+ * @brief A ring of saved states of an EntityCollection, for rolling the world back and simulating it again.
+ *
+ * Every slot of the ring keeps a full copy of the world: the chunks of every archetype table, the IDs of the entities
+ * of every row, the ID allocator and the hierarchy. Slots are reused in turn, and saving into a slot copies only the
+ * chunks that changed since the state the slot already holds, found with the change ticks of the chunks. The buffers
+ * of a slot keep their capacity, so a ring that has been filled once saves without allocating while the world does
+ * not grow.
+ *
+ * Restoring a state copies back only the chunks that changed since it was saved, and the IDs and relations of the
+ * entities only if entities were created, destroyed, reshaped or reparented since then. Restored chunks are stamped as
+ * changed at the current tick, so change filters and later saves see them. The change tick of the collection itself
+ * is never rewound, and removals recorded for change detection are not rolled back.
+ *
+ * Only tags and trivially copyable components can be saved. Components must be written through the stamped paths
+ * (queries, entity references, Reshape()) for their chunks to be found dirty.
+ */
+class SnapshotRing final {
+ public:
+  /**
+   * @brief Creates an empty ring.
+   * @param capacity The number of states kept, at least 1.
+   */
+  explicit SnapshotRing(std::size_t capacity);
+
+  /**
+   * @brief Retrieves the maximum number of states kept.
+   * @return The number of slots of the ring.
+   */
+  [[nodiscard]] std::size_t Capacity() const noexcept;
+
+  /**
+   * @brief Retrieves the number of states that can be restored.
+   * @return The number of saved states, at most Capacity().
+   */
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  /**
+   * @brief Forgets every saved state. The buffers of the slots are kept.
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Saves the state of a collection as the newest one, replacing the oldest one if the ring is full.
+   *
+   * Advances the change tick of the collection, so that every later write is told apart from the saved state.
+   *
+   * @param entities The collection to save.
+   * @return The number of chunks that were copied.
+   * @throw std::invalid_argument If a component type of the collection is neither a tag nor trivially copyable.
+   */
+  [[maybe_unused]] std::size_t Save(EntityCollection& entities);
+
+  /**
+   * @brief Brings a collection back to a saved state, which becomes the newest one: the newer states are dropped.
+   * @param entities The collection the state was saved from.
+   * @param age The number of states saved after the one to restore, 0 for the newest one.
+   * @return True if the state was restored, false if there is no such state, it was saved from another collection,
+   * or the collection was reset since.
+   */
+  [[maybe_unused]] bool Restore(EntityCollection& entities, std::size_t age = 0);
+
+ private:
+  /**
+   * @brief The saved rows of a single archetype table.
+   */
+  struct TableState final {
+    ComponentSignature signature;      ///< Component types of the table.
+    std::vector<EntityID> entity_ids;  ///< Owner of every row, in row order.
+    std::vector<std::byte> chunks;     ///< Images of the chunks, laid out like the chunks of the table.
+  };
+
+  /**
+   * @brief A saved state of a collection.
+   */
+  struct State final {
+    const EntityCollection* entities{nullptr};  ///< The saved collection.
+    Tick tick{0};                               ///< Change tick of the collection when the state was saved.
+    EntityIDAllocator ids;                      ///< IDs of the entities.
+    std::vector<Entity> inner_entities;         ///< Location of every entity.
+    EntityHierarchy hierarchy;                  ///< Relations of the entities.
+    std::vector<TableState> tables;             ///< Rows of every table, indexed like the tables of the collection.
+  };
+
+  /**
+   * @brief Checks if a chunk may differ from its copy in a state saved at a given tick.
+   * @param table The table of the chunk.
+   * @param chunk_index The index of the chunk.
+   * @param since The tick of the saved state.
+   * @return True if rows or components of the chunk changed after the tick.
+   */
+  [[nodiscard]] static bool IsChunkDirty(const ArchetypeTable& table, std::size_t chunk_index, Tick since) noexcept;
+
+  std::vector<State> states_;  ///< Slots of the ring.
+  std::size_t newest_{0};      ///< Slot of the newest state.
+  std::size_t size_{0};        ///< Number of saved states.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "ecs/entity-collection.h"
+namespace engine::ecs {
+
+/**
+ * @brief Version of the binary snapshot format. Images of other versions are rejected by Snapshot::Load().
+ */
+inline constexpr std::uint32_t kSnapshotVersion = 1;
+
+/**
+ * @brief How Snapshot::Load() brings the chunks of a snapshot file into the archetype tables.
+ */
+enum class SnapshotLoadMode {
+  kAdopt,  ///< The file is mapped and its chunks are used in place by every table whose layout matches.
+  kCopy,   ///< Every column of every chunk is copied from the mapped file into the arena, then the file is unmapped.
+};
+
+/**
+ * @class Snapshot
+ * @brief Saves a whole EntityCollection into a versioned binary image and loads it back without per-entity parsing.
+ *
+ * An image holds the state of the ID allocator (the generation of every slot and the free list), the parent/child
+ * relations, and every non-empty archetype table: its component types, the IDs of its entities in row order, and its
+ * chunks byte for byte, with every column at the same offset as in memory. Loading creates each table once and appends
+ * all of its rows in one call; the chunks are then either adopted in place from the mapped file, or copied with one
+ * memcpy per column and chunk.
+ *
+ * Component types are matched by their runtime type name, size and alignment, so an image is meant to be loaded by
+ * the same build of the program that saved it, on a machine with the same byte order. Only tags and trivially
+ * copyable components can be saved, and every component type of an image must be registered (for example by calling
+ * ComponentInfo::Of()) before it is loaded. Loaded components are stamped as added at the current change tick.
+ */
+class Snapshot final {
+ public:
+  Snapshot() = delete;
+
+  /**
+   * @brief Saves a collection into a binary image.
+   * @param entities The collection to save.
+   * @return The image.
+   * @throw std::invalid_argument If a component type of the collection is neither a tag nor trivially copyable.
+   */
+  [[nodiscard]] static std::vector<std::byte> Save(const EntityCollection& entities);
+
+  /**
+   * @brief Saves a collection into a binary file.
+   * @param entities The collection to save.
+   * @param path The path of the file, which is overwritten.
+   * @throw std::invalid_argument If a component type of the collection is neither a tag nor trivially copyable.
+   * @throw std::runtime_error If the file cannot be written.
+   */
+  static void Save(const EntityCollection& entities, const std::filesystem::path& path);
+
+  /**
+   * @brief Replaces the content of a collection with the content of a binary image, copying every chunk.
+   *
+   * The image is validated before the collection is touched, so a rejected image leaves the collection unchanged.
+   *
+   * @param entities The collection to fill, reset first.
+   * @param image The image made by Save().
+   * @throw std::invalid_argument If the image is malformed, of another version, or refers to a component type that
+   * is not registered.
+   */
+  static void Load(EntityCollection& entities, std::span<const std::byte> image);
+
+  /**
+   * @brief Replaces the content of a collection with the content of a memory-mapped binary file.
+   *
+   * In SnapshotLoadMode::kAdopt the mapping is kept by the collection until its next Reset(). The mapping is private,
+   * so writes to adopted components never reach the file.
+   *
+   * @param entities The collection to fill, reset first.
+   * @param path The path of the file made by Save().
+   * @param mode Whether the chunks of the file are adopted in place or copied.
+   * @throw std::invalid_argument If the file is malformed, of another version, or refers to a component type that is
+   * not registered.
+   * @throw std::runtime_error If the file cannot be mapped.
+   */
+  static void Load(EntityCollection& entities, const std::filesystem::path& path,
+                   SnapshotLoadMode mode = SnapshotLoadMode::kAdopt);
+
+ private:
+  /**
+   * @brief Replaces the content of a collection with the content of a binary image.
+   * @param entities The collection to fill, reset first.
+   * @param image The image made by Save().
+   * @param storage The owner of the image if its chunks may be adopted in place, otherwise nullptr. The image must
+   * then be writable and aligned to kChunkAlignment.
+   */
+  static void Load(EntityCollection& entities, std::span<const std::byte> image, std::shared_ptr<void> storage);
+};
+
+}  // namespace engine::ecs
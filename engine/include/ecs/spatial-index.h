@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ecs/component-index-sync.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/movement.h"
+#include "ecs/system.h"
+namespace engine::ecs {
+
+/**
+ * @brief An entity found by a nearest-neighbour query of a SpatialIndex.
+ */
+struct SpatialNeighbor final {
+  EntityID entity_id;            ///< ID of the entity.
+  float distance_squared{0.0F};  ///< Squared distance between the entity and the queried point.
+};
+
+/**
+ * @brief Counters of the last update of a SpatialIndex.
+ */
+struct SpatialIndexStatistics final {
+  std::size_t inserted{0};  ///< Entities that gained a Position.
+  std::size_t moved{0};     ///< Entities that crossed into another cell.
+  std::size_t updated{0};   ///< Entities that moved within their cell.
+  std::size_t removed{0};   ///< Entities that were erased or lost their Position.
+};
+
+/**
+ * @class SpatialIndex
+ * @brief A spatial hash of the Position components of an EntityCollection, for proximity queries.
+ *
+ * The plane is divided into square cells, and every cell is hashed into one of a fixed number of buckets. Each
+ * bucket stores the IDs and positions of the entities of its cells contiguously, so queries scan only the buckets of
+ * the cells they overlap and never read the collection.
+ *
+ * Updates are incremental and kept by a ComponentIndexSync: only the positions added or changed since the previous
+ * update are visited, found with the change ticks of the collection. An entity that stays in its cell is updated in
+ * place, and only entities that cross into another cell are moved between buckets.
+ *
+ * Queries write into buffers provided by the caller and never allocate.
+ */
+class SpatialIndex final : public System {
+ public:
+  /**
+   * @brief Constructs an empty index.
+   * @param cell_size The side of a cell, ideally close to the typical query radius. Must be positive.
+   * @param bucket_count The number of buckets the cells are hashed into, rounded up to a power of two.
+   */
+  explicit SpatialIndex(float cell_size, std::size_t bucket_count = 4096);
+
+  /**
+   * @brief Brings the index up to date with the positions of a collection.
+   *
+   * Advances the change tick of the collection, so that every later write of a Position is seen by the next update.
+   * Updating with another collection than the previous one rebuilds the index.
+   *
+   * @param entities The collection to index.
+   */
+  void Update(EntityCollection& entities) override;
+
+  /**
+   * @brief Retrieves the number of indexed entities.
+   * @return The number of indexed entities.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  /**
+   * @brief Retrieves the side of a cell.
+   * @return The side of a cell.
+   */
+  [[nodiscard]] float GetCellSize() const noexcept;
+
+  /**
+   * @brief Retrieves the counters of the last update.
+   * @return The counters, zero if no update has run yet.
+   */
+  [[nodiscard]] const SpatialIndexStatistics& GetLastStatistics() const noexcept;
+
+  /**
+   * @brief Finds the entities within a distance of a point, in no particular order.
+   * @param x The abscissa of the point.
+   * @param y The ordinate of the point.
+   * @param radius The distance; entities exactly at it are included.
+   * @param results The buffer that receives the IDs of the entities.
+   * @return The number of entities found, which may exceed the size of the buffer; only the first results.size()
+   * entities are written.
+   */
+  [[nodiscard]] std::size_t QueryRadius(float x, float y, float radius, std::span<EntityID> results) const noexcept;
+
+  /**
+   * @brief Finds the entities within an axis-aligned box, borders included, in no particular order.
+   * @param min_x The smallest abscissa of the box.
+   * @param min_y The smallest ordinate of the box.
+   * @param max_x The greatest abscissa of the box.
+   * @param max_y The greatest ordinate of the box.
+   * @param results The buffer that receives the IDs of the entities.
+   * @return The number of entities found, which may exceed the size of the buffer; only the first results.size()
+   * entities are written.
+   */
+  [[nodiscard]] std::size_t QueryBox(float min_x, float min_y, float max_x, float max_y,
+                                     std::span<EntityID> results) const noexcept;
+
+  /**
+   * @brief Finds the entities nearest to a point.
+   * @param x The abscissa of the point.
+   * @param y The ordinate of the point.
+   * @param results The buffer that receives the entities, nearest first; its size is the number of entities sought.
+   * @return The number of entities written, less than results.size() only if fewer entities are indexed.
+   */
+  [[nodiscard]] std::size_t QueryNearest(float x, float y, std::span<SpatialNeighbor> results) const noexcept;
+
+ private:
+  /**
+   * @brief An indexed entity, stored in the bucket of its cell.
+   */
+  struct Entry final {
+    EntityID entity_id;          ///< ID of the entity.
+    float x_coord{}, y_coord{};  ///< Indexed position.
+    std::int32_t cell_x{0};      ///< Column of the cell.
+    std::int32_t cell_y{0};      ///< Row of the cell.
+  };
+
+  /**
+   * @brief The location of the entry of an indexed entity.
+   */
+  struct EntryLocation final {
+    std::uint32_t bucket{0};    ///< Bucket that holds the entry.
+    std::uint32_t position{0};  ///< Position of the entry in its bucket.
+  };
+
+  /**
+   * @brief Computes the cell coordinate of a coordinate, clamped to a range that cannot overflow.
+   */
+  [[nodiscard]] std::int32_t CellOf(float coordinate) const noexcept;
+
+  /**
+   * @brief Computes the bucket a cell is hashed into.
+   */
+  [[nodiscard]] std::uint32_t BucketOf(std::int32_t cell_x, std::int32_t cell_y) const noexcept;
+
+  /**
+   * @brief Inserts an entity, or updates it if it is already indexed, and writes the location of its entry.
+   */
+  void Place(const EntityID& entity_id, const Position& position, EntryLocation& location, bool is_indexed);
+
+  /**
+   * @brief Removes the entry of an indexed entity from its bucket.
+   */
+  void Detach(const EntryLocation& location) noexcept;
+
+  /**
+   * @brief Calls a function for every entry whose cell lies in a range of cells, or that may lie in it.
+   *
+   * If the range covers more cells than there are buckets, every entry is visited instead, once.
+   *
+   * @tparam Function A callable invoked as `function(const Entry&)`.
+   */
+  template <typename Function>
+  void ForEachInCells(std::int32_t min_x, std::int32_t min_y, std::int32_t max_x, std::int32_t max_y,
+                      Function&& function) const;
+
+  float cell_size_;                                   ///< Side of a cell.
+  float inverse_cell_size_;                           ///< Reciprocal of the side of a cell.
+  std::vector<std::vector<Entry>> buckets_;           ///< Entries of the cells hashed into every bucket.
+  ComponentIndexSync<Position, EntryLocation> sync_;  ///< Indexed entities and the location of their entries.
+  SpatialIndexStatistics last_statistics_;            ///< Counters of the last update.
+};
+
+}  // namespace engine::ecs
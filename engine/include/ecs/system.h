@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "ecs/change-tick.h"
+#include "ecs/component-base.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+namespace engine::ecs {
+
+/**
+ * @class System
+ * @brief Base class for the per-frame logic of an entity-component-system (ECS).
+ *
+ * A system updates the entities of a collection once per frame. Derived classes declare, usually in their
+ * constructor, which component types they read and which they write. The Scheduler uses these declarations to run
+ * systems that do not conflict on different threads at the same time.
+ *
+ * A system that changes the structure of the collection (inserts or erases entities, emplaces or removes components)
+ * must declare itself exclusive, which makes it conflict with every other system.
+ *
+ * Before running a system, the Scheduler advances the change tick of the collection. A reactive system passes
+ * GetLastRunTick() to its queries to see only the components added, changed or removed since its previous run.
+ */
+class System {
+ public:
+  /**
+   * @brief Constructs a system without declared accesses.
+   * @param name The name of the system, used in diagnostics.
+   */
+  explicit System(std::string_view name);
+
+  /**
+   * @brief Virtual destructor.
+   */
+  virtual ~System() = default;
+
+  System(const System& other) = delete;
+  System& operator=(const System& other) = delete;
+
+  /**
+   * @brief Runs the system for one frame.
+   * @param entities The collection to update.
+   */
+  virtual void Update(EntityCollection& entities) = 0;
+
+  /**
+   * @brief Retrieves the name of the system.
+   * @return The name of the system.
+   */
+  [[nodiscard]] const std::string& GetName() const noexcept;
+
+  /**
+   * @brief Retrieves the component types the system only reads.
+   * @return The signature of the read component types.
+   */
+  [[nodiscard]] const ComponentSignature& GetReads() const noexcept;
+
+  /**
+   * @brief Retrieves the component types the system writes.
+   * @return The signature of the written component types.
+   */
+  [[nodiscard]] const ComponentSignature& GetWrites() const noexcept;
+
+  /**
+   * @brief Checks if the system changes the structure of the collection.
+   * @return True if the system is exclusive, otherwise false.
+   */
+  [[nodiscard]] bool IsExclusive() const noexcept;
+
+  /**
+   * @brief Checks if the system may not run at the same time as another system.
+   *
+   * Two systems conflict if either is exclusive, or if one of them writes a component type the other one reads or
+   * writes.
+   *
+   * @param other The other system.
+   * @return True if the systems conflict, otherwise false.
+   */
+  [[nodiscard]] bool ConflictsWith(const System& other) const noexcept;
+
+  /**
+   * @brief Retrieves the change tick at which the previous run of the system started.
+   *
+   * During Update(), this is the tick of the previous frame's run, so changes stamped with a greater tick were made
+   * after the system last looked at the collection.
+   *
+   * @return The tick of the previous run, or 0 if the system has not run yet.
+   */
+  [[nodiscard]] Tick GetLastRunTick() const noexcept;
+
+ protected:
+  /**
+   * @brief Declares component types the system reads.
+   * @tparam ComponentTypes The read component types.
+   */
+  template <is_component... ComponentTypes>
+  void DeclareReads() noexcept {
+    reads_ = reads_ | ComponentSignatureOf<ComponentTypes...>();
+  }
+
+  /**
+   * @brief Declares component types the system writes.
+   * @tparam ComponentTypes The written component types.
+   */
+  template <is_component... ComponentTypes>
+  void DeclareWrites() noexcept {
+    writes_ = writes_ | ComponentSignatureOf<ComponentTypes...>();
+  }
+
+  /**
+   * @brief Declares that the system changes the structure of the collection.
+   */
+  void DeclareExclusive() noexcept;
+
+ private:
+  std::string name_;           ///< Name of the system.
+  ComponentSignature reads_;   ///< Component types the system reads.
+  ComponentSignature writes_;  ///< Component types the system writes.
+  bool is_exclusive_{false};   ///< Whether the system changes the structure of the collection.
+  Tick last_run_tick_{0};      ///< Change tick at which the previous run started, set by the Scheduler.
+
+  friend class Scheduler;
+};
+
+}  // namespace engine::ecs
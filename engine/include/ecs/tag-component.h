@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <type_traits>
 
 #include "component-base.h"
 
@@ -56,7 +57,7 @@ struct TagComponent : public ComponentBase {
  *
  * This concept checks whether a type `T` satisfies the following conditions:
  * - It must satisfy the `is_component` concept.
- * - It must be derived from `TagComponent`.
+ * - It must be derived from `TagComponent`, or be an empty struct.
  *
  * This is used to ensure that a type can be treated as a tag component in the
  * Entity Component System (ECS).
@@ -64,6 +65,6 @@ struct TagComponent : public ComponentBase {
  * @tparam T The type to be checked against the concept requirements.
  */
 template <typename T>
-concept is_tag_component = is_component<T> && std::derived_from<T, TagComponent>;
+concept is_tag_component = is_component<T> && (std::derived_from<T, TagComponent> || std::is_empty_v<T>);
 
 }  // namespace engine::ecs
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/system.h"
+#include "ecs/transform.h"
+#include "jobs/job-system.h"
+namespace engine::ecs {
+
+/**
+ * @brief Counters of one frame of transform propagation.
+ */
+struct TransformStatistics final {
+  std::size_t recomputed{0};  ///< Entities whose world transform was recomputed.
+  std::size_t skipped{0};     ///< Entities that were visited but left untouched.
+};
+
+/**
+ * @class TransformSystem
+ * @brief Propagates LocalTransform components down the entity hierarchy into Transform components.
+ *
+ * Every frame, the hierarchy is walked in depth order. When an entity with a dirty LocalTransform is found, the world
+ * transforms of the entity and all of its descendants are recomputed from the world transform of its parent, and
+ * their dirty flags are cleared; clean subtrees are left untouched. Entities without both components are skipped,
+ * and their children are placed relative to the world.
+ *
+ * Roots are independent of each other, so with a job system their subtrees are processed in parallel.
+ */
+class TransformSystem final : public System {
+ public:
+  /**
+   * @brief Constructs the system.
+   * @param jobs The job system that processes roots in parallel, or nullptr to process them on the calling thread.
+   * It must outlive the system.
+   */
+  explicit TransformSystem(jobs::JobSystem* jobs = nullptr);
+
+  /**
+   * @brief Recomputes the world transforms of all dirty subtrees.
+   * @param entities The collection to update.
+   */
+  void Update(EntityCollection& entities) override;
+
+  /**
+   * @brief Retrieves the counters of the last frame.
+   * @return The counters, zero if no frame has run yet.
+   */
+  [[nodiscard]] const TransformStatistics& GetLastStatistics() const noexcept;
+
+ private:
+  /**
+   * @brief Number of roots processed by one job.
+   */
+  static constexpr std::size_t kRootsPerJob = 16;
+
+  /**
+   * @brief Walks the subtree of a root, recomputing its dirty subtrees.
+   * @param entities The collection to update.
+   * @param root_id The ID of the root.
+   * @return The counters of the subtree.
+   */
+  static TransformStatistics PropagateFrom(EntityCollection& entities, const EntityID& root_id);
+
+  jobs::JobSystem* jobs_;                ///< Runs the roots in parallel, may be nullptr.
+  std::vector<EntityID> roots_;          ///< Roots of the current frame, kept between frames.
+  TransformStatistics last_statistics_;  ///< Counters of the last frame.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace engine::ecs {
+
+/**
+ * @brief The placement of an entity relative to its parent, or to the world for roots.
+ *
+ * Both transform components are plain trivially copyable structs, so tables copy and relocate them with memcpy.
+ *
+ * The TransformSystem only recomputes the world Transform of entities whose LocalTransform is dirty, together with
+ * their descendants. Code that changes the fields, or moves the entity to another parent, must call MarkDirty().
+ */
+struct LocalTransform final {
+ public:
+  LocalTransform() = default;
+  LocalTransform(float x, float y, float angle = 0.0F, float factor = 1.0F)
+      : x_coord(x), y_coord(y), rotation(angle), scale(factor) {}
+
+  /**
+   * @brief Requests the recomputation of the world transforms of the entity and its descendants.
+   */
+  void MarkDirty() noexcept { is_dirty = true; }
+
+  float x_coord{}, y_coord{};  ///< Translation, in the space of the parent.
+  float rotation{};            ///< Counter-clockwise rotation in radians.
+  float scale{1.0F};           ///< Uniform scale.
+  bool is_dirty{true};         ///< Whether the world transform is out of date. Cleared by the TransformSystem.
+};
+
+/**
+ * @brief The placement of an entity in the world, computed by the TransformSystem from LocalTransform components.
+ */
+struct Transform final {
+ public:
+  Transform() = default;
+  Transform(float x, float y, float angle = 0.0F, float factor = 1.0F)
+      : x_coord(x), y_coord(y), rotation(angle), scale(factor) {}
+
+  float x_coord{}, y_coord{};  ///< Translation in the world.
+  float rotation{};            ///< Counter-clockwise rotation in radians.
+  float scale{1.0F};           ///< Uniform scale.
+};
+
+}  // namespace engine::ecs
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ecs/component-base.h"
+#include "ecs/component-index-sync.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/system.h"
+namespace engine::ecs {
+
+/**
+ * @brief The kind of lookups a ValueIndex answers.
+ */
+enum class IndexKind : std::uint8_t {
+  kHashed,   ///< Equality lookups in constant time, keys must be hashable.
+  kOrdered,  ///< Equality and range lookups in logarithmic time, keys must be ordered.
+};
+
+/**
+ * @brief Counters of the last update of a ValueIndex.
+ */
+struct ValueIndexStatistics final {
+  std::size_t inserted{0};   ///< Entities that gained the component.
+  std::size_t rekeyed{0};    ///< Entities whose key changed.
+  std::size_t unchanged{0};  ///< Entities whose component was written but whose key stayed the same.
+  std::size_t removed{0};    ///< Entities that were erased or lost the component.
+};
+
+/**
+ * @brief Traits of the indexed field of a ValueIndex, a pointer to a data member of a component.
+ */
+template <auto Field>
+struct IndexedFieldTraits;
+
+template <is_component Component, typename Key, Key Component::*Field>
+struct IndexedFieldTraits<Field> final {
+  using ComponentType = Component;
+  using KeyType = Key;
+};
+
+/**
+ * @class ValueIndex
+ * @brief A secondary index of the entities of an EntityCollection by the value of one field of a component, for
+ * lookups that would otherwise filter every entity with a predicate.
+ *
+ * The entities of every distinct key are stored contiguously, in a hash map for a hashed index or in a sorted map for
+ * an ordered one, and lookups never read the collection. Indexes are opt-in: declare one per looked-up field, such as
+ * `HashIndex<&NetworkID::value>` or `OrderedIndex<&Faction::rank>`.
+ *
+ * Updates are incremental and kept by a ComponentIndexSync, as for the SpatialIndex: an update visits only the
+ * components added or written since the previous update, and moves an entity between keys only if its key changed.
+ * Lookups reflect the collection as of the last update, so an index is usually run by the Scheduler before the
+ * systems that read it.
+ *
+ * @tparam Field A pointer to the indexed data member of a component, whose type is the key.
+ * @tparam Kind The kind of lookups answered.
+ */
+template <auto Field, IndexKind Kind>
+class ValueIndex final : public System {
+ public:
+  using ComponentType = typename IndexedFieldTraits<Field>::ComponentType;
+  using KeyType = typename IndexedFieldTraits<Field>::KeyType;
+
+  static_assert(std::copyable<KeyType> && std::default_initializable<KeyType>, "Keys must be copyable values");
+  static_assert(Kind != IndexKind::kHashed ||
+                    (std::equality_comparable<KeyType> && std::is_default_constructible_v<std::hash<KeyType>>),
+                "Keys of a hashed index must be hashable");
+  static_assert(Kind != IndexKind::kOrdered || std::totally_ordered<KeyType>,
+                "Keys of an ordered index must be ordered");
+
+  /**
+   * @brief Constructs an empty index.
+   */
+  ValueIndex() : System("ValueIndex") { DeclareReads<ComponentType>(); }
+
+  /**
+   * @brief Brings the index up to date with the components of a collection.
+   *
+   * Advances the change tick of the collection, so that every later write of the component is seen by the next
+   * update. Updating with another collection than the previous one rebuilds the index.
+   *
+   * @param entities The collection to index.
+   */
+  void Update(EntityCollection& entities) override;
+
+  /**
+   * @brief Retrieves the number of indexed entities.
+   * @return The number of indexed entities.
+   */
+  [[nodiscard]] std::size_t Size() const noexcept { return sync_.Size(); }
+
+  /**
+   * @brief Retrieves the number of distinct indexed keys.
+   * @return The number of distinct keys.
+   */
+  [[nodiscard]] std::size_t KeyCount() const noexcept { return groups_.size(); }
+
+  /**
+   * @brief Retrieves the counters of the last update.
+   * @return The counters, zero if no update has run yet.
+   */
+  [[nodiscard]] const ValueIndexStatistics& GetLastStatistics() const noexcept { return last_statistics_; }
+
+  /**
+   * @brief Finds the entities whose key equals a value, in no particular order.
+   * @param key The value looked up.
+   * @return The IDs of the entities, valid until the next update.
+   */
+  [[nodiscard]] std::span<const EntityID> Find(const KeyType& key) const;
+
+  /**
+   * @brief Calls a function for every entity whose key lies within a range, bounds included, by ascending key.
+   * @tparam Function A callable invoked as `function(const EntityID&, const KeyType&)`.
+   * @param min The smallest key of the range.
+   * @param max The greatest key of the range.
+   * @param function The function to call.
+   */
+  template <typename Function>
+    requires(Kind == IndexKind::kOrdered)
+  void ForEachInRange(const KeyType& min, const KeyType& max, Function&& function) const;
+
+  /**
+   * @brief Counts the entities whose key lies within a range, bounds included.
+   * @param min The smallest key of the range.
+   * @param max The greatest key of the range.
+   * @return The number of entities, found in time proportional to the number of distinct keys in the range.
+   */
+  [[nodiscard]] std::size_t CountInRange(const KeyType& min, const KeyType& max) const
+    requires(Kind == IndexKind::kOrdered);
+
+ private:
+  using GroupMap = std::conditional_t<Kind == IndexKind::kHashed, std::unordered_map<KeyType, std::vector<EntityID>>,
+                                      std::map<KeyType, std::vector<EntityID>>>;
+
+  /**
+   * @brief The key of an indexed entity and its position in the group of the key.
+   */
+  struct KeyLocation final {
+    KeyType key{};              ///< Indexed key.
+    std::uint32_t position{0};  ///< Position of the entity in the group of its key.
+  };
+
+  /**
+   * @brief Inserts an entity, or updates its key if it is already indexed, and writes its location.
+   */
+  void Place(const EntityID& entity_id, const KeyType& key, KeyLocation& location, bool is_indexed);
+
+  /**
+   * @brief Removes an indexed entity from the group of its key.
+   */
+  void Detach(const KeyLocation& location);
+
+  GroupMap groups_;                                      ///< Entities of every distinct key.
+  ComponentIndexSync<ComponentType, KeyLocation> sync_;  ///< Indexed entities and their keys.
+  ValueIndexStatistics last_statistics_;                 ///< Counters of the last update.
+};
+
+/**
+ * @typedef HashIndex
+ * @brief An index for equality lookups on a field of a component.
+ */
+template <auto Field>
+using HashIndex = ValueIndex<Field, IndexKind::kHashed>;
+
+/**
+ * @typedef OrderedIndex
+ * @brief An index for equality and range lookups on a field of a component.
+ */
+template <auto Field>
+using OrderedIndex = ValueIndex<Field, IndexKind::kOrdered>;
+
+template <auto Field, IndexKind Kind>
+void ValueIndex<Field, Kind>::Update(EntityCollection& entities) {
+  last_statistics_ = ValueIndexStatistics{};
+  sync_.Update(
+      entities, [this] { groups_.clear(); },
+      [this](const EntityID& entity_id, const ComponentType& component, KeyLocation& location, bool is_indexed) {
+        Place(entity_id, component.*Field, location, is_indexed);
+      },
+      [this](const KeyLocation& location) {
+        Detach(location);
+        ++last_statistics_.removed;
+      });
+}
+
+template <auto Field, IndexKind Kind>
+std::span<const EntityID> ValueIndex<Field, Kind>::Find(const KeyType& key) const {
+  auto found = groups_.find(key);
+  if (found == groups_.end()) {
+    return {};
+  }
+  return found->second;
+}
+
+template <auto Field, IndexKind Kind>
+template <typename Function>
+  requires(Kind == IndexKind::kOrdered)
+void ValueIndex<Field, Kind>::ForEachInRange(const KeyType& min, const KeyType& max, Function&& function) const {
+  if (max < min) {
+    return;
+  }
+  for (auto group = groups_.lower_bound(min); group != groups_.end() && !(max < group->first); ++group) {
+    for (const EntityID& entity_id : group->second) {
+      function(entity_id, group->first);
+    }
+  }
+}
+
+template <auto Field, IndexKind Kind>
+std::size_t ValueIndex<Field, Kind>::CountInRange(const KeyType& min, const KeyType& max) const
+  requires(Kind == IndexKind::kOrdered)
+{
+  if (max < min) {
+    return 0;
+  }
+  std::size_t count = 0;
+  for (auto group = groups_.lower_bound(min); group != groups_.end() && !(max < group->first); ++group) {
+    count += group->second.size();
+  }
+  return count;
+}
+
+template <auto Field, IndexKind Kind>
+void ValueIndex<Field, Kind>::Place(const EntityID& entity_id, const KeyType& key, KeyLocation& location,
+                                    bool is_indexed) {
+  if (is_indexed) {
+    if (location.key == key) {
+      ++last_statistics_.unchanged;
+      return;
+    }
+    Detach(location);
+    ++last_statistics_.rekeyed;
+  } else {
+    ++last_statistics_.inserted;
+  }
+
+  std::vector<EntityID>& group = groups_[key];
+  location.key = key;
+  location.position = static_cast<std::uint32_t>(group.size());
+  group.push_back(entity_id);
+}
+
+template <auto Field, IndexKind Kind>
+void ValueIndex<Field, Kind>::Detach(const KeyLocation& location) {
+  auto found = groups_.find(location.key);
+  std::vector<EntityID>& group = found->second;
+  // The last entity of the group takes the place of the removed one.
+  std::uint32_t position = location.position;
+  group[position] = group.back();
+  sync_.LocationOf(group[position]).position = position;
+  group.pop_back();
+  if (group.empty()) {
+    groups_.erase(found);
+  }
+}
+
+}  // namespace engine::ecs
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+namespace engine::jobs {
+
+/**
+ * @typedef Job
+ * @brief A unit of work executed by a JobSystem.
+ */
+using Job = std::function<void()>;
+
+/**
+ * @class JobCounter
+ * @brief Tracks the number of unfinished jobs of a group, so that a thread can wait for the whole group.
+ */
+class JobCounter final {
+ public:
+  /**
+   * @brief Constructs a counter with no pending jobs.
+   */
+  JobCounter() noexcept = default;
+
+  JobCounter(const JobCounter& other) = delete;
+  JobCounter& operator=(const JobCounter& other) = delete;
+
+  /**
+   * @brief Checks if every job of the group has finished.
+   * @return True if no job is pending, otherwise false.
+   */
+  [[nodiscard]] bool IsDone() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+ private:
+  friend class JobSystem;
+
+  std::atomic<std::size_t> pending_{0};  ///< Number of scheduled jobs that have not finished yet.
+};
+
+/**
+ * @class JobSystem
+ * @brief A pool of worker threads that balance jobs by work stealing.
+ *
+ * Every worker owns a deque of jobs. A worker pushes and pops jobs at the back of its own deque, so recently spawned
+ * (cache-warm) work runs first, and steals from the front of the other deques when its own one is empty. Jobs
+ * scheduled from threads that are not workers of the system go to a shared queue that every worker steals from.
+ *
+ * A thread waiting for a JobCounter keeps executing jobs until the counter drops to zero, so jobs may schedule and
+ * wait for nested jobs without blocking a worker. Jobs must not throw exceptions.
+ */
+class JobSystem final {
+ public:
+  /**
+   * @brief Starts a job system.
+   * @param worker_count The number of worker threads. The thread that waits for jobs also executes them, so zero
+   * workers is valid and runs every job on the waiting thread.
+   */
+  explicit JobSystem(std::size_t worker_count = DefaultWorkerCount());
+
+  /**
+   * @brief Finishes all scheduled jobs and joins the worker threads.
+   */
+  ~JobSystem();
+
+  JobSystem(const JobSystem& other) = delete;
+  JobSystem& operator=(const JobSystem& other) = delete;
+
+  /**
+   * @brief Retrieves the number of worker threads matching the hardware, leaving one core to the calling thread.
+   * @return The default number of worker threads.
+   */
+  [[nodiscard]] static std::size_t DefaultWorkerCount() noexcept;
+
+  /**
+   * @brief Retrieves the number of worker threads.
+   * @return The number of worker threads.
+   */
+  [[nodiscard]] std::size_t WorkerCount() const noexcept;
+
+  /**
+   * @brief Schedules a job as part of a group.
+   * @param counter The counter of the group, which must outlive the job.
+   * @param job The job to execute.
+   */
+  void Schedule(JobCounter& counter, Job job);
+
+  /**
+   * @brief Executes jobs until every job of a group has finished.
+   * @param counter The counter of the group.
+   */
+  void Wait(const JobCounter& counter);
+
+  /**
+   * @brief Calls a function over the range `[0, count)` split into consecutive subranges of `grain_size` elements.
+   *
+   * The subranges are executed in parallel; the call returns once all of them have finished.
+   *
+   * @tparam Function A callable invoked as `function(std::size_t begin, std::size_t end)`.
+   * @param count The number of elements in the range.
+   * @param grain_size The number of elements of every subrange, except for the last one.
+   * @param function The callable to invoke, which must be safe to call concurrently on disjoint subranges.
+   */
+  template <typename Function>
+  void ParallelFor(std::size_t count, std::size_t grain_size, Function&& function);
+
+  /**
+   * @brief Reduces the range `[0, count)` in parallel.
+   *
+   * The range is split into consecutive subranges of `grain_size` elements, every subrange is mapped to a partial
+   * result in parallel, and the partial results are combined on the calling thread in the order of the subranges.
+   * The split depends on `count` and `grain_size` only, so the result is bit-identical for any number of workers and
+   * any scheduling, including for non-associative operations such as floating-point addition.
+   *
+   * @tparam T The type of the result.
+   * @tparam Map A callable invoked as `map(std::size_t begin, std::size_t end)`, returning a `T`.
+   * @tparam Combine A callable invoked as `combine(T accumulated, T partial)`, returning a `T`.
+   * @param count The number of elements in the range.
+   * @param grain_size The number of elements of every subrange, except for the last one.
+   * @param identity The initial value of the reduction.
+   * @param map The callable that reduces a subrange.
+   * @param combine The callable that combines two results.
+   * @return The combined result.
+   */
+  template <typename T, typename Map, typename Combine>
+  [[nodiscard]] T ParallelReduce(std::size_t count, std::size_t grain_size, T identity, Map&& map, Combine&& combine);
+
+ private:
+  /**
+   * @brief A deque of jobs owned by a worker, or shared by external threads.
+   */
+  struct Queue final {
+    std::mutex mutex;      ///< Protects the jobs.
+    std::deque<Job> jobs;  ///< Jobs waiting for execution.
+  };
+
+  /**
+   * @brief Runs the loop of a worker thread.
+   * @param queue_index The index of the queue owned by the worker.
+   */
+  void RunWorker(std::size_t queue_index);
+
+  /**
+   * @brief Executes one job from the own queue of the calling thread, or stolen from another queue.
+   * @param queue_index The index of the queue of the calling thread.
+   * @return True if a job was executed, otherwise false.
+   */
+  bool TryRunOne(std::size_t queue_index);
+
+  /**
+   * @brief Retrieves the queue the calling thread pushes to.
+   * @return The index of the queue of the calling worker, or of the shared queue for external threads.
+   */
+  [[nodiscard]] std::size_t CurrentQueueIndex() const noexcept;
+
+  std::vector<std::unique_ptr<Queue>> queues_;  ///< The shared queue, followed by one queue per worker.
+  std::vector<std::thread> workers_;            ///< Worker threads.
+  std::atomic<std::size_t> queued_{0};          ///< Number of jobs waiting in all queues.
+  std::atomic<bool> is_stopping_{false};        ///< Set when the system shuts down.
+  std::mutex sleep_mutex_;                      ///< Protects sleeping of idle workers.
+  std::condition_variable wake_up_;             ///< Wakes idle workers when jobs are scheduled.
+};
+
+template <typename Function>
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain_size, Function&& function) {
+  grain_size = std::max<std::size_t>(grain_size, 1);
+  std::size_t range_count = (count + grain_size - 1) / grain_size;
+  if (range_count <= 1) {
+    if (count > 0) {
+      function(std::size_t{0}, count);
+    }
+    return;
+  }
+
+  JobCounter counter;
+  for (std::size_t range = 1; range < range_count; ++range) {
+    Schedule(counter, [&function, range, grain_size, count] {
+      function(range * grain_size, std::min(count, (range + 1) * grain_size));
+    });
+  }
+  function(std::size_t{0}, grain_size);
+  Wait(counter);
+}
+
+template <typename T, typename Map, typename Combine>
+T JobSystem::ParallelReduce(std::size_t count, std::size_t grain_size, T identity, Map&& map, Combine&& combine) {
+  grain_size = std::max<std::size_t>(grain_size, 1);
+  std::size_t range_count = (count + grain_size - 1) / grain_size;
+  std::vector<T> partials(range_count, identity);
+  ParallelFor(range_count, 1, [&](std::size_t first_range, std::size_t last_range) {
+    for (std::size_t range = first_range; range < last_range; ++range) {
+      partials[range] = map(range * grain_size, std::min(count, (range + 1) * grain_size));
+    }
+  });
+
+  T result = std::move(identity);
+  for (T& partial : partials) {
+    result = combine(std::move(result), std::move(partial));
+  }
+  return result;
+}
+
+}  // namespace engine::jobs
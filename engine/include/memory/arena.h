@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+
+#include "memory/pool-allocator.h"
+namespace engine::memory {
+
+/**
+ * @class Arena
+ * @brief A linear allocator whose memory is released all at once.
+ *
+ * Allocations bump a pointer inside large blocks requested from the global `operator new`. Individual allocations
+ * are never freed; Reset() rewinds the arena in one step and keeps its blocks, so refilling it up to the previous
+ * high-water mark makes no upstream allocation. Release() returns the blocks to the system.
+ *
+ * The arena does not run destructors and is not thread-safe.
+ */
+class Arena final {
+ public:
+  /**
+   * @brief Default size of a block in bytes.
+   */
+  static constexpr std::size_t kDefaultBlockSize = 1024 * 1024;
+
+  /**
+   * @brief Constructs an arena without blocks.
+   * @param block_size The size of the blocks requested from the system. Larger allocations get a block of their own.
+   */
+  explicit Arena(std::size_t block_size = kDefaultBlockSize) noexcept;
+
+  /**
+   * @brief Returns every block to the system.
+   */
+  ~Arena();
+
+  Arena(const Arena& other) = delete;
+  Arena& operator=(const Arena& other) = delete;
+
+  /**
+   * @brief Allocates uninitialized memory.
+   * @param size The number of bytes to allocate.
+   * @param alignment The required alignment, a power of two.
+   * @return A pointer to the allocated memory, valid until the next Reset() or Release().
+   */
+  [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment);
+
+  /**
+   * @brief Invalidates every allocation at once, keeping the blocks for reuse.
+   */
+  void Reset() noexcept;
+
+  /**
+   * @brief Invalidates every allocation at once and returns the blocks to the system.
+   */
+  void Release() noexcept;
+
+  /**
+   * @brief Retrieves the number of bytes handed out since the last Reset() or Release(), padding included.
+   * @return The number of used bytes.
+   */
+  [[nodiscard]] std::size_t BytesUsed() const noexcept;
+
+  /**
+   * @brief Retrieves the number of bytes of all blocks owned by the arena.
+   * @return The number of reserved bytes.
+   */
+  [[nodiscard]] std::size_t BytesReserved() const noexcept;
+
+  /**
+   * @brief Retrieves the counters of the arena.
+   * @return A snapshot of the counters.
+   */
+  [[nodiscard]] PoolStatistics Statistics() const noexcept;
+
+ private:
+  /**
+   * @brief Header of a block, stored at its beginning.
+   */
+  struct Block final {
+    Block* next;       ///< Next block in the list.
+    std::size_t size;  ///< Size of the block in bytes, header included.
+  };
+
+  /**
+   * @brief Makes the next block of the list current, or requests a new one that fits a request.
+   * @param size The number of bytes of the request.
+   * @param alignment The alignment of the request.
+   */
+  void Advance(std::size_t size, std::size_t alignment);
+
+  std::size_t block_size_;     ///< Size of regular blocks in bytes.
+  Block* first_{nullptr};      ///< First block of the list.
+  Block* current_{nullptr};    ///< Block that serves allocations.
+  std::size_t offset_{0};      ///< Offset of the first free byte in the current block.
+  std::size_t bytes_used_{0};  ///< Bytes handed out since the last rewind.
+  PoolStatistics statistics_;  ///< Counters of the arena.
+};
+
+}  // namespace engine::memory
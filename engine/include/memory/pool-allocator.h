@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+namespace engine::memory {
+
+/**
+ * @brief Counters of an allocator.
+ *
+ * Upstream allocations are the calls an allocator makes to the global `operator new`. In a steady state, where
+ * memory is only recycled, they stay constant.
+ */
+struct PoolStatistics final {
+  std::size_t allocations{0};           ///< Number of blocks handed out.
+  std::size_t deallocations{0};         ///< Number of blocks given back.
+  std::size_t upstream_allocations{0};  ///< Number of calls to the global operator new.
+  std::size_t upstream_bytes{0};        ///< Number of bytes requested from the global operator new.
+};
+
+/**
+ * @class SizeClassPool
+ * @brief A thread-safe pool of fixed-size memory blocks.
+ *
+ * Blocks are carved out of large slabs requested from the global `operator new` and recycled through an intrusive
+ * free list. Slabs are only returned to the system when the pool is destroyed.
+ */
+class SizeClassPool final {
+ public:
+  /**
+   * @brief Alignment of every block.
+   */
+  static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+  /**
+   * @brief Size of a slab in bytes.
+   */
+  static constexpr std::size_t kSlabSize = 64 * 1024;
+
+  /**
+   * @brief Constructs an empty pool.
+   * @param block_size The size of every block, a multiple of kBlockAlignment.
+   */
+  explicit SizeClassPool(std::size_t block_size) noexcept;
+
+  /**
+   * @brief Returns every slab to the system.
+   */
+  ~SizeClassPool();
+
+  SizeClassPool(const SizeClassPool& other) = delete;
+  SizeClassPool& operator=(const SizeClassPool& other) = delete;
+
+  /**
+   * @brief Retrieves a free block.
+   * @return A pointer to a block of BlockSize() bytes.
+   */
+  [[nodiscard]] void* Allocate();
+
+  /**
+   * @brief Gives a block back to the pool.
+   * @param block A block obtained from Allocate() of the same pool.
+   */
+  void Deallocate(void* block) noexcept;
+
+  /**
+   * @brief Retrieves the size of the blocks of the pool.
+   * @return The size of a block in bytes.
+   */
+  [[nodiscard]] std::size_t BlockSize() const noexcept;
+
+  /**
+   * @brief Retrieves the counters of the pool.
+   * @return A snapshot of the counters.
+   */
+  [[nodiscard]] PoolStatistics Statistics() const noexcept;
+
+ private:
+  /**
+   * @brief Header of a free block, stored inside the block itself.
+   */
+  struct FreeBlock final {
+    FreeBlock* next;  ///< Next free block.
+  };
+
+  /**
+   * @brief Header of a slab, stored at its beginning.
+   */
+  struct alignas(kBlockAlignment) Slab final {
+    Slab* next;  ///< Previously allocated slab.
+  };
+
+  /**
+   * @brief Requests a new slab and threads its blocks onto the free list. The mutex must be held.
+   */
+  void Grow();
+
+  std::size_t block_size_;         ///< Size of every block in bytes.
+  mutable std::mutex mutex_;       ///< Protects the free list and the slabs.
+  FreeBlock* free_list_{nullptr};  ///< First free block.
+  Slab* slabs_{nullptr};           ///< Last allocated slab.
+  PoolStatistics statistics_;      ///< Counters, protected by the mutex.
+};
+
+/**
+ * @brief Allocates memory from the size-class pool that fits a request.
+ *
+ * Requests larger than the largest size class, or with an alignment stricter than SizeClassPool::kBlockAlignment,
+ * are forwarded to the global `operator new` and counted as upstream allocations.
+ *
+ * @param size The number of bytes to allocate.
+ * @param alignment The required alignment.
+ * @return A pointer to the allocated memory.
+ */
+[[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment);
+
+/**
+ * @brief Gives memory obtained from Allocate() back.
+ * @param memory The memory to give back.
+ * @param size The size passed to Allocate().
+ * @param alignment The alignment passed to Allocate().
+ */
+void Deallocate(void* memory, std::size_t size, std::size_t alignment) noexcept;
+
+/**
+ * @brief Retrieves the counters of all size-class pools, including oversized requests.
+ * @return A snapshot of the summed counters.
+ */
+[[nodiscard]] PoolStatistics GetPoolStatistics() noexcept;
+
+/**
+ * @class PoolAllocator
+ * @brief A standard allocator that draws memory from the size-class pools.
+ *
+ * Every type is served by the pool of its size class, so types of similar sizes share their slabs. The allocator is
+ * stateless: all instances compare equal, and memory may be released through any of them.
+ *
+ * @tparam T The type of the allocated objects.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  /**
+   * @brief Constructs an allocator.
+   */
+  constexpr PoolAllocator() noexcept = default;
+
+  /**
+   * @brief Constructs an allocator from an allocator of another type.
+   * @tparam U The type of the other allocator.
+   */
+  template <typename U>
+  constexpr PoolAllocator(const PoolAllocator<U>& /*other*/) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  /**
+   * @brief Allocates uninitialized storage for objects.
+   * @param count The number of objects.
+   * @return A pointer to the storage.
+   */
+  [[nodiscard]] T* allocate(std::size_t count) {  // NOLINT(readability-identifier-naming)
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Gives storage obtained from allocate() back.
+   * @param memory The storage.
+   * @param count The number of objects passed to allocate().
+   */
+  void deallocate(T* memory, std::size_t count) noexcept {  // NOLINT(readability-identifier-naming)
+    Deallocate(memory, count * sizeof(T), alignof(T));
+  }
+
+  /**
+   * @brief Compares two allocators, which are always interchangeable.
+   * @return Always true.
+   */
+  template <typename U>
+  [[nodiscard]] constexpr bool operator==(const PoolAllocator<U>& /*other*/) const noexcept {
+    return true;
+  }
+};
+
+}  // namespace engine::memory
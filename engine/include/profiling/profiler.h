@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+namespace engine::profiling {
+
+/**
+ * @brief Timing statistics of one zone over the events kept by the Profiler.
+ */
+struct ZoneSummary final {
+  std::string name;                 ///< Name of the zone.
+  std::size_t count{0};             ///< Number of recorded runs of the zone.
+  std::chrono::nanoseconds p50{0};  ///< Median duration.
+  std::chrono::nanoseconds p99{0};  ///< 99th percentile of the durations.
+  std::chrono::nanoseconds max{0};  ///< Longest duration.
+};
+
+/**
+ * @class Profiler
+ * @brief Records timed zones of the engine and exports them for inspection.
+ *
+ * Every thread that records a zone gets a ring buffer of its own, allocated on its first zone and kept for the rest
+ * of the process, so recording takes no lock: the thread writes the event into the next slot and publishes it with a
+ * single atomic store. Each ring keeps the last kThreadCapacity events of its thread, which the summary and the
+ * Chrome trace are computed from; readers never block the recording threads, and skip the events that were
+ * overwritten while they were being read.
+ *
+ * Recording is disabled at startup. When disabled, a zone costs a single relaxed atomic load; with the
+ * `ENGINE_PROFILING` build option turned off, ENGINE_PROFILE_ZONE() compiles to nothing.
+ *
+ * Zone names are not copied: they must live until the events are exported, which string literals and names returned
+ * by Intern() do.
+ */
+class Profiler final {
+ public:
+  Profiler() = delete;
+
+  /**
+   * @brief Number of events kept per thread.
+   */
+  static constexpr std::size_t kThreadCapacity = std::size_t{1} << 15U;
+
+  /**
+   * @brief Turns recording on or off for every thread.
+   * @param is_enabled Whether zones are recorded.
+   */
+  static void SetEnabled(bool is_enabled) noexcept { is_enabled_.store(is_enabled, std::memory_order_relaxed); }
+
+  /**
+   * @brief Checks if zones are recorded.
+   * @return True if recording is on, otherwise false.
+   */
+  [[nodiscard]] static bool IsEnabled() noexcept { return is_enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Retrieves the time events are stamped with.
+   * @return The number of nanoseconds on a monotonic clock.
+   */
+  [[nodiscard]] static std::uint64_t Now() noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  /**
+   * @brief Stores a copy of a name for the lifetime of the process, for zones named at run time.
+   * @param name The name to keep.
+   * @return A pointer to the kept name, the same one for equal names.
+   */
+  [[nodiscard]] static const char* Intern(std::string_view name);
+
+  /**
+   * @brief Records a finished zone in the ring of the calling thread, even if recording is disabled.
+   * @param name The name of the zone, which must outlive the recorded events.
+   * @param start The time at which the zone was entered, from Now().
+   * @param end The time at which the zone was left, from Now().
+   */
+  static void Record(const char* name, std::uint64_t start, std::uint64_t end) noexcept;
+
+  /**
+   * @brief Forgets every recorded event. Rings are kept.
+   */
+  static void Clear() noexcept;
+
+  /**
+   * @brief Computes the timing statistics of every zone from the kept events.
+   * @return The statistics of the zones, sorted by name.
+   */
+  [[nodiscard]] static std::vector<ZoneSummary> Summarize();
+
+  /**
+   * @brief Writes the kept events as a Chrome `trace_event` JSON document, for `chrome://tracing` or Perfetto.
+   * @param output The stream to write to.
+   */
+  static void WriteChromeTrace(std::ostream& output);
+
+  /**
+   * @brief Writes the kept events as a Chrome `trace_event` JSON file.
+   * @param path The path of the file, which is overwritten.
+   * @throw std::runtime_error If the file cannot be written.
+   */
+  static void WriteChromeTrace(const std::filesystem::path& path);
+
+ private:
+  static inline std::atomic<bool> is_enabled_{false};  ///< Whether zones are recorded.
+};
+
+/**
+ * @class ProfileZone
+ * @brief Records the time between its construction and its destruction as a zone, if recording is enabled.
+ */
+class ProfileZone final {
+ public:
+  /**
+   * @brief Enters the zone.
+   * @param name The name of the zone, which must outlive the recorded events.
+   */
+  explicit ProfileZone(const char* name) noexcept
+      : name_(Profiler::IsEnabled() ? name : nullptr), start_(name_ != nullptr ? Profiler::Now() : 0) {}
+
+  /**
+   * @brief Leaves the zone and records it.
+   */
+  ~ProfileZone() {
+    if (name_ != nullptr) {
+      Profiler::Record(name_, start_, Profiler::Now());
+    }
+  }
+
+  ProfileZone(const ProfileZone& other) = delete;
+  ProfileZone& operator=(const ProfileZone& other) = delete;
+
+ private:
+  const char* name_;     ///< Name of the zone, nullptr if recording was disabled on entry.
+  std::uint64_t start_;  ///< Time at which the zone was entered.
+};
+
+}  // namespace engine::profiling
+
+#define ENGINE_PROFILE_CONCAT_INNER(first, second) first##second
+#define ENGINE_PROFILE_CONCAT(first, second) ENGINE_PROFILE_CONCAT_INNER(first, second)
+
+/**
+ * @brief Records the rest of the enclosing scope as a zone of the Profiler.
+ * @param name The name of the zone, a string literal or a name returned by Profiler::Intern().
+ */
+#ifdef ENGINE_PROFILING
+#define ENGINE_PROFILE_ZONE(name) \
+  const ::engine::profiling::ProfileZone ENGINE_PROFILE_CONCAT(engine_profile_zone_, __LINE__)(name)
+#else
+#define ENGINE_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
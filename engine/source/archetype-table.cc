@@ -0,0 +1,438 @@
+#include "ecs/archetype-table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+using engine::ecs::ArchetypeLayout;
+using engine::ecs::ArchetypeTable;
+
+#include "ecs/change-tick.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+using engine::ecs::ComponentInfo;
+using engine::ecs::ComponentSignature;
+using engine::ecs::ComponentTicks;
+using engine::ecs::ComponentTypeID;
+using engine::ecs::Tick;
+
+#include "ecs/entity-id.h"
+using engine::ecs::EntityID;
+
+#include "memory/arena.h"
+using engine::memory::Arena;
+
+namespace {
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Moves a component to uninitialized memory and ends the lifetime of the source.
+void Relocate(const ComponentInfo& info, void* destination, void* source) {
+  if (info.is_trivial) {
+    std::memcpy(destination, source, info.size);
+    return;
+  }
+  info.move_construct(destination, source);
+  info.destroy(source);
+}
+
+// Raises a tick to at least a value. Jobs that write disjoint rows of one chunk may raise its ticks concurrently.
+void RaiseAtomically(Tick& target, Tick tick) noexcept {
+  std::atomic_ref<Tick> atomic_target(target);
+  Tick current = atomic_target.load(std::memory_order_relaxed);
+  while (current < tick && !atomic_target.compare_exchange_weak(current, tick, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+ArchetypeLayout engine::ecs::MakeArchetypeLayout(const ComponentSignature& signature) {
+  ArchetypeLayout layout;
+  layout.reserve(signature.Count());
+  signature.ForEach([&layout](ComponentTypeID type_id) {
+    const ComponentInfo* info = ComponentInfo::Find(type_id);
+    if (!info->is_tag) {
+      layout.push_back(info);
+    }
+  });
+  return layout;
+}
+
+ComponentSignature engine::ecs::MakeSignature(const ArchetypeLayout& layout) noexcept {
+  ComponentSignature signature;
+  for (const ComponentInfo* info : layout) {
+    signature.Set(info->id);
+  }
+  return signature;
+}
+
+ArchetypeTable::ArchetypeTable(const ComponentSignature& signature, Arena& arena, const std::atomic<Tick>& change_tick)
+    : signature_(signature),
+      layout_(MakeArchetypeLayout(signature)),
+      arena_(&arena),
+      change_tick_(&change_tick),
+      row_ticks_(layout_.size()) {
+  column_indices_.fill(kNoColumnIndex);
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    column_indices_[layout_[column]->id] = static_cast<std::uint16_t>(column);
+  }
+
+  std::size_t row_bytes = 0;
+  for (const ComponentInfo* info : layout_) {
+    row_bytes += info->size;
+  }
+  if (row_bytes == 0) {
+    // Nothing is stored per row, so chunks only delimit iteration ranges and never need memory.
+    chunk_capacity_ = kChunkSize;
+    return;
+  }
+
+  // Start from the ideal capacity and shrink it until the aligned columns fit into a chunk.
+  auto layout_bytes = [this](std::size_t capacity) {
+    std::size_t offset = 0;
+    for (const ComponentInfo* info : layout_) {
+      offset = AlignUp(offset, std::max(info->alignment, kChunkAlignment));
+      offset += info->size * capacity;
+    }
+    return offset;
+  };
+  chunk_capacity_ = std::max<std::size_t>(kChunkSize / row_bytes, 1);
+  while (chunk_capacity_ > 1 && layout_bytes(chunk_capacity_) > kChunkSize) {
+    --chunk_capacity_;
+  }
+  chunk_bytes_ = AlignUp(std::max(layout_bytes(chunk_capacity_), kChunkSize), kChunkAlignment);
+
+  std::size_t offset = 0;
+  column_offsets_.reserve(layout_.size());
+  for (const ComponentInfo* info : layout_) {
+    offset = AlignUp(offset, std::max(info->alignment, kChunkAlignment));
+    column_offsets_.push_back(offset);
+    offset += info->size * chunk_capacity_;
+  }
+}
+
+ArchetypeTable::~ArchetypeTable() { Clear(); }
+
+std::size_t ArchetypeTable::Size() const noexcept { return entities_.size(); }
+
+bool ArchetypeTable::Empty() const noexcept { return entities_.empty(); }
+
+void ArchetypeTable::Clear() {
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    if (layout_[column]->is_trivial) {
+      continue;
+    }
+    for (std::size_t row = 0; row < entities_.size(); ++row) {
+      layout_[column]->destroy(At(column, row));
+    }
+  }
+  entities_.clear();
+  for (auto& ticks : row_ticks_) {
+    ticks.clear();
+  }
+  chunk_ticks_.clear();
+  chunk_rows_ticks_.clear();
+  chunk_stamps_.clear();
+}
+
+const ArchetypeLayout& ArchetypeTable::Layout() const noexcept { return layout_; }
+
+const ComponentSignature& ArchetypeTable::Signature() const noexcept { return signature_; }
+
+std::size_t ArchetypeTable::ChunkCapacity() const noexcept { return chunk_capacity_; }
+
+std::size_t ArchetypeTable::ChunkCount() const noexcept {
+  return (entities_.size() + chunk_capacity_ - 1) / chunk_capacity_;
+}
+
+std::size_t ArchetypeTable::ChunkSize(std::size_t chunk_index) const noexcept {
+  std::size_t first_row = chunk_index * chunk_capacity_;
+  return std::min(chunk_capacity_, entities_.size() - first_row);
+}
+
+std::size_t ArchetypeTable::ChunkBytes() const noexcept { return chunk_bytes_; }
+
+std::size_t ArchetypeTable::HeldChunkCount() const noexcept { return chunks_.size(); }
+
+std::size_t ArchetypeTable::AdoptedChunkCount() const noexcept { return adopted_chunk_count_; }
+
+std::size_t ArchetypeTable::MetadataBytes() const noexcept {
+  std::size_t bytes = column_offsets_.capacity() * sizeof(std::size_t) + chunks_.capacity() * sizeof(std::byte*) +
+                      entities_.capacity() * sizeof(EntityID) + row_ticks_.capacity() * sizeof(row_ticks_[0]) +
+                      chunk_ticks_.capacity() * sizeof(ComponentTicks) + chunk_rows_ticks_.capacity() * sizeof(Tick) +
+                      chunk_stamps_.capacity() * sizeof(Tick);
+  for (const auto& ticks : row_ticks_) {
+    bytes += ticks.capacity() * sizeof(ComponentTicks);
+  }
+  return bytes;
+}
+
+std::size_t ArchetypeTable::ColumnOffset(std::size_t column) const noexcept { return column_offsets_[column]; }
+
+std::size_t ArchetypeTable::FindColumn(ComponentTypeID type_id) const noexcept {
+  std::uint16_t column = column_indices_[type_id];
+  return column == kNoColumnIndex ? kNoColumn : column;
+}
+
+void* ArchetypeTable::ColumnData(std::size_t column, std::size_t chunk_index) noexcept {
+  return chunks_[chunk_index] + column_offsets_[column];
+}
+
+const void* ArchetypeTable::ColumnData(std::size_t column, std::size_t chunk_index) const noexcept {
+  return chunks_[chunk_index] + column_offsets_[column];
+}
+
+void* ArchetypeTable::At(std::size_t column, std::size_t row) noexcept {
+  auto* column_data = static_cast<std::byte*>(ColumnData(column, row / chunk_capacity_));
+  return column_data + (row % chunk_capacity_) * layout_[column]->size;
+}
+
+const void* ArchetypeTable::At(std::size_t column, std::size_t row) const noexcept {
+  const auto* column_data = static_cast<const std::byte*>(ColumnData(column, row / chunk_capacity_));
+  return column_data + (row % chunk_capacity_) * layout_[column]->size;
+}
+
+Tick ArchetypeTable::CurrentTick() const noexcept { return change_tick_->load(std::memory_order_relaxed); }
+
+ComponentTicks ArchetypeTable::RowTicks(std::size_t column, std::size_t row) const noexcept {
+  ComponentTicks ticks = row_ticks_[column][row];
+  ticks.changed = std::max(ticks.changed, chunk_stamps_[(row / chunk_capacity_) * layout_.size() + column]);
+  return ticks;
+}
+
+const ComponentTicks& ArchetypeTable::ChunkTicks(std::size_t column, std::size_t chunk_index) const noexcept {
+  return chunk_ticks_[chunk_index * layout_.size() + column];
+}
+
+Tick ArchetypeTable::ChunkRowsTick(std::size_t chunk_index) const noexcept { return chunk_rows_ticks_[chunk_index]; }
+
+void ArchetypeTable::MarkChanged(std::size_t column, std::size_t row) noexcept { MarkChanged(column, row, 1); }
+
+void ArchetypeTable::MarkChanged(std::size_t column, std::size_t first_row, std::size_t count) noexcept {
+  Tick tick = CurrentTick();
+  std::size_t chunk_index = first_row / chunk_capacity_;
+  std::size_t ticks_index = chunk_index * layout_.size() + column;
+  if (first_row % chunk_capacity_ == 0 && count == ChunkSize(chunk_index)) {
+    // Every row of the chunk is stamped, so one stamp of the chunk stands for all of them.
+    chunk_stamps_[ticks_index] = tick;
+  } else {
+    for (std::size_t row = first_row; row < first_row + count; ++row) {
+      row_ticks_[column][row].changed = tick;
+    }
+  }
+  RaiseAtomically(chunk_ticks_[ticks_index].changed, tick);
+}
+
+const EntityID& ArchetypeTable::EntityAt(std::size_t row) const noexcept { return entities_[row]; }
+
+const std::vector<EntityID>& ArchetypeTable::Entities() const noexcept { return entities_; }
+
+std::size_t ArchetypeTable::PushBack(const EntityID& entity_id) {
+  std::size_t row = entities_.size();
+  if (chunk_bytes_ != 0 && row / chunk_capacity_ >= chunks_.size()) {
+    AllocateChunk();
+  }
+  entities_.push_back(entity_id);
+  chunk_ticks_.resize(ChunkCount() * layout_.size());
+  chunk_rows_ticks_.resize(ChunkCount());
+  chunk_stamps_.resize(ChunkCount() * layout_.size());
+  Tick tick = CurrentTick();
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    row_ticks_[column].push_back({tick, tick});
+    RaiseChunkTicks(column, row);
+  }
+  chunk_rows_ticks_[row / chunk_capacity_] = tick;
+  return row;
+}
+
+std::size_t ArchetypeTable::PushBack(std::span<const EntityID> entity_ids) {
+  std::size_t first_row = AppendRows(entity_ids.size());
+  std::copy(entity_ids.begin(), entity_ids.end(), entities_.begin() + static_cast<std::ptrdiff_t>(first_row));
+  return first_row;
+}
+
+std::size_t ArchetypeTable::AppendRows(std::size_t count) {
+  std::size_t first_row = entities_.size();
+  std::size_t row_count = first_row + count;
+  if (chunk_bytes_ != 0) {
+    std::size_t chunk_count = (row_count + chunk_capacity_ - 1) / chunk_capacity_;
+    chunks_.reserve(chunk_count);
+    while (chunks_.size() < chunk_count) {
+      AllocateChunk();
+    }
+  }
+  entities_.resize(row_count);
+  chunk_ticks_.resize(ChunkCount() * layout_.size());
+  chunk_rows_ticks_.resize(ChunkCount());
+  chunk_stamps_.resize(ChunkCount() * layout_.size());
+  Tick tick = CurrentTick();
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    row_ticks_[column].resize(row_count, {tick, tick});
+    for (std::size_t row = first_row; row < row_count; row += chunk_capacity_ - row % chunk_capacity_) {
+      RaiseChunkTicks(column, row);
+    }
+  }
+  MarkRowsChanged(first_row, count);
+  return first_row;
+}
+
+template <typename Function>
+void ArchetypeTable::ForEachSegment(std::size_t column, std::size_t first_row, std::size_t count,
+                                    Function&& function) {
+  for (std::size_t row = first_row; row < first_row + count;) {
+    std::size_t offset = row % chunk_capacity_;
+    std::size_t segment_count = std::min(chunk_capacity_ - offset, first_row + count - row);
+    function(static_cast<std::byte*>(At(column, row)), segment_count);
+    row += segment_count;
+  }
+}
+
+void ArchetypeTable::ConstructRows(std::size_t column, std::size_t first_row, std::size_t count) {
+  const ComponentInfo& info = *layout_[column];
+  ForEachSegment(column, first_row, count, [&info](std::byte* components, std::size_t segment_count) {
+    for (std::size_t i = 0; i < segment_count; ++i) {
+      info.default_construct(components + i * info.size);
+    }
+  });
+}
+
+void ArchetypeTable::CopyConstructRows(std::size_t column, std::size_t first_row, std::size_t count,
+                                       const void* source) {
+  const ComponentInfo& info = *layout_[column];
+  ForEachSegment(column, first_row, count, [&info, source](std::byte* components, std::size_t segment_count) {
+    if (info.is_trivial) {
+      // Doubles the initialized prefix of the segment with every copy.
+      std::memcpy(components, source, info.size);
+      for (std::size_t filled = 1; filled < segment_count;) {
+        std::size_t copied = std::min(filled, segment_count - filled);
+        std::memcpy(components + filled * info.size, components, copied * info.size);
+        filled += copied;
+      }
+      return;
+    }
+    for (std::size_t i = 0; i < segment_count; ++i) {
+      info.copy_construct(components + i * info.size, source);
+    }
+  });
+}
+
+void ArchetypeTable::CopyRows(std::size_t column, std::size_t first_row, std::size_t count, const void* source) {
+  std::size_t size = layout_[column]->size;
+  const auto* next = static_cast<const std::byte*>(source);
+  ForEachSegment(column, first_row, count, [size, &next](std::byte* components, std::size_t segment_count) {
+    std::memcpy(components, next, segment_count * size);
+    next += segment_count * size;
+  });
+}
+
+void ArchetypeTable::AdoptChunks(std::span<std::byte* const> chunks) {
+  chunks_.insert(chunks_.begin(), chunks.begin(), chunks.end());
+  adopted_chunk_count_ += chunks.size();
+}
+
+void ArchetypeTable::SwapRemove(std::size_t row) {
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    if (!layout_[column]->is_trivial) {
+      layout_[column]->destroy(At(column, row));
+    }
+  }
+  FillGap(row);
+}
+
+std::size_t ArchetypeTable::MoveRow(std::size_t row, ArchetypeTable& destination) {
+  std::size_t new_row = destination.PushBack(entities_[row]);
+  destination.SpreadChunkStamps(new_row / destination.chunk_capacity_);
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    const ComponentInfo* info = layout_[column];
+    void* source = At(column, row);
+    std::size_t destination_column = destination.FindColumn(info->id);
+    if (destination_column != kNoColumn) {
+      Relocate(*info, destination.At(destination_column, new_row), source);
+      destination.row_ticks_[destination_column][new_row] = RowTicks(column, row);
+    } else if (!info->is_trivial) {
+      info->destroy(source);
+    }
+  }
+  FillGap(row);
+  return new_row;
+}
+
+void ArchetypeTable::Resize(std::size_t row_count) {
+  if (row_count >= entities_.size()) {
+    static_cast<void>(AppendRows(row_count - entities_.size()));
+    return;
+  }
+  // The chunk of the first dropped row loses rows, and the chunks after it are dropped.
+  MarkRowsChanged(row_count, 1);
+  entities_.resize(row_count);
+  for (auto& ticks : row_ticks_) {
+    ticks.resize(row_count);
+  }
+  chunk_ticks_.resize(ChunkCount() * layout_.size());
+  chunk_rows_ticks_.resize(ChunkCount());
+  chunk_stamps_.resize(ChunkCount() * layout_.size());
+}
+
+void ArchetypeTable::SetEntities(std::size_t first_row, std::span<const EntityID> entity_ids) {
+  std::copy(entity_ids.begin(), entity_ids.end(), entities_.begin() + static_cast<std::ptrdiff_t>(first_row));
+  MarkRowsChanged(first_row, entity_ids.size());
+}
+
+void ArchetypeTable::FillGap(std::size_t row) {
+  std::size_t last_row = entities_.size() - 1;
+  MarkRowsChanged(row, 1);
+  MarkRowsChanged(last_row, 1);
+  if (row != last_row) {
+    SpreadChunkStamps(row / chunk_capacity_);
+    for (std::size_t column = 0; column < layout_.size(); ++column) {
+      Relocate(*layout_[column], At(column, row), At(column, last_row));
+      row_ticks_[column][row] = RowTicks(column, last_row);
+      RaiseChunkTicks(column, row);
+    }
+    entities_[row] = entities_[last_row];
+  }
+  entities_.pop_back();
+  for (auto& ticks : row_ticks_) {
+    ticks.pop_back();
+  }
+}
+
+void ArchetypeTable::MarkRowsChanged(std::size_t first_row, std::size_t count) noexcept {
+  Tick tick = CurrentTick();
+  std::size_t end_chunk = (first_row + count + chunk_capacity_ - 1) / chunk_capacity_;
+  for (std::size_t chunk = first_row / chunk_capacity_; count != 0 && chunk < end_chunk; ++chunk) {
+    chunk_rows_ticks_[chunk] = tick;
+  }
+}
+
+void ArchetypeTable::RaiseChunkTicks(std::size_t column, std::size_t row) noexcept {
+  const ComponentTicks& row_ticks = row_ticks_[column][row];
+  ComponentTicks& chunk_ticks = chunk_ticks_[(row / chunk_capacity_) * layout_.size() + column];
+  chunk_ticks.added = std::max(chunk_ticks.added, row_ticks.added);
+  chunk_ticks.changed = std::max(chunk_ticks.changed, row_ticks.changed);
+}
+
+void ArchetypeTable::SpreadChunkStamps(std::size_t chunk_index) noexcept {
+  std::size_t first_row = chunk_index * chunk_capacity_;
+  std::size_t end_row = std::min(first_row + chunk_capacity_, entities_.size());
+  for (std::size_t column = 0; column < layout_.size(); ++column) {
+    Tick& stamp = chunk_stamps_[chunk_index * layout_.size() + column];
+    if (stamp == 0) {
+      continue;
+    }
+    for (std::size_t row = first_row; row < end_row; ++row) {
+      row_ticks_[column][row].changed = std::max(row_ticks_[column][row].changed, stamp);
+    }
+    stamp = 0;
+  }
+}
+
+void ArchetypeTable::AllocateChunk() {
+  chunks_.push_back(static_cast<std::byte*>(arena_->Allocate(chunk_bytes_, kChunkAlignment)));
+}
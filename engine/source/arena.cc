@@ -0,0 +1,104 @@
+#include "memory/arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+using engine::memory::Arena;
+
+#include "memory/pool-allocator.h"
+using engine::memory::PoolStatistics;
+
+namespace {
+
+constexpr std::size_t kBlockAlignment = 64;
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Computes the first offset from a block that is aligned in memory.
+ */
+std::size_t AlignOffset(const void* block, std::size_t offset, std::size_t alignment) noexcept {
+  auto address = reinterpret_cast<std::uintptr_t>(block);
+  return AlignUp(address + offset, alignment) - address;
+}
+
+}  // namespace
+
+Arena::Arena(std::size_t block_size) noexcept : block_size_(block_size) {}
+
+Arena::~Arena() { Release(); }
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+  std::size_t offset = AlignOffset(current_, offset_, alignment);
+  if (current_ == nullptr || offset + size > current_->size) {
+    Advance(size, alignment);
+    offset = AlignOffset(current_, offset_, alignment);
+  }
+
+  bytes_used_ += offset + size - offset_;
+  offset_ = offset + size;
+  statistics_.allocations++;
+  return reinterpret_cast<std::byte*>(current_) + offset;
+}
+
+void Arena::Reset() noexcept {
+  current_ = first_;
+  offset_ = AlignUp(sizeof(Block), kBlockAlignment);
+  bytes_used_ = 0;
+  statistics_.deallocations = statistics_.allocations;
+}
+
+void Arena::Release() noexcept {
+  while (first_ != nullptr) {
+    Block* next = first_->next;
+    ::operator delete(first_, std::align_val_t{kBlockAlignment});
+    first_ = next;
+  }
+  current_ = nullptr;
+  offset_ = 0;
+  bytes_used_ = 0;
+  statistics_.deallocations = statistics_.allocations;
+}
+
+std::size_t Arena::BytesUsed() const noexcept { return bytes_used_; }
+
+std::size_t Arena::BytesReserved() const noexcept {
+  std::size_t bytes_reserved = 0;
+  for (const Block* block = first_; block != nullptr; block = block->next) {
+    bytes_reserved += block->size;
+  }
+  return bytes_reserved;
+}
+
+PoolStatistics Arena::Statistics() const noexcept { return statistics_; }
+
+void Arena::Advance(std::size_t size, std::size_t alignment) {
+  std::size_t header_size = AlignUp(sizeof(Block), kBlockAlignment);
+  Block* previous = current_;
+  // Blocks kept by Reset() are reused in order, skipping those too small for the request.
+  for (Block* next = current_ == nullptr ? first_ : current_->next; next != nullptr; next = next->next) {
+    if (AlignOffset(next, header_size, alignment) + size <= next->size) {
+      current_ = next;
+      offset_ = header_size;
+      return;
+    }
+    previous = next;
+  }
+
+  std::size_t block_size = std::max(block_size_, AlignUp(header_size, alignment) + size);
+  // Blocks are aligned to kBlockAlignment, so stricter alignments are reached by padding within the block.
+  block_size += alignment > kBlockAlignment ? alignment - kBlockAlignment : 0;
+  auto* block = ::new (::operator new(block_size, std::align_val_t{kBlockAlignment})) Block{nullptr, block_size};
+  statistics_.upstream_allocations++;
+  statistics_.upstream_bytes += block_size;
+  if (previous == nullptr) {
+    first_ = block;
+  } else {
+    previous->next = block;
+  }
+  current_ = block;
+  offset_ = header_size;
+}
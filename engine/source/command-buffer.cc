@@ -0,0 +1,134 @@
+#include "ecs/command-buffer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+using engine::ecs::CommandBuffer;
+using engine::ecs::CommandQueue;
+
+#include "ecs/component-collection.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::ComponentSignature;
+using engine::ecs::ComponentTypeID;
+using engine::ecs::ComponentValue;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+
+#include "profiling/profiler.h"
+
+std::size_t CommandBuffer::Size() const noexcept { return commands_.size() + insertions_.size(); }
+
+bool CommandBuffer::Empty() const noexcept { return Size() == 0; }
+
+void CommandBuffer::Clear() {
+  commands_.clear();
+  insertions_.clear();
+}
+
+void CommandBuffer::Insert(ComponentCollection entity_data, const EntityID& parent_id) {
+  insertions_.push_back({std::move(entity_data), parent_id});
+}
+
+void CommandBuffer::Erase(const EntityID& entity_id) {
+  commands_.push_back({.entity_id = entity_id, .type = CommandType::kErase, .info = nullptr, .component = nullptr});
+}
+
+void CommandBuffer::Append(CommandBuffer&& other) {
+  commands_.insert(commands_.end(), std::make_move_iterator(other.commands_.begin()),
+                   std::make_move_iterator(other.commands_.end()));
+  insertions_.insert(insertions_.end(), std::make_move_iterator(other.insertions_.begin()),
+                     std::make_move_iterator(other.insertions_.end()));
+  other.Clear();
+}
+
+std::vector<EntityID> CommandBuffer::Flush(EntityCollection& entities) {
+  ENGINE_PROFILE_ZONE("CommandBuffer::Flush");
+  // Grouping the commands of every entity keeps their recording order and visits entity slots in ascending order.
+  std::stable_sort(commands_.begin(), commands_.end(), [](const Command& lhs, const Command& rhs) {
+    return lhs.entity_id.GetIndex() < rhs.entity_id.GetIndex();
+  });
+  for (std::size_t first = 0; first < commands_.size();) {
+    std::size_t last = first + 1;
+    while (last < commands_.size() && commands_[last].entity_id == commands_[first].entity_id) {
+      ++last;
+    }
+    ApplyEntityCommands(entities, std::span<Command>(commands_).subspan(first, last - first));
+    first = last;
+  }
+
+  std::vector<EntityID> inserted_ids;
+  inserted_ids.reserve(insertions_.size());
+  for (auto& insertion : insertions_) {
+    inserted_ids.push_back(entities.Insert(std::move(insertion.entity_data), insertion.parent_id).first);
+  }
+  Clear();
+  return inserted_ids;
+}
+
+void CommandBuffer::ApplyEntityCommands(EntityCollection& entities, std::span<Command> commands) {
+  const EntityID& entity_id = commands.front().entity_id;
+  if (!entities.Contains(entity_id)) {
+    return;
+  }
+
+  const ComponentSignature& old_signature = entities.At(entity_id).GetSignature();
+  ComponentSignature signature = old_signature;
+  std::vector<ComponentValue> values;
+  for (Command& command : commands) {
+    if (command.type == CommandType::kErase) {
+      entities.Erase(entity_id);
+      return;
+    }
+
+    ComponentTypeID type_id = command.info->id;
+    auto staged = std::find_if(values.begin(), values.end(),
+                               [type_id](const ComponentValue& value) { return value.info->id == type_id; });
+    if (command.type == CommandType::kEmplace && !signature.Test(type_id)) {
+      signature.Set(type_id);
+      if (!command.info->is_tag) {
+        values.push_back({command.info, command.component.get()});
+      }
+    } else if (command.type == CommandType::kRemove && signature.Test(type_id)) {
+      signature.Reset(type_id);
+      if (staged != values.end()) {
+        values.erase(staged);
+      }
+    }
+  }
+
+  if (signature != old_signature || !values.empty()) {
+    entities.Reshape(entity_id, signature, values);
+  }
+}
+
+CommandBuffer& CommandQueue::Local() {
+  std::lock_guard lock(mutex_);
+  std::thread::id thread_id = std::this_thread::get_id();
+  for (auto& [owner_id, buffer] : buffers_) {
+    if (owner_id == thread_id) {
+      return *buffer;
+    }
+  }
+  buffers_.emplace_back(thread_id, std::make_unique<CommandBuffer>());
+  return *buffers_.back().second;
+}
+
+std::vector<EntityID> CommandQueue::Flush(EntityCollection& entities) {
+  std::lock_guard lock(mutex_);
+  if (buffers_.empty()) {
+    return {};
+  }
+  CommandBuffer& merged = *buffers_.front().second;
+  for (std::size_t i = 1; i < buffers_.size(); ++i) {
+    merged.Append(std::move(*buffers_[i].second));
+  }
+  return merged.Flush(entities);
+}
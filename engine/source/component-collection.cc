@@ -1,15 +1,21 @@
 #include "ecs/component-collection.h"
 
 #include <memory>
+#include <utility>
 
 #include "ecs/component-base.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
 using engine::ecs::ComponentCollection;
+using engine::ecs::ComponentInfo;
+using engine::ecs::ComponentSignature;
 
 ComponentCollection::ComponentCollection(const ComponentCollection& other) {
-  for (const auto& [key, component] : other.inner_components_) {
-    auto component_copy = std::make_shared<ComponentBase>(*component);
-    inner_components_.try_emplace(key, component_copy);
+  for (const auto& [key, stored] : other.inner_components_) {
+    EmplaceCopy(*stored.info, stored.instance.get());
   }
+  // Tags are not stored in the map, so they are copied with the signature.
+  signature_ = other.signature_;
 }
 
 ComponentCollection& ComponentCollection::operator=(const ComponentCollection& other) {
@@ -17,15 +23,49 @@ ComponentCollection& ComponentCollection::operator=(const ComponentCollection& o
     return *this;
   }
   inner_components_.clear();
-  for (const auto& [key, component] : other.inner_components_) {
-    auto component_copy = std::make_shared<ComponentBase>(*component);
-    inner_components_.try_emplace(key, component_copy);
+  signature_ = ComponentSignature{};
+  for (const auto& [key, stored] : other.inner_components_) {
+    EmplaceCopy(*stored.info, stored.instance.get());
   }
+  signature_ = other.signature_;
   return *this;
 }
 
-std::size_t ComponentCollection::Size() const noexcept { return inner_components_.size(); }
+ComponentCollection::ComponentCollection(ComponentCollection&& other) noexcept
+    : inner_components_(std::move(other.inner_components_)), signature_(other.signature_) {
+  other.inner_components_.clear();
+  other.signature_ = ComponentSignature{};
+}
+
+ComponentCollection& ComponentCollection::operator=(ComponentCollection&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  inner_components_ = std::move(other.inner_components_);
+  signature_ = other.signature_;
+  other.inner_components_.clear();
+  other.signature_ = ComponentSignature{};
+  return *this;
+}
 
-bool ComponentCollection::Empty() const noexcept { return inner_components_.empty(); }
+std::size_t ComponentCollection::Size() const noexcept { return signature_.Count(); }
 
-void ComponentCollection::Clear() { inner_components_.clear(); }
\ No newline at end of file
+bool ComponentCollection::Empty() const noexcept { return signature_.Empty(); }
+
+void ComponentCollection::Clear() {
+  inner_components_.clear();
+  signature_ = ComponentSignature{};
+}
+
+const ComponentSignature& ComponentCollection::GetSignature() const noexcept { return signature_; }
+
+bool ComponentCollection::EmplaceCopy(const ComponentInfo& info, const void* source) {
+  if (signature_.Test(info.id)) {
+    return false;
+  }
+  if (!info.is_tag) {
+    inner_components_.try_emplace(info.id, StoredComponent{&info, info.make_shared_copy(source)});
+  }
+  signature_.Set(info.id);
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "ecs/component-info.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+using engine::ecs::ComponentInfo;
+
+#include "ecs/component-signature.h"
+using engine::ecs::ComponentTypeID;
+using engine::ecs::kMaxComponentTypes;
+
+namespace {
+
+std::atomic<ComponentTypeID> next_type_id{0};                                     // NOLINT
+std::array<std::atomic<const ComponentInfo*>, kMaxComponentTypes> registered_infos{};  // NOLINT
+
+}  // namespace
+
+const ComponentInfo* ComponentInfo::Find(ComponentTypeID type_id) noexcept {
+  if (type_id >= kMaxComponentTypes) {
+    return nullptr;
+  }
+  return registered_infos[type_id].load(std::memory_order_acquire);
+}
+
+ComponentTypeID ComponentInfo::ReserveID() noexcept {
+  ComponentTypeID type_id = next_type_id.fetch_add(1, std::memory_order_relaxed);
+  if (type_id >= kMaxComponentTypes) {
+    std::fputs("engine::ecs: too many component types, raise kMaxComponentTypes\n", stderr);
+    std::terminate();
+  }
+  return type_id;
+}
+
+bool ComponentInfo::Register(const ComponentInfo& info) noexcept {
+  registered_infos[info.id].store(&info, std::memory_order_release);
+  return true;
+}
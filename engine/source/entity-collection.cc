@@ -3,86 +3,403 @@
 #include <vector>
 using engine::ecs::EntityCollection;
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <utility>
 
+#include "ecs/archetype-table.h"
+#include "ecs/change-tick.h"
 #include "ecs/component-collection.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-hierarchy.h"
+#include "ecs/entity-ref.h"
 #include "ecs/entity.h"
+#include "ecs/memory-statistics.h"
+using engine::ecs::ArchetypeMemoryStatistics;
+using engine::ecs::ArchetypeTable;
 using engine::ecs::ComponentCollection;
+using engine::ecs::ComponentInfo;
+using engine::ecs::ComponentSignature;
+using engine::ecs::ComponentTicks;
+using engine::ecs::ComponentTypeID;
+using engine::ecs::ComponentValue;
+using engine::ecs::ConstEntityRef;
 using engine::ecs::Entity;
+using engine::ecs::EntityHierarchy;
+using engine::ecs::EntityLocation;
+using engine::ecs::EntityRef;
+using engine::ecs::kMaxComponentTypes;
+using engine::ecs::MemoryStatistics;
+using engine::ecs::RemovedComponent;
+using engine::ecs::Tick;
 
 #include "ecs/entity-id.h"
 using engine::ecs::EntityID;
 
-std::size_t EntityCollection::Size() const noexcept { return inner_entities_.size(); }
+#include "jobs/job-system.h"
+using engine::jobs::JobSystem;
 
-bool EntityCollection::Empty() const noexcept { return inner_entities_.empty(); }
+#include "memory/arena.h"
+using engine::memory::Arena;
 
-void EntityCollection::Clear() { inner_entities_.clear(); }
+#include "profiling/profiler.h"
+
+namespace {
+
+/**
+ * @brief A chunk of an archetype table, the unit of work of parallel scans.
+ */
+struct ChunkRange final {
+  const ArchetypeTable* table;  ///< Table that owns the chunk.
+  std::size_t begin;            ///< First row of the chunk.
+  std::size_t end;              ///< Row past the last row of the chunk.
+};
+
+/**
+ * @brief Splits the rows of all tables into chunks, in storage order.
+ * @param tables The tables to split.
+ * @return The non-empty chunks.
+ */
+std::vector<ChunkRange> CollectChunks(const std::vector<std::unique_ptr<ArchetypeTable>>& tables) {
+  std::vector<ChunkRange> chunks;
+  for (const auto& table : tables) {
+    for (std::size_t begin = 0; begin < table->Size(); begin += table->ChunkCapacity()) {
+      chunks.push_back({table.get(), begin, std::min(table->Size(), begin + table->ChunkCapacity())});
+    }
+  }
+  return chunks;
+}
+
+}  // namespace
+
+std::size_t EntityCollection::Size() const noexcept { return ids_.Size(); }
+
+bool EntityCollection::Empty() const noexcept { return ids_.Size() == 0; }
+
+void EntityCollection::Clear() {
+  ENGINE_PROFILE_ZONE("EntityCollection::Clear");
+  structure_tick_ = GetChangeTick();
+  ids_.Clear();
+  hierarchy_.Clear();
+  removed_components_.clear();
+  for (auto& entity : inner_entities_) {
+    entity = Entity{};
+  }
+  for (auto& table : tables_) {
+    table->Clear();
+  }
+}
+
+void EntityCollection::Reset() {
+  ENGINE_PROFILE_ZONE("EntityCollection::Reset");
+  structure_tick_ = GetChangeTick();
+  ids_.Clear();
+  inner_entities_.clear();
+  hierarchy_.Clear();
+  removed_components_.clear();
+  tables_.clear();
+  ++table_generation_;
+  table_edges_.clear();
+  table_indices_.clear();
+  adopted_storage_.clear();
+  arena_->Reset();
+}
+
+const Arena& EntityCollection::GetArena() const noexcept { return *arena_; }
+
+MemoryStatistics EntityCollection::GetMemoryStatistics() const {
+  MemoryStatistics statistics;
+  statistics.entity_count = Size();
+  // Components are summed by type ID first, so that `components` comes out sorted by type ID.
+  std::array<std::size_t, kMaxComponentTypes> counts{};
+  std::array<std::size_t, kMaxComponentTypes> bytes{};
+  ComponentSignature stored_types;
+  statistics.archetypes.reserve(tables_.size());
+  for (const auto& table : tables_) {
+    ArchetypeMemoryStatistics archetype;
+    archetype.signature = table->Signature();
+    archetype.entity_count = table->Size();
+    archetype.chunk_count = table->HeldChunkCount();
+    archetype.chunk_capacity = table->ChunkCapacity();
+    archetype.chunk_bytes = table->HeldChunkCount() * table->ChunkBytes();
+    archetype.metadata_bytes = table->MetadataBytes();
+    for (const ComponentInfo* info : table->Layout()) {
+      archetype.component_bytes += table->Size() * info->size;
+      bytes[info->id] += table->Size() * info->size;
+    }
+    table->Signature().ForEach([&](ComponentTypeID type_id) { counts[type_id] += table->Size(); });
+    stored_types = stored_types | table->Signature();
+
+    statistics.chunk_bytes += archetype.chunk_bytes;
+    statistics.component_bytes += archetype.component_bytes;
+    statistics.adopted_bytes += table->AdoptedChunkCount() * table->ChunkBytes();
+    statistics.table_bytes += sizeof(ArchetypeTable) + archetype.metadata_bytes;
+    statistics.archetypes.push_back(archetype);
+  }
+  stored_types.ForEach([&](ComponentTypeID type_id) {
+    const ComponentInfo* info = ComponentInfo::Find(type_id);
+    statistics.components.push_back(
+        {info, counts[type_id], bytes[type_id], info->is_tag ? 0 : counts[type_id] * sizeof(ComponentTicks)});
+  });
+
+  using TableIndexEntry = decltype(table_indices_)::value_type;
+  for (const auto& edges : table_edges_) {
+    statistics.table_bytes += edges != nullptr ? sizeof(TableEdges) : 0;
+  }
+  statistics.table_bytes += tables_.capacity() * sizeof(tables_[0]) +
+                            table_edges_.capacity() * sizeof(table_edges_[0]) +
+                            table_indices_.bucket_count() * sizeof(void*) +
+                            table_indices_.size() * (sizeof(TableIndexEntry) + 2 * sizeof(void*));
+  statistics.hierarchy_bytes = hierarchy_.BytesReserved();
+  statistics.id_bytes = ids_.BytesReserved() + inner_entities_.capacity() * sizeof(Entity);
+  statistics.other_bytes = removed_components_.capacity() * sizeof(RemovedComponent) +
+                           adopted_storage_.capacity() * sizeof(adopted_storage_[0]) +
+                           (inserted_ids_.capacity() + pending_erasures_.capacity()) * sizeof(EntityID) +
+                           erased_locations_.capacity() * sizeof(EntityLocation);
+  statistics.arena_reserved_bytes = arena_->BytesReserved();
+  statistics.arena_used_bytes = arena_->BytesUsed();
+  return statistics;
+}
+
+Tick EntityCollection::GetChangeTick() const noexcept { return change_tick_->load(std::memory_order_relaxed); }
+
+Tick EntityCollection::AdvanceChangeTick() noexcept {
+  return change_tick_->fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+const std::vector<RemovedComponent>& EntityCollection::GetRemovedComponents() const noexcept {
+  return removed_components_;
+}
+
+void EntityCollection::ClearRemovedComponents(Tick tick) {
+  // Records are appended in tick order, so the cleared ones form a prefix.
+  auto first_kept = std::find_if(removed_components_.begin(), removed_components_.end(),
+                                 [tick](const RemovedComponent& record) { return record.tick > tick; });
+  removed_components_.erase(removed_components_.begin(), first_kept);
+}
 
 std::pair<EntityID, bool> EntityCollection::Insert(const ComponentCollection& entity_data, const EntityID& parent_id) {
-  ComponentCollection entity_data_copy = entity_data;
-  return Insert(std::move(entity_data_copy), parent_id);
+  ENGINE_PROFILE_ZONE("EntityCollection::Insert");
+  EntityID new_id = InsertRow(entity_data.GetSignature(), parent_id);
+  EntityLocation location = inner_entities_[new_id.GetIndex()].GetLocation();
+  ArchetypeTable& table = *tables_[location.table];
+  entity_data.ForEach([&table, &location](const ComponentInfo& info, const void* component) {
+    info.copy_construct(table.At(table.FindColumn(info.id), location.row), component);
+  });
+  return {new_id, true};
 }
 
 std::pair<EntityID, bool> EntityCollection::Insert(ComponentCollection&& entity_data, const EntityID& parent_id) {
-  Entity new_entity;
-  new_entity.RememberParent(parent_id);
-  new_entity.SetComponents(std::move(entity_data));
+  ENGINE_PROFILE_ZONE("EntityCollection::Insert");
+  EntityID new_id = InsertRow(entity_data.GetSignature(), parent_id);
+  EntityLocation location = inner_entities_[new_id.GetIndex()].GetLocation();
+  ArchetypeTable& table = *tables_[location.table];
+  entity_data.ForEach([&table, &location](const ComponentInfo& info, void* component) {
+    info.move_construct(table.At(table.FindColumn(info.id), location.row), component);
+  });
+  entity_data.Clear();
+  return {new_id, true};
+}
 
-  EntityID new_id;
-  bool was_inserted = inner_entities_.insert({new_id, new_entity}).second;
+std::pair<EntityID, bool> EntityCollection::InsertDefault(const ComponentSignature& signature,
+                                                          const EntityID& parent_id) {
+  ENGINE_PROFILE_ZONE("EntityCollection::InsertDefault");
+  EntityID new_id = InsertRow(signature, parent_id);
+  EntityLocation location = inner_entities_[new_id.GetIndex()].GetLocation();
+  ArchetypeTable& table = *tables_[location.table];
+  for (std::size_t column = 0; column < table.Layout().size(); ++column) {
+    table.Layout()[column]->default_construct(table.At(column, location.row));
+  }
+  return {new_id, true};
+}
+
+std::span<const EntityID> EntityCollection::InsertBatch(std::size_t count, const ComponentSignature& signature,
+                                                       const EntityID& parent_id) {
+  ENGINE_PROFILE_ZONE("EntityCollection::InsertBatch");
+  EntityLocation first = InsertRows(count, signature, parent_id);
+  ArchetypeTable& table = *tables_[first.table];
+  for (std::size_t column = 0; column < table.Layout().size(); ++column) {
+    table.ConstructRows(column, first.row, count);
+  }
+  return std::span<const EntityID>(table.Entities()).subspan(first.row, count);
+}
 
-  return {new_id, was_inserted};
+std::span<const EntityID> EntityCollection::InsertBatch(std::size_t count, const ComponentCollection& prototype,
+                                                       const EntityID& parent_id) {
+  ENGINE_PROFILE_ZONE("EntityCollection::InsertBatch");
+  EntityLocation first = InsertRows(count, prototype.GetSignature(), parent_id);
+  ArchetypeTable& table = *tables_[first.table];
+  prototype.ForEach([&table, &first, count](const ComponentInfo& info, const void* component) {
+    table.CopyConstructRows(table.FindColumn(info.id), first.row, count, component);
+  });
+  return std::span<const EntityID>(table.Entities()).subspan(first.row, count);
 }
 
 std::pair<ComponentCollection, bool> EntityCollection::Extract(const EntityID& target_id) {
+  ENGINE_PROFILE_ZONE("EntityCollection::Extract");
   ComponentCollection extracted_data;
   bool was_extracted{false};
-  auto iter = inner_entities_.find(target_id);
-  if (iter != inner_entities_.end()) {
-    auto extracted_node = inner_entities_.extract(iter);
-    extracted_data = extracted_node.mapped().CloneComponents();
+  if (const Entity* entity = FindEntity(target_id)) {
+    EntityLocation location = entity->GetLocation();
+    extracted_data = CopyRow(location);
+    ids_.Release(target_id);
+    hierarchy_.Remove(target_id);
+    RemoveRow(location);
     was_extracted = true;
   }
-  return {extracted_data, false};
+  return {extracted_data, was_extracted};
+}
+
+std::pair<ComponentCollection, bool> EntityCollection::Copy(const EntityID& source_id) const {
+  const Entity* entity = FindEntity(source_id);
+  if (entity == nullptr) {
+    return {ComponentCollection{}, false};
+  }
+  return {CopyRow(entity->GetLocation()), true};
 }
 
 bool EntityCollection::Erase(const EntityID& target_id) {
-  bool was_erased = false;
-  if (inner_entities_.contains(target_id)) {
-    auto children_ids = inner_entities_[target_id].GetChildrenIDs();
-    for (const auto& child_id : children_ids) {
-      Erase(child_id);
+  ENGINE_PROFILE_ZONE("EntityCollection::Erase");
+  if (FindEntity(target_id) == nullptr) {
+    return false;
+  }
+  // Descends to a leaf of the subtree, erases it and resumes from its parent, until the target itself is a leaf.
+  EntityID current_id = target_id;
+  while (true) {
+    EntityID child_id = hierarchy_.GetFirstChild(current_id);
+    if (child_id != EntityID::GetRootID()) {
+      current_id = child_id;
+      continue;
+    }
+    EntityID parent_id = hierarchy_.GetParent(current_id);
+    EntityLocation location = inner_entities_[current_id.GetIndex()].GetLocation();
+    ids_.Release(current_id);
+    hierarchy_.Remove(current_id);
+    RemoveRow(location);
+    if (current_id == target_id) {
+      return true;
     }
-    was_erased = inner_entities_.erase(target_id) > 0;
+    current_id = parent_id;
   }
-  return was_erased;
 }
 
 bool EntityCollection::EraseIf(const Predicate& predicate) {
+  ENGINE_PROFILE_ZONE("EntityCollection::EraseIf");
+  // Erasing reorders the rows of the tables, so the matching entities are collected before anything is erased.
   bool was_erased = false;
-  for (auto& [id, entity] : inner_entities_) {
-    if (predicate(entity.GetComponents())) {
-      was_erased |= inner_entities_.erase(id);
-    }
+  for (const auto& id : Filter(predicate)) {
+    was_erased |= Erase(id);
   }
   return was_erased;
 }
 
-ComponentCollection& EntityCollection::At(const EntityID& entity_id) {
-  return inner_entities_.at(entity_id).GetComponents();
+bool EntityCollection::Reshape(const EntityID& entity_id, const ComponentSignature& signature,
+                               std::span<const ComponentValue> components) {
+  ENGINE_PROFILE_ZONE("EntityCollection::Reshape");
+  Entity* entity = FindEntity(entity_id);
+  if (entity == nullptr) {
+    return false;
+  }
+
+  EntityLocation location = entity->GetLocation();
+  ComponentSignature old_signature = tables_[location.table]->Signature();
+  if (signature != old_signature) {
+    location = MoveEntity(*entity, FindOrCreateDestination(location.table, signature));
+  }
+
+  ArchetypeTable& table = *tables_[location.table];
+  ComponentSignature provided;
+  for (const ComponentValue& value : components) {
+    if (!signature.Test(value.info->id) || value.info->is_tag) {
+      continue;
+    }
+    void* target = table.At(table.FindColumn(value.info->id), location.row);
+    if (old_signature.Test(value.info->id) || provided.Test(value.info->id)) {
+      value.info->destroy(target);
+      table.MarkChanged(table.FindColumn(value.info->id), location.row);
+    }
+    value.info->move_construct(target, value.component);
+    provided.Set(value.info->id);
+  }
+  (signature - old_signature - provided).ForEach([&table, &location](ComponentTypeID type_id) {
+    std::size_t column = table.FindColumn(type_id);
+    if (column == ArchetypeTable::kNoColumn) {
+      return;
+    }
+    table.Layout()[column]->default_construct(table.At(column, location.row));
+  });
+  return true;
 }
 
-const ComponentCollection& EntityCollection::At(const EntityID& entity_id) const {
-  return inner_entities_.at(entity_id).GetComponents();
+std::size_t EntityCollection::EraseBatch(std::span<const EntityID> entity_ids) {
+  ENGINE_PROFILE_ZONE("EntityCollection::EraseBatch");
+  // Releasing every ID first turns duplicates and already visited children into stale IDs.
+  std::vector<EntityID>& pending = pending_erasures_;
+  std::vector<EntityLocation>& locations = erased_locations_;
+  pending.assign(entity_ids.begin(), entity_ids.end());
+  locations.clear();
+  std::size_t erased_count = 0;
+  for (std::size_t i = 0; i < pending.size(); ++i) {
+    EntityID entity_id = pending[i];
+    const Entity* entity = FindEntity(entity_id);
+    if (entity == nullptr) {
+      continue;
+    }
+    locations.push_back(entity->GetLocation());
+    ids_.Release(entity_id);
+    // Erased IDs are compacted at the front of `pending`, behind the cursor.
+    pending[erased_count++] = entity_id;
+    hierarchy_.ForEachChild(entity_id, [&pending](const EntityID& child_id) { pending.push_back(child_id); });
+  }
+
+  // Every erased entity follows its parent in `pending`, unless both were requested, so unlinking them in reverse
+  // order mostly removes leaves.
+  for (std::size_t i = erased_count; i-- > 0;) {
+    hierarchy_.Remove(pending[i]);
+  }
+
+  // Removing the rows of a table from the last one to the first one only ever moves surviving rows into the gaps.
+  std::sort(locations.begin(), locations.end(), [](const EntityLocation& lhs, const EntityLocation& rhs) {
+    return lhs.table != rhs.table ? lhs.table < rhs.table : lhs.row > rhs.row;
+  });
+  for (const auto& location : locations) {
+    RemoveRow(location);
+  }
+  return locations.size();
+}
+
+EntityRef EntityCollection::At(const EntityID& entity_id) {
+  const Entity* entity = FindEntity(entity_id);
+  if (entity == nullptr) {
+    throw std::out_of_range("EntityCollection::At: entity is not in the collection");
+  }
+  EntityLocation location = entity->GetLocation();
+  return {*tables_[location.table], location.row};
+}
+
+ConstEntityRef EntityCollection::At(const EntityID& entity_id) const {
+  const Entity* entity = FindEntity(entity_id);
+  if (entity == nullptr) {
+    throw std::out_of_range("EntityCollection::At: entity is not in the collection");
+  }
+  EntityLocation location = entity->GetLocation();
+  return {*tables_[location.table], location.row};
 }
 
 std::size_t EntityCollection::CountIf(const Predicate& predicate) {
   std::size_t counter = 0;
-  for (const auto& [id, entity] : inner_entities_) {
-    if (predicate(entity.GetComponents())) {
-      counter++;
+  for (const auto& table : tables_) {
+    for (std::size_t row = 0; row < table->Size(); ++row) {
+      if (predicate(ConstEntityRef{*table, row})) {
+        counter++;
+      }
     }
   }
   return counter;
@@ -90,14 +407,234 @@ std::size_t EntityCollection::CountIf(const Predicate& predicate) {
 
 std::vector<EntityID> EntityCollection::Filter(const Predicate& predicate) const noexcept {
   std::vector<EntityID> total_ids{};
-  for (const auto& [id, entity] : inner_entities_) {
-    if (predicate(entity.GetComponents())) {
-      total_ids.push_back(id);
+  for (const auto& table : tables_) {
+    for (std::size_t row = 0; row < table->Size(); ++row) {
+      if (predicate(ConstEntityRef{*table, row})) {
+        total_ids.push_back(table->EntityAt(row));
+      }
+    }
+  }
+  return total_ids;
+}
+
+std::size_t EntityCollection::CountIf(const Predicate& predicate, JobSystem& jobs) const {
+  std::vector<ChunkRange> chunks = CollectChunks(tables_);
+  return jobs.ParallelReduce(
+      chunks.size(), 1, std::size_t{0},
+      [&chunks, &predicate](std::size_t chunk_index, std::size_t) {
+        const ChunkRange& chunk = chunks[chunk_index];
+        std::size_t counter = 0;
+        for (std::size_t row = chunk.begin; row < chunk.end; ++row) {
+          if (predicate(ConstEntityRef{*chunk.table, row})) {
+            counter++;
+          }
+        }
+        return counter;
+      },
+      [](std::size_t accumulated, std::size_t partial) { return accumulated + partial; });
+}
+
+std::vector<EntityID> EntityCollection::Filter(const Predicate& predicate, JobSystem& jobs) const {
+  std::vector<ChunkRange> chunks = CollectChunks(tables_);
+  std::vector<std::vector<EntityID>> chunk_ids(chunks.size());
+  jobs.ParallelFor(chunks.size(), 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t chunk_index = begin; chunk_index < end; ++chunk_index) {
+      const ChunkRange& chunk = chunks[chunk_index];
+      for (std::size_t row = chunk.begin; row < chunk.end; ++row) {
+        if (predicate(ConstEntityRef{*chunk.table, row})) {
+          chunk_ids[chunk_index].push_back(chunk.table->EntityAt(row));
+        }
+      }
     }
+  });
+
+  std::size_t total_size = 0;
+  for (const auto& ids : chunk_ids) {
+    total_size += ids.size();
+  }
+  std::vector<EntityID> total_ids;
+  total_ids.reserve(total_size);
+  for (const auto& ids : chunk_ids) {
+    total_ids.insert(total_ids.end(), ids.begin(), ids.end());
   }
   return total_ids;
 }
 
+EntityID EntityCollection::GetParent(const EntityID& entity_id) const noexcept {
+  return ids_.IsAlive(entity_id) ? hierarchy_.GetParent(entity_id) : EntityID::GetRootID();
+}
+
+bool EntityCollection::SetParent(const EntityID& entity_id, const EntityID& parent_id) {
+  ENGINE_PROFILE_ZONE("EntityCollection::SetParent");
+  if (!ids_.IsAlive(entity_id) || (parent_id != EntityID::GetRootID() && !ids_.IsAlive(parent_id))) {
+    return false;
+  }
+  if (!hierarchy_.SetParent(entity_id, parent_id)) {
+    return false;
+  }
+  structure_tick_ = GetChangeTick();
+  return true;
+}
+
+std::size_t EntityCollection::GetDepth(const EntityID& entity_id) const noexcept {
+  return ids_.IsAlive(entity_id) ? hierarchy_.GetDepth(entity_id) : 0;
+}
+
+const EntityHierarchy& EntityCollection::GetHierarchy() const noexcept { return hierarchy_; }
+
 bool EntityCollection::Contains(const EntityID& entity_id) const noexcept {
-  return inner_entities_.contains(entity_id);
-}
\ No newline at end of file
+  return ids_.IsAlive(entity_id);
+}
+
+std::size_t EntityCollection::TableCount() const noexcept { return tables_.size(); }
+
+std::size_t EntityCollection::GetTableGeneration() const noexcept { return table_generation_; }
+
+ArchetypeTable& EntityCollection::GetTable(std::size_t table_index) noexcept { return *tables_[table_index]; }
+
+const ArchetypeTable& EntityCollection::GetTable(std::size_t table_index) const noexcept {
+  return *tables_[table_index];
+}
+
+Entity* EntityCollection::FindEntity(const EntityID& entity_id) noexcept {
+  return ids_.IsAlive(entity_id) ? &inner_entities_[entity_id.GetIndex()] : nullptr;
+}
+
+const Entity* EntityCollection::FindEntity(const EntityID& entity_id) const noexcept {
+  return ids_.IsAlive(entity_id) ? &inner_entities_[entity_id.GetIndex()] : nullptr;
+}
+
+std::size_t EntityCollection::FindOrCreateTable(const ComponentSignature& signature) {
+  auto iter = table_indices_.find(signature);
+  if (iter != table_indices_.end()) {
+    return iter->second;
+  }
+  std::size_t table_index = tables_.size();
+  tables_.push_back(std::make_unique<ArchetypeTable>(signature, *arena_, *change_tick_));
+  table_indices_.emplace(signature, table_index);
+  return table_index;
+}
+
+EntityCollection::TableEdges& EntityCollection::GetTableEdges(std::size_t table_index) {
+  if (table_index >= table_edges_.size()) {
+    table_edges_.resize(tables_.size());
+  }
+  std::unique_ptr<TableEdges>& edges = table_edges_[table_index];
+  if (edges == nullptr) {
+    edges = std::make_unique<TableEdges>();
+    edges->added.fill(kNoEdge);
+    edges->removed.fill(kNoEdge);
+  }
+  return *edges;
+}
+
+std::size_t EntityCollection::FindOrCreateNeighbor(std::size_t table_index, ComponentTypeID type_id, bool is_added) {
+  // Edges are heap-allocated, so the reference survives the creation of tables and of their edges below.
+  TableEdges& edges = GetTableEdges(table_index);
+  std::uint32_t& edge = (is_added ? edges.added : edges.removed)[type_id];
+  if (edge == kNoEdge) {
+    ComponentSignature signature = tables_[table_index]->Signature();
+    if (is_added) {
+      signature.Set(type_id);
+    } else {
+      signature.Reset(type_id);
+    }
+    std::size_t neighbor = FindOrCreateTable(signature);
+    edge = static_cast<std::uint32_t>(neighbor);
+    TableEdges& neighbor_edges = GetTableEdges(neighbor);
+    (is_added ? neighbor_edges.removed : neighbor_edges.added)[type_id] = static_cast<std::uint32_t>(table_index);
+  }
+  return edge;
+}
+
+std::size_t EntityCollection::FindOrCreateDestination(std::size_t table_index, const ComponentSignature& signature) {
+  const ComponentSignature& current = tables_[table_index]->Signature();
+  ComponentSignature added = signature - current;
+  ComponentSignature removed = current - signature;
+  if (added.Count() + removed.Count() != 1) {
+    return FindOrCreateTable(signature);
+  }
+  ComponentTypeID type_id{};
+  (added | removed).ForEach([&type_id](ComponentTypeID changed_id) { type_id = changed_id; });
+  return FindOrCreateNeighbor(table_index, type_id, !added.Empty());
+}
+
+EntityID EntityCollection::InsertRow(const ComponentSignature& signature, const EntityID& parent_id) {
+  std::size_t table_index = FindOrCreateTable(signature);
+  EntityID valid_parent_id = ids_.IsAlive(parent_id) ? parent_id : EntityID::GetRootID();
+  EntityID new_id = ids_.Allocate();
+  std::size_t row = tables_[table_index]->PushBack(new_id);
+  structure_tick_ = GetChangeTick();
+
+  if (new_id.GetIndex() >= inner_entities_.size()) {
+    inner_entities_.resize(new_id.GetIndex() + 1);
+  }
+  inner_entities_[new_id.GetIndex()].SetLocation({table_index, row});
+  hierarchy_.Insert(new_id, valid_parent_id);
+  return new_id;
+}
+
+EntityLocation EntityCollection::InsertRows(std::size_t count, const ComponentSignature& signature,
+                                           const EntityID& parent_id) {
+  std::size_t table_index = FindOrCreateTable(signature);
+  EntityID valid_parent_id = ids_.IsAlive(parent_id) ? parent_id : EntityID::GetRootID();
+  std::vector<EntityID>& new_ids = inserted_ids_;
+  new_ids.resize(count);
+  for (auto& new_id : new_ids) {
+    new_id = ids_.Allocate();
+  }
+  std::size_t first_row = tables_[table_index]->PushBack(new_ids);
+  structure_tick_ = GetChangeTick();
+
+  std::size_t slot_count = inner_entities_.size();
+  for (const auto& new_id : new_ids) {
+    slot_count = std::max<std::size_t>(slot_count, new_id.GetIndex() + 1);
+  }
+  inner_entities_.resize(slot_count);
+  for (std::size_t i = 0; i < count; ++i) {
+    inner_entities_[new_ids[i].GetIndex()].SetLocation({table_index, first_row + i});
+    hierarchy_.Insert(new_ids[i], valid_parent_id);
+  }
+  return {table_index, first_row};
+}
+
+EntityLocation EntityCollection::MoveEntity(Entity& entity, std::size_t table_index) {
+  EntityLocation old_location = entity.GetLocation();
+  EntityLocation new_location{table_index, 0};
+  const ArchetypeTable& old_table = *tables_[old_location.table];
+  Tick tick = GetChangeTick();
+  const ComponentSignature& signature = tables_[table_index]->Signature();
+  (old_table.Signature() - signature).ForEach([this, &old_table, &old_location, tick](ComponentTypeID type_id) {
+    removed_components_.push_back({old_table.EntityAt(old_location.row), type_id, tick});
+  });
+  new_location.row = tables_[old_location.table]->MoveRow(old_location.row, *tables_[new_location.table]);
+  structure_tick_ = tick;
+  entity.SetLocation(new_location);
+  RefreshLocation(old_location);
+  return new_location;
+}
+
+ComponentCollection EntityCollection::CopyRow(const EntityLocation& location) const {
+  ComponentCollection copied_data;
+  const ArchetypeTable& table = *tables_[location.table];
+  table.Signature().ForEach([&copied_data, &table, &location](ComponentTypeID type_id) {
+    // Tags have no column and are copied from their descriptor alone.
+    std::size_t column = table.FindColumn(type_id);
+    const void* source = column == ArchetypeTable::kNoColumn ? nullptr : table.At(column, location.row);
+    copied_data.EmplaceCopy(*ComponentInfo::Find(type_id), source);
+  });
+  return copied_data;
+}
+
+void EntityCollection::RemoveRow(const EntityLocation& location) {
+  tables_[location.table]->SwapRemove(location.row);
+  structure_tick_ = GetChangeTick();
+  RefreshLocation(location);
+}
+
+void EntityCollection::RefreshLocation(const EntityLocation& location) {
+  const ArchetypeTable& table = *tables_[location.table];
+  if (location.row < table.Size()) {
+    inner_entities_[table.EntityAt(location.row).GetIndex()].SetLocation(location);
+  }
+}
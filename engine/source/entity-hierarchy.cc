@@ -0,0 +1,136 @@
+#include "ecs/entity-hierarchy.h"
+
+#include <cstddef>
+#include <cstdint>
+using engine::ecs::EntityHierarchy;
+
+#include "ecs/entity-id.h"
+using engine::ecs::EntityID;
+
+void EntityHierarchy::Insert(const EntityID& entity_id, const EntityID& parent_id) {
+  std::uint32_t index = entity_id.GetIndex();
+  if (index >= nodes_.size()) {
+    nodes_.resize(static_cast<std::size_t>(index) + 1);
+  }
+  nodes_[index] = Node{.id = entity_id};
+  Link(index, parent_id == EntityID::GetRootID() ? kNoIndex : parent_id.GetIndex());
+}
+
+void EntityHierarchy::Remove(const EntityID& entity_id) {
+  std::uint32_t index = entity_id.GetIndex();
+  Unlink(index);
+  std::uint32_t child = nodes_[index].first_child;
+  while (child != kNoIndex) {
+    std::uint32_t next = nodes_[child].next;
+    nodes_[child].previous = kNoIndex;
+    nodes_[child].next = kNoIndex;
+    Link(child, kNoIndex);
+    UpdateDepths(child);
+    child = next;
+  }
+  nodes_[index].first_child = kNoIndex;
+}
+
+bool EntityHierarchy::SetParent(const EntityID& entity_id, const EntityID& parent_id) {
+  std::uint32_t index = entity_id.GetIndex();
+  std::uint32_t parent = kNoIndex;
+  if (parent_id != EntityID::GetRootID()) {
+    parent = parent_id.GetIndex();
+    if (parent == index || IsAncestorOf(entity_id, parent_id)) {
+      return false;
+    }
+  }
+  Unlink(index);
+  Link(index, parent);
+  UpdateDepths(index);
+  return true;
+}
+
+void EntityHierarchy::Clear() noexcept {
+  nodes_.clear();
+  first_root_ = kNoIndex;
+}
+
+std::size_t EntityHierarchy::BytesReserved() const noexcept { return nodes_.capacity() * sizeof(Node); }
+
+EntityID EntityHierarchy::GetParent(const EntityID& entity_id) const noexcept {
+  std::uint32_t parent = nodes_[entity_id.GetIndex()].parent;
+  return parent == kNoIndex ? EntityID::GetRootID() : nodes_[parent].id;
+}
+
+EntityID EntityHierarchy::GetFirstChild(const EntityID& entity_id) const noexcept {
+  std::uint32_t child = nodes_[entity_id.GetIndex()].first_child;
+  return child == kNoIndex ? EntityID::GetRootID() : nodes_[child].id;
+}
+
+EntityID EntityHierarchy::GetNextSibling(const EntityID& entity_id) const noexcept {
+  std::uint32_t next = nodes_[entity_id.GetIndex()].next;
+  return next == kNoIndex ? EntityID::GetRootID() : nodes_[next].id;
+}
+
+std::size_t EntityHierarchy::GetDepth(const EntityID& entity_id) const noexcept {
+  return nodes_[entity_id.GetIndex()].depth;
+}
+
+bool EntityHierarchy::IsAncestorOf(const EntityID& ancestor_id, const EntityID& entity_id) const noexcept {
+  for (std::uint32_t index = nodes_[entity_id.GetIndex()].parent; index != kNoIndex; index = nodes_[index].parent) {
+    if (nodes_[index].id == ancestor_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EntityHierarchy::Link(std::uint32_t index, std::uint32_t parent) noexcept {
+  Node& node = nodes_[index];
+  std::uint32_t& head = parent == kNoIndex ? first_root_ : nodes_[parent].first_child;
+  node.parent = parent;
+  node.previous = kNoIndex;
+  node.next = head;
+  node.depth = parent == kNoIndex ? 0 : nodes_[parent].depth + 1;
+  if (head != kNoIndex) {
+    nodes_[head].previous = index;
+  }
+  head = index;
+}
+
+void EntityHierarchy::Unlink(std::uint32_t index) noexcept {
+  Node& node = nodes_[index];
+  if (node.previous != kNoIndex) {
+    nodes_[node.previous].next = node.next;
+  } else if (node.parent != kNoIndex) {
+    nodes_[node.parent].first_child = node.next;
+  } else {
+    first_root_ = node.next;
+  }
+  if (node.next != kNoIndex) {
+    nodes_[node.next].previous = node.previous;
+  }
+  node.parent = kNoIndex;
+  node.previous = kNoIndex;
+  node.next = kNoIndex;
+}
+
+void EntityHierarchy::UpdateDepths(std::uint32_t index) noexcept {
+  for (std::uint32_t current = NextInSubtree(index, index); current != kNoIndex;
+       current = NextInSubtree(current, index)) {
+    nodes_[current].depth = nodes_[nodes_[current].parent].depth + 1;
+  }
+}
+
+std::uint32_t EntityHierarchy::NextInSubtree(std::uint32_t index, std::uint32_t subtree) const noexcept {
+  if (nodes_[index].first_child != kNoIndex) {
+    return nodes_[index].first_child;
+  }
+  return NextAfterDescendants(index, subtree);
+}
+
+std::uint32_t EntityHierarchy::NextAfterDescendants(std::uint32_t index, std::uint32_t subtree) const noexcept {
+  while (index != subtree) {
+    if (nodes_[index].next != kNoIndex) {
+      return nodes_[index].next;
+    }
+    index = nodes_[index].parent;
+  }
+  return kNoIndex;
+}
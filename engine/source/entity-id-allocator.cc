@@ -0,0 +1,79 @@
+#include "ecs/entity-id-allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+using engine::ecs::EntityIDAllocator;
+
+#include "ecs/entity-id.h"
+using engine::ecs::EntityID;
+
+std::size_t EntityIDAllocator::Size() const noexcept { return alive_count_; }
+
+std::size_t EntityIDAllocator::Capacity() const noexcept { return slots_.size(); }
+
+std::size_t EntityIDAllocator::BytesReserved() const noexcept {
+  return slots_.capacity() * sizeof(Slot) + free_indices_.capacity() * sizeof(std::uint32_t);
+}
+
+EntityID EntityIDAllocator::Allocate() {
+  std::uint32_t index = 0;
+  if (free_indices_.empty()) {
+    index = static_cast<std::uint32_t>(slots_.size());
+    slots_.emplace_back();
+  } else {
+    index = free_indices_.back();
+    free_indices_.pop_back();
+  }
+  Slot& slot = slots_[index];
+  slot.is_alive = true;
+  ++alive_count_;
+  return {index, slot.generation};
+}
+
+bool EntityIDAllocator::Release(const EntityID& id) {
+  if (!IsAlive(id)) {
+    return false;
+  }
+  Slot& slot = slots_[id.GetIndex()];
+  slot.is_alive = false;
+  ++slot.generation;
+  free_indices_.push_back(id.GetIndex());
+  --alive_count_;
+  return true;
+}
+
+bool EntityIDAllocator::IsAlive(const EntityID& id) const noexcept {
+  std::uint32_t index = id.GetIndex();
+  return index < slots_.size() && slots_[index].is_alive && slots_[index].generation == id.GetGeneration();
+}
+
+void EntityIDAllocator::Clear() {
+  free_indices_.clear();
+  for (std::size_t index = slots_.size(); index-- > 0;) {
+    Slot& slot = slots_[index];
+    if (slot.is_alive) {
+      slot.is_alive = false;
+      ++slot.generation;
+    }
+    free_indices_.push_back(static_cast<std::uint32_t>(index));
+  }
+  alive_count_ = 0;
+}
+
+std::uint32_t EntityIDAllocator::GetGeneration(std::uint32_t index) const noexcept { return slots_[index].generation; }
+
+std::span<const std::uint32_t> EntityIDAllocator::GetFreeIndices() const noexcept { return free_indices_; }
+
+void EntityIDAllocator::Restore(std::span<const std::uint32_t> generations,
+                                std::span<const std::uint32_t> free_indices) {
+  slots_.resize(generations.size());
+  for (std::size_t index = 0; index < generations.size(); ++index) {
+    slots_[index] = Slot{.generation = generations[index], .is_alive = true};
+  }
+  free_indices_.assign(free_indices.begin(), free_indices.end());
+  for (std::uint32_t index : free_indices_) {
+    slots_[index].is_alive = false;
+  }
+  alive_count_ = slots_.size() - free_indices_.size();
+}
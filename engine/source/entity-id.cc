@@ -1,30 +1,13 @@
 #include "ecs/entity-id.h"
 
-#include <chrono>
 #include <cstddef>
-#include <functional>
-#include <sstream>
-#include <thread>
+#include <cstdint>
 using engine::ecs::EntityID;
 
-EntityID::EntityID() {
-  std::stringstream stream;
-  stream << std::this_thread::get_id();
-  stream << ".";
-
-  auto now = std::chrono::high_resolution_clock::now();
-  auto duration = now.time_since_epoch();
-  stream << std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
-
-  inner_data_ = stream.str();
-}
-
-EntityID EntityID::GetRootID() noexcept {
-  EntityID root_id;
-  root_id.inner_data_.clear();
-  return root_id;
-}
-
 std::size_t EntityID::Hash::operator()(const EntityID& id) const noexcept {
-  return std::hash<std::string>{}(id.inner_data_);
-}
\ No newline at end of file
+  // Finalizer of SplitMix64: spreads the index and the generation over all bits of the hash.
+  std::uint64_t value = id.inner_data_;
+  value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+  return static_cast<std::size_t>(value ^ (value >> 31U));
+}
@@ -0,0 +1,126 @@
+#include "jobs/job-system.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+using engine::jobs::Job;
+using engine::jobs::JobCounter;
+using engine::jobs::JobSystem;
+
+namespace {
+
+thread_local const JobSystem* current_system = nullptr;  // Job system the calling thread is a worker of.
+thread_local std::size_t current_queue_index = 0;         // Queue owned by the calling worker.
+
+constexpr std::size_t kSharedQueueIndex = 0;
+
+}  // namespace
+
+JobSystem::JobSystem(std::size_t worker_count) {
+  queues_.reserve(worker_count + 1);
+  for (std::size_t i = 0; i <= worker_count; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  workers_.reserve(worker_count);
+  for (std::size_t i = 1; i <= worker_count; ++i) {
+    workers_.emplace_back([this, i] { RunWorker(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  while (TryRunOne(CurrentQueueIndex())) {
+  }
+  {
+    std::lock_guard lock(sleep_mutex_);
+    is_stopping_.store(true, std::memory_order_release);
+  }
+  wake_up_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::size_t JobSystem::DefaultWorkerCount() noexcept {
+  unsigned int hardware_threads = std::thread::hardware_concurrency();
+  return hardware_threads > 1 ? hardware_threads - 1 : 0;
+}
+
+std::size_t JobSystem::WorkerCount() const noexcept { return workers_.size(); }
+
+void JobSystem::Schedule(JobCounter& counter, Job job) {
+  counter.pending_.fetch_add(1, std::memory_order_relaxed);
+  Job counted_job = [&counter, job = std::move(job)] {
+    job();
+    counter.pending_.fetch_sub(1, std::memory_order_acq_rel);
+  };
+
+  Queue& queue = *queues_[CurrentQueueIndex()];
+  {
+    std::lock_guard lock(queue.mutex);
+    queue.jobs.push_back(std::move(counted_job));
+  }
+  {
+    std::lock_guard lock(sleep_mutex_);
+    queued_.fetch_add(1, std::memory_order_release);
+  }
+  wake_up_.notify_one();
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+  std::size_t queue_index = CurrentQueueIndex();
+  while (!counter.IsDone()) {
+    if (!TryRunOne(queue_index)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobSystem::RunWorker(std::size_t queue_index) {
+  current_system = this;
+  current_queue_index = queue_index;
+  while (true) {
+    if (TryRunOne(queue_index)) {
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    wake_up_.wait(lock, [this] {
+      return queued_.load(std::memory_order_acquire) > 0 || is_stopping_.load(std::memory_order_acquire);
+    });
+    if (queued_.load(std::memory_order_acquire) == 0 && is_stopping_.load(std::memory_order_acquire)) {
+      return;
+    }
+  }
+}
+
+bool JobSystem::TryRunOne(std::size_t queue_index) {
+  Job job;
+  {
+    Queue& own_queue = *queues_[queue_index];
+    std::lock_guard lock(own_queue.mutex);
+    if (!own_queue.jobs.empty()) {
+      job = std::move(own_queue.jobs.back());
+      own_queue.jobs.pop_back();
+    }
+  }
+  for (std::size_t offset = 1; !job && offset < queues_.size(); ++offset) {
+    Queue& victim = *queues_[(queue_index + offset) % queues_.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.jobs.empty()) {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+    }
+  }
+  if (!job) {
+    return false;
+  }
+
+  queued_.fetch_sub(1, std::memory_order_acq_rel);
+  job();
+  return true;
+}
+
+std::size_t JobSystem::CurrentQueueIndex() const noexcept {
+  return current_system == this ? current_queue_index : kSharedQueueIndex;
+}
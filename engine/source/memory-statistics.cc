@@ -0,0 +1,57 @@
+#include "ecs/memory-statistics.h"
+
+#include <cstddef>
+#include <ostream>
+using engine::ecs::ArchetypeMemoryStatistics;
+using engine::ecs::MemoryStatistics;
+
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+using engine::ecs::ComponentMemoryStatistics;
+using engine::ecs::ComponentTypeID;
+
+double ArchetypeMemoryStatistics::Occupancy() const noexcept {
+  std::size_t row_capacity = chunk_count * chunk_capacity;
+  return row_capacity == 0 ? 1.0 : static_cast<double>(entity_count) / static_cast<double>(row_capacity);
+}
+
+std::size_t MemoryStatistics::TotalBytes() const noexcept {
+  return arena_reserved_bytes + adopted_bytes + table_bytes + hierarchy_bytes + id_bytes + other_bytes;
+}
+
+std::size_t MemoryStatistics::FragmentationBytes() const noexcept {
+  return arena_reserved_bytes - arena_used_bytes + chunk_bytes - component_bytes;
+}
+
+void engine::ecs::WriteMemoryStatistics(std::ostream& output, const MemoryStatistics& statistics) {
+  output << "{\"entities\":" << statistics.entity_count << ",\"total_bytes\":" << statistics.TotalBytes()
+         << ",\"fragmentation_bytes\":" << statistics.FragmentationBytes()
+         << ",\"chunk_bytes\":" << statistics.chunk_bytes << ",\"component_bytes\":" << statistics.component_bytes
+         << ",\"table_bytes\":" << statistics.table_bytes << ",\"hierarchy_bytes\":" << statistics.hierarchy_bytes
+         << ",\"id_bytes\":" << statistics.id_bytes << ",\"other_bytes\":" << statistics.other_bytes
+         << ",\"arena_reserved_bytes\":" << statistics.arena_reserved_bytes
+         << ",\"arena_used_bytes\":" << statistics.arena_used_bytes
+         << ",\"adopted_bytes\":" << statistics.adopted_bytes << ",\"components\":[";
+  const char* separator = "";
+  for (const ComponentMemoryStatistics& component : statistics.components) {
+    output << separator << "{\"type_id\":" << component.info->id << ",\"count\":" << component.count
+           << ",\"bytes\":" << component.bytes << ",\"tick_bytes\":" << component.tick_bytes << "}";
+    separator = ",";
+  }
+  output << "],\"archetypes\":[";
+  separator = "";
+  for (const ArchetypeMemoryStatistics& archetype : statistics.archetypes) {
+    output << separator << "{\"type_ids\":[";
+    const char* id_separator = "";
+    archetype.signature.ForEach([&](ComponentTypeID type_id) {
+      output << id_separator << type_id;
+      id_separator = ",";
+    });
+    output << "],\"entities\":" << archetype.entity_count << ",\"chunks\":" << archetype.chunk_count
+           << ",\"chunk_capacity\":" << archetype.chunk_capacity << ",\"chunk_bytes\":" << archetype.chunk_bytes
+           << ",\"component_bytes\":" << archetype.component_bytes
+           << ",\"metadata_bytes\":" << archetype.metadata_bytes << "}";
+    separator = ",";
+  }
+  output << "]}";
+}
\ No newline at end of file
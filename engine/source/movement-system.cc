@@ -0,0 +1,170 @@
+#include "ecs/movement-system.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+using engine::ecs::MovementSystem;
+using engine::ecs::SimdLevel;
+
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/movement.h"
+#include "ecs/query.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Position;
+using engine::ecs::Query;
+using engine::ecs::Velocity;
+using engine::ecs::With;
+using engine::ecs::Without;
+
+#include "jobs/job-system.h"
+using engine::jobs::JobSystem;
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ENGINE_MOVEMENT_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Advances `count` floats of positions by the matching floats of velocities, one at a time.
+ */
+void IntegrateScalar(float* positions, const float* velocities, std::size_t count, float time_step) noexcept {
+  for (std::size_t i = 0; i < count; ++i) {
+    positions[i] += velocities[i] * time_step;
+  }
+}
+
+/**
+ * @brief Computes the number of floats to process one at a time before the positions are aligned for vector stores.
+ */
+std::size_t CountUnaligned(const float* positions, std::size_t count, std::size_t alignment) noexcept {
+  auto misalignment = reinterpret_cast<std::uintptr_t>(positions) % alignment;
+  std::size_t prologue = misalignment == 0 ? 0 : (alignment - misalignment) / sizeof(float);
+  return prologue < count ? prologue : count;
+}
+
+#ifdef ENGINE_MOVEMENT_X86
+
+__attribute__((target("sse"))) void IntegrateSse(float* positions, const float* velocities, std::size_t count,
+                                                 float time_step) noexcept {
+  constexpr std::size_t kWidth = 4;
+  std::size_t i = CountUnaligned(positions, count, kWidth * sizeof(float));
+  IntegrateScalar(positions, velocities, i, time_step);
+  __m128 step = _mm_set1_ps(time_step);
+  for (; i + kWidth <= count; i += kWidth) {
+    __m128 velocity = _mm_loadu_ps(velocities + i);
+    _mm_store_ps(positions + i, _mm_add_ps(_mm_load_ps(positions + i), _mm_mul_ps(velocity, step)));
+  }
+  IntegrateScalar(positions + i, velocities + i, count - i, time_step);
+}
+
+__attribute__((target("avx2"))) void IntegrateAvx2(float* positions, const float* velocities, std::size_t count,
+                                                   float time_step) noexcept {
+  constexpr std::size_t kWidth = 8;
+  std::size_t i = CountUnaligned(positions, count, kWidth * sizeof(float));
+  IntegrateScalar(positions, velocities, i, time_step);
+  __m256 step = _mm256_set1_ps(time_step);
+  // Two vectors per iteration keep both load ports busy; the chunks are small enough that the loop stays in cache.
+  for (; i + 2 * kWidth <= count; i += 2 * kWidth) {
+    __m256 first = _mm256_mul_ps(_mm256_loadu_ps(velocities + i), step);
+    __m256 second = _mm256_mul_ps(_mm256_loadu_ps(velocities + i + kWidth), step);
+    _mm256_store_ps(positions + i, _mm256_add_ps(_mm256_load_ps(positions + i), first));
+    _mm256_store_ps(positions + i + kWidth, _mm256_add_ps(_mm256_load_ps(positions + i + kWidth), second));
+  }
+  for (; i + kWidth <= count; i += kWidth) {
+    __m256 velocity = _mm256_loadu_ps(velocities + i);
+    _mm256_store_ps(positions + i, _mm256_add_ps(_mm256_load_ps(positions + i), _mm256_mul_ps(velocity, step)));
+  }
+  IntegrateScalar(positions + i, velocities + i, count - i, time_step);
+}
+
+#endif
+
+bool IsSupported(SimdLevel level) noexcept {
+#ifdef ENGINE_MOVEMENT_X86
+  // Detection may run from a static initializer, before the runtime has read the CPU features on its own.
+  __builtin_cpu_init();
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return __builtin_cpu_supports("avx2") != 0;
+    case SimdLevel::kSse:
+      return __builtin_cpu_supports("sse") != 0;
+    case SimdLevel::kScalar:
+      return true;
+  }
+  return false;
+#else
+  return level == SimdLevel::kScalar;
+#endif
+}
+
+}  // namespace
+
+MovementSystem::MovementSystem(float time_step, JobSystem* jobs)
+    : System("Movement"), jobs_(jobs), time_step_(time_step), level_(DetectSimdLevel()) {
+  DeclareReads<Velocity>();
+  DeclareWrites<Position>();
+}
+
+void MovementSystem::Update(EntityCollection& entities) {
+  auto integrate = [this](std::span<const EntityID>, std::span<Position> positions,
+                          std::span<const Velocity> velocities) {
+    Integrate(positions, velocities, time_step_, level_);
+  };
+  Query<With<Position, const Velocity>, Without<>> query(entities, query_cache_);
+  if (jobs_ == nullptr) {
+    query.EachChunk(integrate);
+  } else {
+    query.ParEachChunk(*jobs_, integrate);
+  }
+}
+
+float MovementSystem::GetTimeStep() const noexcept { return time_step_; }
+
+void MovementSystem::SetTimeStep(float time_step) noexcept { time_step_ = time_step; }
+
+SimdLevel MovementSystem::GetSimdLevel() const noexcept { return level_; }
+
+void MovementSystem::SetSimdLevel(SimdLevel level) {
+  if (!IsSupported(level)) {
+    throw std::invalid_argument("MovementSystem::SetSimdLevel: the CPU does not support the instruction set");
+  }
+  level_ = level;
+}
+
+SimdLevel MovementSystem::DetectSimdLevel() noexcept {
+  static const SimdLevel kDetected = [] {
+    for (SimdLevel level : {SimdLevel::kAvx2, SimdLevel::kSse}) {
+      if (IsSupported(level)) {
+        return level;
+      }
+    }
+    return SimdLevel::kScalar;
+  }();
+  return kDetected;
+}
+
+void MovementSystem::Integrate(std::span<Position> positions, std::span<const Velocity> velocities, float time_step,
+                               SimdLevel level) noexcept {
+  // Both components are pairs of floats, so the columns are integrated as flat arrays of interleaved coordinates.
+  auto* position_floats = reinterpret_cast<float*>(positions.data());
+  const auto* velocity_floats = reinterpret_cast<const float*>(velocities.data());
+  std::size_t count = 2 * positions.size();
+  switch (level) {
+#ifdef ENGINE_MOVEMENT_X86
+    case SimdLevel::kAvx2:
+      IntegrateAvx2(position_floats, velocity_floats, count, time_step);
+      return;
+    case SimdLevel::kSse:
+      IntegrateSse(position_floats, velocity_floats, count, time_step);
+      return;
+#endif
+    default:
+      IntegrateScalar(position_floats, velocity_floats, count, time_step);
+      return;
+  }
+}
@@ -0,0 +1,150 @@
+#include "memory/pool-allocator.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+using engine::memory::PoolStatistics;
+using engine::memory::SizeClassPool;
+
+namespace {
+
+/**
+ * @brief Block sizes of the pools: steps of 16 bytes up to 256, then steps of a quarter of the power of two.
+ */
+constexpr std::array<std::size_t, 28> kSizeClasses{
+    16,  32,  48,  64,  80,  96,  112, 128, 144,  160,  176,  192,  208,  224,
+    240, 256, 320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+};
+
+/**
+ * @brief The pools of all size classes.
+ */
+struct PoolSet final {
+  PoolSet() noexcept : pools{MakePools(std::make_index_sequence<kSizeClasses.size()>{})} {}
+
+  template <std::size_t... Indices>
+  static std::array<SizeClassPool, kSizeClasses.size()> MakePools(std::index_sequence<Indices...>) noexcept {
+    return {SizeClassPool(kSizeClasses[Indices])...};
+  }
+
+  std::array<SizeClassPool, kSizeClasses.size()> pools;  ///< One pool per size class.
+  std::atomic<std::size_t> oversized_allocations{0};     ///< Requests forwarded to the global operator new.
+  std::atomic<std::size_t> oversized_deallocations{0};   ///< Oversized blocks given back.
+  std::atomic<std::size_t> oversized_bytes{0};           ///< Bytes of oversized requests.
+};
+
+/**
+ * @brief Retrieves the pools, which are never destroyed so that objects with static storage duration can release
+ * memory during program exit.
+ */
+PoolSet& GetPoolSet() noexcept {
+  static auto* pool_set = new PoolSet();
+  return *pool_set;
+}
+
+/**
+ * @brief Finds the pool that serves a request.
+ * @return A pointer to the pool, or nullptr if the request is forwarded to the global operator new.
+ */
+SizeClassPool* FindPool(std::size_t size, std::size_t alignment) noexcept {
+  if (alignment > SizeClassPool::kBlockAlignment || size > kSizeClasses.back()) {
+    return nullptr;
+  }
+  std::size_t index = 0;
+  while (kSizeClasses[index] < size) {
+    ++index;
+  }
+  return &GetPoolSet().pools[index];
+}
+
+}  // namespace
+
+SizeClassPool::SizeClassPool(std::size_t block_size) noexcept : block_size_(block_size) {}
+
+SizeClassPool::~SizeClassPool() {
+  while (slabs_ != nullptr) {
+    Slab* next = slabs_->next;
+    ::operator delete(slabs_);
+    slabs_ = next;
+  }
+}
+
+void* SizeClassPool::Allocate() {
+  std::lock_guard lock(mutex_);
+  if (free_list_ == nullptr) {
+    Grow();
+  }
+  FreeBlock* block = free_list_;
+  free_list_ = block->next;
+  statistics_.allocations++;
+  return block;
+}
+
+void SizeClassPool::Deallocate(void* block) noexcept {
+  std::lock_guard lock(mutex_);
+  auto* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = free_list_;
+  free_list_ = free_block;
+  statistics_.deallocations++;
+}
+
+std::size_t SizeClassPool::BlockSize() const noexcept { return block_size_; }
+
+PoolStatistics SizeClassPool::Statistics() const noexcept {
+  std::lock_guard lock(mutex_);
+  return statistics_;
+}
+
+void SizeClassPool::Grow() {
+  auto* memory = static_cast<std::byte*>(::operator new(kSlabSize));
+  statistics_.upstream_allocations++;
+  statistics_.upstream_bytes += kSlabSize;
+
+  auto* slab = ::new (memory) Slab{slabs_};
+  slabs_ = slab;
+  std::size_t block_count = (kSlabSize - sizeof(Slab)) / block_size_;
+  for (std::size_t i = block_count; i > 0; --i) {
+    auto* block = ::new (memory + sizeof(Slab) + (i - 1) * block_size_) FreeBlock{free_list_};
+    free_list_ = block;
+  }
+}
+
+void* engine::memory::Allocate(std::size_t size, std::size_t alignment) {
+  if (SizeClassPool* pool = FindPool(size, alignment)) {
+    return pool->Allocate();
+  }
+  PoolSet& pool_set = GetPoolSet();
+  pool_set.oversized_allocations.fetch_add(1, std::memory_order_relaxed);
+  pool_set.oversized_bytes.fetch_add(size, std::memory_order_relaxed);
+  return ::operator new(size, std::align_val_t{alignment});
+}
+
+void engine::memory::Deallocate(void* memory, std::size_t size, std::size_t alignment) noexcept {
+  if (SizeClassPool* pool = FindPool(size, alignment)) {
+    pool->Deallocate(memory);
+    return;
+  }
+  GetPoolSet().oversized_deallocations.fetch_add(1, std::memory_order_relaxed);
+  ::operator delete(memory, std::align_val_t{alignment});
+}
+
+PoolStatistics engine::memory::GetPoolStatistics() noexcept {
+  PoolSet& pool_set = GetPoolSet();
+  PoolStatistics total;
+  for (const auto& pool : pool_set.pools) {
+    PoolStatistics statistics = pool.Statistics();
+    total.allocations += statistics.allocations;
+    total.deallocations += statistics.deallocations;
+    total.upstream_allocations += statistics.upstream_allocations;
+    total.upstream_bytes += statistics.upstream_bytes;
+  }
+  std::size_t oversized_allocations = pool_set.oversized_allocations.load(std::memory_order_relaxed);
+  total.allocations += oversized_allocations;
+  total.deallocations += pool_set.oversized_deallocations.load(std::memory_order_relaxed);
+  total.upstream_allocations += oversized_allocations;
+  total.upstream_bytes += pool_set.oversized_bytes.load(std::memory_order_relaxed);
+  return total;
+}
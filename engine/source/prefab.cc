@@ -0,0 +1,58 @@
+#include "ecs/prefab.h"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+using engine::ecs::Prefab;
+
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+
+#include "ecs/entity-id.h"
+using engine::ecs::EntityID;
+
+Prefab::Prefab(ComponentCollection components) : components_(std::move(components)) {}
+
+Prefab Prefab::Capture(const EntityCollection& entities, const EntityID& entity_id) {
+  auto [components, was_copied] = entities.Copy(entity_id);
+  Prefab prefab(std::move(components));
+  if (was_copied) {
+    entities.GetHierarchy().ForEachChild(
+        entity_id, [&entities, &prefab](const EntityID& child_id) { prefab.AddChild(Capture(entities, child_id)); });
+  }
+  return prefab;
+}
+
+Prefab& Prefab::AddChild(Prefab child) { return children_.emplace_back(std::move(child)); }
+
+const ComponentCollection& Prefab::GetComponents() const noexcept { return components_; }
+
+const std::vector<Prefab>& Prefab::GetChildren() const noexcept { return children_; }
+
+std::vector<EntityID> Prefab::Instantiate(EntityCollection& entities, std::size_t count,
+                                          const EntityID& parent_id) const {
+  std::span<const EntityID> inserted = entities.InsertBatch(count, components_, parent_id);
+  std::vector<EntityID> instance_ids(inserted.begin(), inserted.end());
+  InstantiateChildren(entities, instance_ids);
+  return instance_ids;
+}
+
+void Prefab::InstantiateUnder(EntityCollection& entities, std::span<const EntityID> parent_ids) const {
+  // The rows are copied in one batch; only the links to the distinct parents are made one by one.
+  std::span<const EntityID> inserted = entities.InsertBatch(parent_ids.size(), components_);
+  std::vector<EntityID> instance_ids(inserted.begin(), inserted.end());
+  for (std::size_t i = 0; i < instance_ids.size(); ++i) {
+    entities.SetParent(instance_ids[i], parent_ids[i]);
+  }
+  InstantiateChildren(entities, instance_ids);
+}
+
+void Prefab::InstantiateChildren(EntityCollection& entities, std::span<const EntityID> instance_ids) const {
+  // New children are attached in front of their siblings, so the last child is instantiated first.
+  for (auto child = children_.rbegin(); child != children_.rend(); ++child) {
+    child->InstantiateUnder(entities, instance_ids);
+  }
+}
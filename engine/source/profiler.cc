@@ -0,0 +1,245 @@
+#include "profiling/profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+using engine::profiling::Profiler;
+using engine::profiling::ZoneSummary;
+
+namespace {
+
+/**
+ * @brief A slot of a ring. The fields are atomic because a reader may load them while the owner overwrites them.
+ */
+struct EventSlot final {
+  std::atomic<const char*> name{nullptr};  ///< Name of the zone.
+  std::atomic<std::uint64_t> start{0};     ///< Time at which the zone was entered.
+  std::atomic<std::uint64_t> end{0};       ///< Time at which the zone was left.
+};
+
+/**
+ * @brief The ring of events of a single thread.
+ *
+ * Only the owning thread writes. It announces every event in `started` before writing the slot, and publishes it in
+ * `published` afterwards, so a reader knows that the events it read are intact if none of their slots was reused
+ * since, according to `started`.
+ */
+struct ThreadRing final {
+  std::uint32_t thread_index{0};                           ///< Index of the thread in the trace.
+  std::atomic<std::uint64_t> started{0};                   ///< Number of events whose writing has begun.
+  std::atomic<std::uint64_t> published{0};                 ///< Number of events fully written.
+  std::atomic<std::uint64_t> first_kept{0};                ///< Number of events dropped by Profiler::Clear().
+  std::array<EventSlot, Profiler::kThreadCapacity> slots;  ///< Events, indexed by their number modulo the capacity.
+};
+
+/**
+ * @brief An event copied out of a ring.
+ */
+struct Event final {
+  const char* name;            ///< Name of the zone.
+  std::uint64_t start;         ///< Time at which the zone was entered.
+  std::uint64_t end;           ///< Time at which the zone was left.
+  std::uint32_t thread_index;  ///< Index of the thread that recorded it.
+};
+
+/**
+ * @brief The rings of every thread that recorded a zone, and the interned names.
+ */
+struct Registry final {
+  std::mutex mutex;                                ///< Guards the members below.
+  std::vector<std::unique_ptr<ThreadRing>> rings;  ///< Rings, in order of creation.
+  std::set<std::string, std::less<>> names;        ///< Interned names.
+};
+
+Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+/**
+ * @brief Retrieves the ring of the calling thread, creating it on the first call.
+ * @return The ring, or nullptr if it could not be allocated.
+ */
+ThreadRing* GetThreadRing() noexcept {
+  thread_local ThreadRing* ring = nullptr;
+  if (ring == nullptr) {
+    try {
+      Registry& registry = GetRegistry();
+      std::lock_guard lock(registry.mutex);
+      registry.rings.push_back(std::make_unique<ThreadRing>());
+      ring = registry.rings.back().get();
+      ring->thread_index = static_cast<std::uint32_t>(registry.rings.size() - 1);
+    } catch (...) {
+      return nullptr;
+    }
+  }
+  return ring;
+}
+
+/**
+ * @brief Copies the intact events of every ring.
+ */
+std::vector<Event> CollectEvents() {
+  std::vector<Event> events;
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  for (const auto& ring : registry.rings) {
+    std::uint64_t end = ring->published.load(std::memory_order_acquire);
+    std::uint64_t begin = std::max(ring->first_kept.load(std::memory_order_relaxed),
+                                   end > Profiler::kThreadCapacity ? end - Profiler::kThreadCapacity : 0);
+    std::size_t first_copied = events.size();
+    for (std::uint64_t index = begin; index < end; ++index) {
+      const EventSlot& slot = ring->slots[index % Profiler::kThreadCapacity];
+      events.push_back({slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                        slot.end.load(std::memory_order_relaxed), ring->thread_index});
+    }
+    // Slots reused while they were copied hold newer events; the events read from them are dropped.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t started = ring->started.load(std::memory_order_relaxed);
+    std::uint64_t first_intact = started > Profiler::kThreadCapacity ? started - Profiler::kThreadCapacity : 0;
+    if (first_intact > begin) {
+      auto dropped = static_cast<std::ptrdiff_t>(std::min(first_intact, end) - begin);
+      events.erase(events.begin() + static_cast<std::ptrdiff_t>(first_copied),
+                   events.begin() + static_cast<std::ptrdiff_t>(first_copied) + dropped);
+    }
+  }
+  return events;
+}
+
+/**
+ * @brief Computes a percentile of sorted durations with the nearest-rank method.
+ */
+std::chrono::nanoseconds Percentile(const std::vector<std::uint64_t>& sorted, std::size_t percent) {
+  std::size_t rank = (sorted.size() * percent + 99) / 100;
+  return std::chrono::nanoseconds(sorted[std::max<std::size_t>(rank, 1) - 1]);
+}
+
+void WriteJsonString(std::ostream& output, std::string_view text) {
+  output << '"';
+  for (char character : text) {
+    if (character == '"' || character == '\\') {
+      output << '\\' << character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(character));
+      output << escaped;
+    } else {
+      output << character;
+    }
+  }
+  output << '"';
+}
+
+}  // namespace
+
+const char* Profiler::Intern(std::string_view name) {
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  auto found = registry.names.find(name);
+  if (found == registry.names.end()) {
+    found = registry.names.emplace(name).first;
+  }
+  return found->c_str();
+}
+
+void Profiler::Record(const char* name, std::uint64_t start, std::uint64_t end) noexcept {
+  ThreadRing* ring_pointer = GetThreadRing();
+  if (ring_pointer == nullptr) {
+    return;
+  }
+  ThreadRing& ring = *ring_pointer;
+  std::uint64_t index = ring.started.load(std::memory_order_relaxed);
+  ring.started.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  EventSlot& slot = ring.slots[index % kThreadCapacity];
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.end.store(end, std::memory_order_relaxed);
+  ring.published.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::Clear() noexcept {
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  for (const auto& ring : registry.rings) {
+    ring->first_kept.store(ring->published.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+
+std::vector<ZoneSummary> Profiler::Summarize() {
+  // Equal names may be stored at different addresses, so durations are grouped by the text of the name.
+  std::map<std::string_view, std::vector<std::uint64_t>> durations;
+  for (const Event& event : CollectEvents()) {
+    durations[event.name].push_back(event.end - event.start);
+  }
+  std::vector<ZoneSummary> summaries;
+  summaries.reserve(durations.size());
+  for (auto& [name, zone_durations] : durations) {
+    std::sort(zone_durations.begin(), zone_durations.end());
+    ZoneSummary summary;
+    summary.name = name;
+    summary.count = zone_durations.size();
+    summary.p50 = Percentile(zone_durations, 50);
+    summary.p99 = Percentile(zone_durations, 99);
+    summary.max = std::chrono::nanoseconds(zone_durations.back());
+    summaries.push_back(std::move(summary));
+  }
+  return summaries;
+}
+
+void Profiler::WriteChromeTrace(std::ostream& output) {
+  std::vector<Event> events = CollectEvents();
+  std::sort(events.begin(), events.end(), [](const Event& lhs, const Event& rhs) { return lhs.start < rhs.start; });
+  std::uint32_t thread_count = 0;
+  for (const Event& event : events) {
+    thread_count = std::max(thread_count, event.thread_index + 1);
+  }
+
+  // Timestamps are microseconds since the first event; three decimals keep the nanoseconds.
+  std::uint64_t origin = events.empty() ? 0 : events.front().start;
+  char number[32];
+  output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool is_first = true;
+  for (std::uint32_t thread = 0; thread < thread_count; ++thread) {
+    output << (is_first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+           << ",\"args\":{\"name\":\"Thread " << thread << "\"}}";
+    is_first = false;
+  }
+  for (const Event& event : events) {
+    output << (is_first ? "" : ",") << "\n{\"name\":";
+    WriteJsonString(output, event.name);
+    std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.start - origin) / 1000.0);
+    output << ",\"cat\":\"engine\",\"ph\":\"X\",\"ts\":" << number;
+    std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.end - event.start) / 1000.0);
+    output << ",\"dur\":" << number << ",\"pid\":1,\"tid\":" << event.thread_index << "}";
+    is_first = false;
+  }
+  output << "\n]}\n";
+}
+
+void Profiler::WriteChromeTrace(const std::filesystem::path& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("Profiler::WriteChromeTrace: cannot open " + path.string());
+  }
+  WriteChromeTrace(static_cast<std::ostream&>(file));
+  if (!file.flush()) {
+    throw std::runtime_error("Profiler::WriteChromeTrace: cannot write " + path.string());
+  }
+}
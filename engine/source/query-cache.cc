@@ -0,0 +1,28 @@
+#include "ecs/query-cache.h"
+
+#include <cstddef>
+#include <span>
+using engine::ecs::QueryCache;
+
+#include "ecs/entity-collection.h"
+using engine::ecs::EntityCollection;
+
+void QueryCache::Update(const EntityCollection& entities, Matcher matcher) {
+  if (entities_ != &entities || table_generation_ != entities.GetTableGeneration() || matcher_ != matcher) {
+    entities_ = &entities;
+    table_generation_ = entities.GetTableGeneration();
+    matcher_ = matcher;
+    tested_table_count_ = 0;
+    table_indices_.clear();
+  }
+  for (; tested_table_count_ < entities.TableCount(); ++tested_table_count_) {
+    ++test_count_;
+    if (matcher(entities.GetTable(tested_table_count_).Signature())) {
+      table_indices_.push_back(tested_table_count_);
+    }
+  }
+}
+
+std::span<const std::size_t> QueryCache::GetTableIndices() const noexcept { return table_indices_; }
+
+std::size_t QueryCache::GetTestCount() const noexcept { return test_count_; }
@@ -0,0 +1,170 @@
+#include "ecs/scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+using engine::ecs::CriticalPath;
+using engine::ecs::Scheduler;
+
+#include "ecs/change-tick.h"
+#include "ecs/entity-collection.h"
+#include "ecs/system.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::System;
+using engine::ecs::Tick;
+
+#include "jobs/job-system.h"
+using engine::jobs::JobCounter;
+using engine::jobs::JobSystem;
+
+#include "profiling/profiler.h"
+using engine::profiling::Profiler;
+
+System& Scheduler::Add(std::unique_ptr<System> system) {
+  std::size_t index = nodes_.size();
+  Node node;
+  node.system = std::move(system);
+  node.zone_name = Profiler::Intern(node.system->GetName());
+  for (std::size_t predecessor = 0; predecessor < index; ++predecessor) {
+    if (nodes_[predecessor].system->ConflictsWith(*node.system)) {
+      nodes_[predecessor].successors.push_back(index);
+      node.predecessor_count++;
+    }
+  }
+  nodes_.push_back(std::move(node));
+  return *nodes_.back().system;
+}
+
+std::size_t Scheduler::Size() const noexcept { return nodes_.size(); }
+
+const System& Scheduler::GetSystem(std::size_t index) const noexcept { return *nodes_[index].system; }
+
+const std::vector<std::size_t>& Scheduler::GetSuccessors(std::size_t index) const noexcept {
+  return nodes_[index].successors;
+}
+
+void Scheduler::Run(EntityCollection& entities) {
+  ClearRemovedComponents(entities);
+  for (auto& node : nodes_) {
+    RunNode(node, entities);
+  }
+}
+
+void Scheduler::Run(EntityCollection& entities, JobSystem& jobs) {
+  ClearRemovedComponents(entities);
+  auto pending = std::make_unique<std::atomic<std::size_t>[]>(nodes_.size());
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    pending[index].store(nodes_[index].predecessor_count, std::memory_order_relaxed);
+  }
+
+  JobCounter counter;
+  // Successors are scheduled by the job of their last predecessor, before that job finishes, so the counter never
+  // drops to zero while systems are still waiting.
+  auto schedule = [&](auto& self, std::size_t index) -> void {
+    jobs.Schedule(counter, [&self, &entities, &pending, this, index] {
+      RunNode(nodes_[index], entities);
+      for (std::size_t successor : nodes_[index].successors) {
+        if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          self(self, successor);
+        }
+      }
+    });
+  };
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    if (nodes_[index].predecessor_count == 0) {
+      schedule(schedule, index);
+    }
+  }
+  jobs.Wait(counter);
+}
+
+std::chrono::nanoseconds Scheduler::GetLastDuration(std::size_t index) const noexcept {
+  return nodes_[index].last_duration;
+}
+
+CriticalPath Scheduler::GetCriticalPath() const {
+  if (nodes_.empty()) {
+    return {.systems = {}, .duration = std::chrono::nanoseconds::zero()};
+  }
+
+  // Registration order is a topological order, so the longest paths are computed in a single forward pass.
+  std::vector<std::chrono::nanoseconds> finish(nodes_.size(), std::chrono::nanoseconds::zero());
+  std::vector<std::size_t> previous(nodes_.size(), nodes_.size());
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    finish[index] += nodes_[index].last_duration;
+    for (std::size_t successor : nodes_[index].successors) {
+      if (previous[successor] == nodes_.size() || finish[index] > finish[successor]) {
+        finish[successor] = finish[index];
+        previous[successor] = index;
+      }
+    }
+  }
+
+  std::size_t last = static_cast<std::size_t>(std::max_element(finish.begin(), finish.end()) - finish.begin());
+  CriticalPath path{.systems = {}, .duration = finish[last]};
+  for (std::size_t index = last; index != nodes_.size(); index = previous[index]) {
+    path.systems.push_back(index);
+  }
+  std::reverse(path.systems.begin(), path.systems.end());
+  return path;
+}
+
+std::string Scheduler::ToDot() const {
+  CriticalPath path = GetCriticalPath();
+  std::vector<bool> is_critical(nodes_.size(), false);
+  for (std::size_t index : path.systems) {
+    is_critical[index] = true;
+  }
+
+  std::ostringstream dot;
+  dot << "digraph Scheduler {\n";
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    const Node& node = nodes_[index];
+    dot << "  s" << index << " [label=\"" << node.system->GetName() << "\\n"
+        << std::chrono::duration<double, std::micro>(node.last_duration).count() << " us\"";
+    if (is_critical[index]) {
+      dot << ", color=red, penwidth=2";
+    }
+    dot << "];\n";
+  }
+  for (std::size_t index = 0; index < nodes_.size(); ++index) {
+    for (std::size_t successor : nodes_[index].successors) {
+      dot << "  s" << index << " -> s" << successor;
+      auto position = std::find(path.systems.begin(), path.systems.end(), index);
+      if (position != path.systems.end() && std::next(position) != path.systems.end() &&
+          *std::next(position) == successor) {
+        dot << " [color=red, penwidth=2]";
+      }
+      dot << ";\n";
+    }
+  }
+  dot << "}\n";
+  return dot.str();
+}
+
+void Scheduler::RunNode(Node& node, EntityCollection& entities) {
+  ENGINE_PROFILE_ZONE(node.zone_name);
+  Tick tick = entities.AdvanceChangeTick();
+  auto start = std::chrono::steady_clock::now();
+  node.system->Update(entities);
+  node.system->last_run_tick_ = tick;
+  node.last_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
+
+void Scheduler::ClearRemovedComponents(EntityCollection& entities) const {
+  if (nodes_.empty()) {
+    return;
+  }
+  Tick oldest_tick = nodes_.front().system->GetLastRunTick();
+  for (const auto& node : nodes_) {
+    oldest_tick = std::min(oldest_tick, node.system->GetLastRunTick());
+  }
+  entities.ClearRemovedComponents(oldest_tick);
+}
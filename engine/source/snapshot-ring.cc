@@ -0,0 +1,146 @@
+#include "ecs/snapshot-ring.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+using engine::ecs::SnapshotRing;
+
+#include "ecs/archetype-table.h"
+#include "ecs/change-tick.h"
+#include "ecs/component-info.h"
+using engine::ecs::ArchetypeTable;
+using engine::ecs::ComponentInfo;
+using engine::ecs::Tick;
+
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+
+SnapshotRing::SnapshotRing(std::size_t capacity) : states_(std::max<std::size_t>(capacity, 1)) {}
+
+std::size_t SnapshotRing::Capacity() const noexcept { return states_.size(); }
+
+std::size_t SnapshotRing::Size() const noexcept { return size_; }
+
+void SnapshotRing::Clear() noexcept { size_ = 0; }
+
+std::size_t SnapshotRing::Save(EntityCollection& entities) {
+  for (const auto& table : entities.tables_) {
+    for (const ComponentInfo* info : table->Layout()) {
+      if (!info->is_trivial && !table->Empty()) {
+        throw std::invalid_argument("SnapshotRing::Save: the component type is not trivially copyable: " +
+                                    std::string(info->type.name()));
+      }
+    }
+  }
+
+  // The slot still holds an older state of the same collection, which only has to be brought up to date.
+  std::size_t slot = size_ == 0 ? newest_ : (newest_ + 1) % states_.size();
+  State& state = states_[slot];
+  Tick since = state.entities == &entities ? state.tick : 0;
+  if (entities.structure_tick_ > since) {
+    state.ids = entities.ids_;
+    state.inner_entities = entities.inner_entities_;
+    state.hierarchy = entities.hierarchy_;
+  }
+
+  std::size_t copied_count = 0;
+  state.tables.resize(entities.tables_.size());
+  for (std::size_t table_index = 0; table_index < entities.tables_.size(); ++table_index) {
+    const ArchetypeTable& table = *entities.tables_[table_index];
+    TableState& saved = state.tables[table_index];
+    Tick table_since = saved.signature == table.Signature() ? since : 0;
+    saved.signature = table.Signature();
+    saved.entity_ids.resize(table.Size());
+    saved.chunks.resize(table.ChunkBytes() * table.ChunkCount());
+    for (std::size_t chunk = 0; chunk < table.ChunkCount(); ++chunk) {
+      if (!IsChunkDirty(table, chunk, table_since)) {
+        continue;
+      }
+      std::size_t first_row = chunk * table.ChunkCapacity();
+      std::span<const EntityID> chunk_ids = std::span(table.Entities()).subspan(first_row, table.ChunkSize(chunk));
+      std::copy(chunk_ids.begin(), chunk_ids.end(), saved.entity_ids.begin() + static_cast<std::ptrdiff_t>(first_row));
+      std::byte* image = saved.chunks.data() + chunk * table.ChunkBytes();
+      for (std::size_t column = 0; column < table.Layout().size(); ++column) {
+        std::memcpy(image + table.ColumnOffset(column), table.ColumnData(column, chunk),
+                    chunk_ids.size() * table.Layout()[column]->size);
+      }
+      ++copied_count;
+    }
+  }
+
+  state.entities = &entities;
+  state.tick = entities.GetChangeTick();
+  entities.AdvanceChangeTick();
+  newest_ = slot;
+  size_ = std::min(size_ + 1, states_.size());
+  return copied_count;
+}
+
+bool SnapshotRing::Restore(EntityCollection& entities, std::size_t age) {
+  if (age >= size_) {
+    return false;
+  }
+  std::size_t slot = (newest_ + states_.size() - age) % states_.size();
+  const State& state = states_[slot];
+  if (state.entities != &entities || state.tables.size() > entities.tables_.size()) {
+    return false;
+  }
+  for (std::size_t table_index = 0; table_index < state.tables.size(); ++table_index) {
+    if (state.tables[table_index].signature != entities.tables_[table_index]->Signature()) {
+      return false;
+    }
+  }
+
+  if (entities.structure_tick_ > state.tick) {
+    entities.ids_ = state.ids;
+    entities.inner_entities_ = state.inner_entities;
+    entities.hierarchy_ = state.hierarchy;
+    entities.structure_tick_ = entities.GetChangeTick();
+  }
+  for (std::size_t table_index = 0; table_index < entities.tables_.size(); ++table_index) {
+    ArchetypeTable& table = *entities.tables_[table_index];
+    if (table_index >= state.tables.size() || state.tables[table_index].entity_ids.empty()) {
+      // Tables created after the save, or emptied then, may hold any component types.
+      if (!table.Empty()) {
+        table.Clear();
+      }
+      continue;
+    }
+    const TableState& saved = state.tables[table_index];
+    table.Resize(saved.entity_ids.size());
+    for (std::size_t chunk = 0; chunk < table.ChunkCount(); ++chunk) {
+      if (!IsChunkDirty(table, chunk, state.tick)) {
+        continue;
+      }
+      std::size_t first_row = chunk * table.ChunkCapacity();
+      std::size_t row_count = table.ChunkSize(chunk);
+      table.SetEntities(first_row, std::span(saved.entity_ids).subspan(first_row, row_count));
+      const std::byte* image = saved.chunks.data() + chunk * table.ChunkBytes();
+      for (std::size_t column = 0; column < table.Layout().size(); ++column) {
+        table.CopyRows(column, first_row, row_count, image + table.ColumnOffset(column));
+        table.MarkChanged(column, first_row, row_count);
+      }
+    }
+  }
+
+  newest_ = slot;
+  size_ -= age;
+  return true;
+}
+
+bool SnapshotRing::IsChunkDirty(const ArchetypeTable& table, std::size_t chunk_index, Tick since) noexcept {
+  if (table.ChunkRowsTick(chunk_index) > since) {
+    return true;
+  }
+  for (std::size_t column = 0; column < table.Layout().size(); ++column) {
+    if (table.ChunkTicks(column, chunk_index).changed > since) {
+      return true;
+    }
+  }
+  return false;
+}
\ No newline at end of file
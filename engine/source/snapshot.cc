@@ -0,0 +1,544 @@
+#include "ecs/snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using engine::ecs::Snapshot;
+using engine::ecs::SnapshotLoadMode;
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ecs/archetype-table.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+using engine::ecs::ArchetypeTable;
+using engine::ecs::ComponentInfo;
+using engine::ecs::ComponentSignature;
+using engine::ecs::ComponentTypeID;
+using engine::ecs::kChunkAlignment;
+using engine::ecs::kChunkSize;
+using engine::ecs::kMaxComponentTypes;
+using engine::ecs::kSnapshotVersion;
+
+#include "ecs/entity-collection.h"
+#include "ecs/entity-hierarchy.h"
+#include "ecs/entity-id.h"
+#include "ecs/entity.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityHierarchy;
+using engine::ecs::EntityID;
+using engine::ecs::EntityLocation;
+
+namespace {
+
+// The layout of an image. Records are made of 64-bit fields or pairs of 32-bit ones, so they have no padding;
+// every array starts at a multiple of its alignment, and every chunk image at a multiple of kChunkAlignment.
+constexpr std::array<char, 8> kMagic{'S', 'F', 'S', 'N', 'A', 'P', '\0', '\0'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+struct ImageHeader {
+  std::array<char, 8> magic{};
+  std::uint32_t version{0};
+  std::uint32_t byte_order{0};
+  std::uint64_t image_size{0};
+  std::uint64_t type_count{0};
+  std::uint64_t types_offset{0};  // TypeRecord[type_count]
+  std::uint64_t table_count{0};
+  std::uint64_t tables_offset{0};  // std::uint64_t[table_count], the offsets of the TableRecords
+  std::uint64_t slot_count{0};
+  std::uint64_t generations_offset{0};  // std::uint32_t[slot_count]
+  std::uint64_t free_count{0};
+  std::uint64_t free_offset{0};  // std::uint32_t[free_count]
+  std::uint64_t link_count{0};
+  std::uint64_t links_offset{0};  // LinkRecord[link_count]
+};
+
+struct TypeRecord {
+  std::uint64_t name_offset{0};
+  std::uint64_t name_size{0};
+  std::uint64_t size{0};
+  std::uint64_t alignment{0};
+  std::uint64_t is_tag{0};
+};
+
+struct TableRecord {
+  std::uint64_t type_count{0};
+  std::uint64_t types_offset{0};  // std::uint32_t[type_count], indices of TypeRecords
+  std::uint64_t column_count{0};
+  std::uint64_t columns_offset{0};  // ColumnRecord[column_count]
+  std::uint64_t row_count{0};
+  std::uint64_t entities_offset{0};  // EntityID[row_count]
+  std::uint64_t chunk_capacity{0};
+  std::uint64_t chunk_bytes{0};
+  std::uint64_t chunk_count{0};
+  std::uint64_t chunks_offset{0};  // std::byte[chunk_count][chunk_bytes]
+};
+
+struct ColumnRecord {
+  std::uint64_t type{0};
+  std::uint64_t offset{0};
+};
+
+// Parents are listed before their children, and siblings in reverse order, so that inserting the links one by one
+// into an EntityHierarchy, which prepends new children, rebuilds the saved order.
+struct LinkRecord {
+  EntityID entity;
+  EntityID parent;
+};
+
+static_assert(std::is_trivially_copyable_v<EntityID> && sizeof(EntityID) == sizeof(std::uint64_t));
+
+// What the validation of an image has learnt about a slot of the ID allocator.
+enum class SlotState : std::uint8_t {
+  kAlive,   // Not on the free list.
+  kFree,    // On the free list.
+  kStored,  // Alive, and the ID of a row of a table.
+  kLinked,  // Stored, and inserted into the hierarchy.
+};
+
+std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment) noexcept {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Appends zero-initialized, aligned blocks to a growing image.
+class ImageWriter {
+ public:
+  std::uint64_t Reserve(std::uint64_t size, std::uint64_t alignment) {
+    std::uint64_t offset = AlignUp(image_.size(), alignment);
+    image_.resize(offset + size);
+    return offset;
+  }
+
+  template <typename T>
+  std::uint64_t Append(std::span<const T> values) {
+    std::uint64_t offset = Reserve(values.size_bytes(), alignof(T));
+    Write(offset, values.data(), values.size_bytes());
+    return offset;
+  }
+
+  void Write(std::uint64_t offset, const void* source, std::size_t size) {
+    if (size != 0) {
+      std::memcpy(image_.data() + offset, source, size);
+    }
+  }
+
+  std::vector<std::byte> Release() && { return std::move(image_); }
+
+ private:
+  std::vector<std::byte> image_;
+};
+
+// Reads records out of an image with bounds checks and without alignment requirements.
+class ImageReader {
+ public:
+  explicit ImageReader(std::span<const std::byte> image) : image_(image) {}
+
+  std::size_t Size() const noexcept { return image_.size(); }
+
+  std::span<const std::byte> Bytes(std::uint64_t offset, std::uint64_t size) const {
+    if (offset > image_.size() || size > image_.size() - offset) {
+      throw std::invalid_argument("Snapshot::Load: the image is truncated or malformed");
+    }
+    return image_.subspan(offset, size);
+  }
+
+  template <typename T>
+  T Read(std::uint64_t offset) const {
+    T value;
+    std::memcpy(&value, Bytes(offset, sizeof(T)).data(), sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  std::vector<T> ReadArray(std::uint64_t offset, std::uint64_t count) const {
+    if (count > image_.size() / sizeof(T)) {
+      throw std::invalid_argument("Snapshot::Load: the image is truncated or malformed");
+    }
+    std::span<const std::byte> bytes = Bytes(offset, count * sizeof(T));
+    std::vector<T> values(count);
+    if (count != 0) {
+      std::memcpy(values.data(), bytes.data(), bytes.size());
+    }
+    return values;
+  }
+
+ private:
+  std::span<const std::byte> image_;
+};
+
+// A table of an image, validated and ready to be loaded.
+struct TableImage {
+  ComponentSignature signature;
+  TableRecord record;
+  std::vector<ColumnRecord> columns;
+  std::vector<EntityID> entity_ids;
+};
+
+const ComponentInfo& FindRegisteredType(std::string_view name, const TypeRecord& record) {
+  for (ComponentTypeID type_id = 0; type_id < kMaxComponentTypes; ++type_id) {
+    const ComponentInfo* info = ComponentInfo::Find(type_id);
+    if (info != nullptr && name == info->type.name()) {
+      if (info->size != record.size || info->alignment != record.alignment ||
+          info->is_tag != (record.is_tag != 0) || !(info->is_tag || info->is_trivial)) {
+        throw std::invalid_argument("Snapshot::Load: the layout of a component type has changed: " +
+                                    std::string(name));
+      }
+      return *info;
+    }
+  }
+  throw std::invalid_argument("Snapshot::Load: the component type is not registered: " + std::string(name));
+}
+
+TableImage ReadTable(const ImageReader& reader, std::uint64_t offset, const std::vector<const ComponentInfo*>& types,
+                     std::uint64_t slot_count) {
+  TableImage table;
+  table.record = reader.Read<TableRecord>(offset);
+  const TableRecord& record = table.record;
+  auto fail = [] { throw std::invalid_argument("Snapshot::Load: an archetype table is malformed"); };
+  if (record.chunk_capacity == 0 || record.chunk_capacity > kChunkSize) {
+    fail();
+  }
+
+  std::size_t data_type_count = 0;
+  for (std::uint32_t type : reader.ReadArray<std::uint32_t>(record.types_offset, record.type_count)) {
+    if (type >= types.size()) {
+      fail();
+    }
+    table.signature.Set(types[type]->id);
+    data_type_count += types[type]->is_tag ? 0 : 1;
+  }
+  table.columns = reader.ReadArray<ColumnRecord>(record.columns_offset, record.column_count);
+  if (table.columns.size() != data_type_count) {
+    fail();
+  }
+  for (const ColumnRecord& column : table.columns) {
+    if (column.type >= types.size() || !table.signature.Test(types[column.type]->id) ||
+        types[column.type]->is_tag || column.offset > record.chunk_bytes ||
+        types[column.type]->size * record.chunk_capacity > record.chunk_bytes - column.offset) {
+      fail();
+    }
+  }
+
+  table.entity_ids = reader.ReadArray<EntityID>(record.entities_offset, record.row_count);
+  for (const EntityID& entity_id : table.entity_ids) {
+    if (entity_id.GetIndex() >= slot_count) {
+      fail();
+    }
+  }
+  std::uint64_t used_chunks = (record.row_count + record.chunk_capacity - 1) / record.chunk_capacity;
+  if (record.chunk_count != (record.chunk_bytes == 0 ? 0 : used_chunks) ||
+      (record.chunk_count != 0 && record.chunk_bytes > reader.Size() / record.chunk_count)) {
+    fail();
+  }
+  static_cast<void>(reader.Bytes(record.chunks_offset, record.chunk_count * record.chunk_bytes));
+  return table;
+}
+
+// Whether a table stores every column of a table image at the same offsets, so the chunks can be adopted as they are.
+bool HasSameLayout(const ArchetypeTable& table, const TableImage& image, std::span<const std::byte> chunks,
+                   const std::vector<const ComponentInfo*>& types) {
+  if (table.ChunkCapacity() != image.record.chunk_capacity || table.ChunkBytes() != image.record.chunk_bytes ||
+      reinterpret_cast<std::uintptr_t>(chunks.data()) % kChunkAlignment != 0) {
+    return false;
+  }
+  return std::all_of(image.columns.begin(), image.columns.end(), [&table, &types](const ColumnRecord& column) {
+    return table.ColumnOffset(table.FindColumn(types[column.type]->id)) == column.offset;
+  });
+}
+
+// Lists the links of the hierarchy in the order described at LinkRecord.
+std::vector<LinkRecord> CollectLinks(const EntityHierarchy& hierarchy) {
+  std::vector<LinkRecord> links;
+  auto reverse_from = [&links](std::size_t first) {
+    std::reverse(links.begin() + static_cast<std::ptrdiff_t>(first), links.end());
+  };
+  hierarchy.ForEachRoot([&links](const EntityID& root_id) { links.push_back({root_id, EntityID::GetRootID()}); });
+  reverse_from(0);
+  for (std::size_t i = 0; i < links.size(); ++i) {
+    std::size_t first = links.size();
+    EntityID parent_id = links[i].entity;
+    hierarchy.ForEachChild(parent_id, [&links, parent_id](const EntityID& child_id) {
+      links.push_back({child_id, parent_id});
+    });
+    reverse_from(first);
+  }
+  return links;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Maps a whole file privately: pages are shared with the page cache until they are written to.
+std::pair<std::shared_ptr<void>, std::span<std::byte>> MapFile(const std::filesystem::path& path) {
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw std::runtime_error("Snapshot::Load: cannot open " + path.string());
+  }
+  struct stat status {};
+  if (::fstat(descriptor, &status) != 0 || status.st_size == 0) {
+    ::close(descriptor);
+    throw std::runtime_error("Snapshot::Load: cannot map " + path.string());
+  }
+  auto size = static_cast<std::size_t>(status.st_size);
+  void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("Snapshot::Load: cannot map " + path.string());
+  }
+  std::shared_ptr<void> mapping(address, [size](void* mapped) { ::munmap(mapped, size); });
+  return {std::move(mapping), {static_cast<std::byte*>(address), size}};
+}
+#else
+// Reads a whole file into memory aligned like a chunk, where memory mapping is not available.
+std::pair<std::shared_ptr<void>, std::span<std::byte>> MapFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error("Snapshot::Load: cannot open " + path.string());
+  }
+  auto size = static_cast<std::size_t>(file.tellg());
+  std::shared_ptr<void> buffer(::operator new(size, std::align_val_t{kChunkAlignment}),
+                               [](void* memory) { ::operator delete(memory, std::align_val_t{kChunkAlignment}); });
+  file.seekg(0);
+  if (!file.read(static_cast<char*>(buffer.get()), static_cast<std::streamsize>(size))) {
+    throw std::runtime_error("Snapshot::Load: cannot read " + path.string());
+  }
+  return {std::move(buffer), {static_cast<std::byte*>(buffer.get()), size}};
+}
+#endif
+
+}  // namespace
+
+std::vector<std::byte> Snapshot::Save(const EntityCollection& entities) {
+  ImageWriter writer;
+  std::uint64_t header_offset = writer.Reserve(sizeof(ImageHeader), alignof(ImageHeader));
+  ImageHeader header{.magic = kMagic, .version = kSnapshotVersion, .byte_order = kByteOrderMark};
+
+  // Number the component types of the non-empty tables in the order they are met.
+  std::vector<const ComponentInfo*> types;
+  std::array<std::uint32_t, kMaxComponentTypes> type_indices{};
+  for (const auto& table : entities.tables_) {
+    if (table->Empty()) {
+      continue;
+    }
+    table->Signature().ForEach([&types, &type_indices](ComponentTypeID type_id) {
+      const ComponentInfo* info = ComponentInfo::Find(type_id);
+      if (!info->is_tag && !info->is_trivial) {
+        throw std::invalid_argument("Snapshot::Save: the component type is not trivially copyable: " +
+                                    std::string(info->type.name()));
+      }
+      if (std::find(types.begin(), types.end(), info) == types.end()) {
+        type_indices[type_id] = static_cast<std::uint32_t>(types.size());
+        types.push_back(info);
+      }
+    });
+  }
+
+  std::vector<TypeRecord> type_records;
+  type_records.reserve(types.size());
+  for (const ComponentInfo* info : types) {
+    std::string_view name = info->type.name();
+    type_records.push_back({.name_offset = writer.Append(std::span<const char>(name)),
+                            .name_size = name.size(),
+                            .size = info->size,
+                            .alignment = info->alignment,
+                            .is_tag = info->is_tag ? 1U : 0U});
+  }
+  header.type_count = type_records.size();
+  header.types_offset = writer.Append(std::span<const TypeRecord>(type_records));
+
+  std::vector<std::uint64_t> table_offsets;
+  for (const auto& table : entities.tables_) {
+    if (table->Empty()) {
+      continue;
+    }
+    std::vector<std::uint32_t> table_types;
+    table->Signature().ForEach(
+        [&table_types, &type_indices](ComponentTypeID type_id) { table_types.push_back(type_indices[type_id]); });
+    std::vector<ColumnRecord> columns;
+    for (std::size_t column = 0; column < table->Layout().size(); ++column) {
+      columns.push_back({type_indices[table->Layout()[column]->id], table->ColumnOffset(column)});
+    }
+
+    TableRecord record{.type_count = table_types.size(),
+                       .types_offset = writer.Append(std::span<const std::uint32_t>(table_types)),
+                       .column_count = columns.size(),
+                       .columns_offset = writer.Append(std::span<const ColumnRecord>(columns)),
+                       .row_count = table->Size(),
+                       .entities_offset = writer.Append(std::span<const EntityID>(table->Entities())),
+                       .chunk_capacity = table->ChunkCapacity(),
+                       .chunk_bytes = table->ChunkBytes(),
+                       .chunk_count = table->ChunkBytes() == 0 ? 0 : table->ChunkCount()};
+
+    // Chunk images keep the in-memory layout; only the used part of every column is written, the rest stays zero.
+    record.chunks_offset = writer.Reserve(record.chunk_count * record.chunk_bytes, kChunkAlignment);
+    for (std::size_t chunk = 0; chunk < record.chunk_count; ++chunk) {
+      for (std::size_t column = 0; column < columns.size(); ++column) {
+        writer.Write(record.chunks_offset + chunk * record.chunk_bytes + columns[column].offset,
+                     table->ColumnData(column, chunk), table->ChunkSize(chunk) * table->Layout()[column]->size);
+      }
+    }
+    std::uint64_t record_offset = writer.Reserve(sizeof(TableRecord), alignof(TableRecord));
+    writer.Write(record_offset, &record, sizeof(TableRecord));
+    table_offsets.push_back(record_offset);
+  }
+  header.table_count = table_offsets.size();
+  header.tables_offset = writer.Append(std::span<const std::uint64_t>(table_offsets));
+
+  const auto& ids = entities.ids_;
+  std::vector<std::uint32_t> generations(ids.Capacity());
+  for (std::size_t index = 0; index < generations.size(); ++index) {
+    generations[index] = ids.GetGeneration(static_cast<std::uint32_t>(index));
+  }
+  header.slot_count = generations.size();
+  header.generations_offset = writer.Append(std::span<const std::uint32_t>(generations));
+  header.free_count = ids.GetFreeIndices().size();
+  header.free_offset = writer.Append(ids.GetFreeIndices());
+
+  std::vector<LinkRecord> links = CollectLinks(entities.hierarchy_);
+  header.link_count = links.size();
+  header.links_offset = writer.Append(std::span<const LinkRecord>(links));
+
+  std::vector<std::byte> image = std::move(writer).Release();
+  header.image_size = image.size();
+  std::memcpy(image.data() + header_offset, &header, sizeof(ImageHeader));
+  return image;
+}
+
+void Snapshot::Save(const EntityCollection& entities, const std::filesystem::path& path) {
+  std::vector<std::byte> image = Save(entities);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()))) {
+    throw std::runtime_error("Snapshot::Save: cannot write " + path.string());
+  }
+}
+
+void Snapshot::Load(EntityCollection& entities, std::span<const std::byte> image) { Load(entities, image, nullptr); }
+
+void Snapshot::Load(EntityCollection& entities, const std::filesystem::path& path, SnapshotLoadMode mode) {
+  auto [mapping, image] = MapFile(path);
+  Load(entities, image, mode == SnapshotLoadMode::kAdopt ? std::move(mapping) : nullptr);
+}
+
+void Snapshot::Load(EntityCollection& entities, std::span<const std::byte> image, std::shared_ptr<void> storage) {
+  // Validate the whole image before the collection is touched.
+  ImageReader reader(image);
+  auto header = reader.Read<ImageHeader>(0);
+  if (header.magic != kMagic || header.byte_order != kByteOrderMark || header.image_size != image.size()) {
+    throw std::invalid_argument("Snapshot::Load: the image is not a snapshot of this platform");
+  }
+  if (header.version != kSnapshotVersion) {
+    throw std::invalid_argument("Snapshot::Load: unsupported snapshot version " + std::to_string(header.version));
+  }
+
+  std::vector<const ComponentInfo*> types;
+  for (const TypeRecord& record : reader.ReadArray<TypeRecord>(header.types_offset, header.type_count)) {
+    std::span<const std::byte> name = reader.Bytes(record.name_offset, record.name_size);
+    types.push_back(&FindRegisteredType({reinterpret_cast<const char*>(name.data()), name.size()}, record));
+  }
+  std::vector<TableImage> tables;
+  for (std::uint64_t offset : reader.ReadArray<std::uint64_t>(header.tables_offset, header.table_count)) {
+    tables.push_back(ReadTable(reader, offset, types, header.slot_count));
+  }
+  auto generations = reader.ReadArray<std::uint32_t>(header.generations_offset, header.slot_count);
+  auto free_indices = reader.ReadArray<std::uint32_t>(header.free_offset, header.free_count);
+  auto links = reader.ReadArray<LinkRecord>(header.links_offset, header.link_count);
+  auto fail = [] { throw std::invalid_argument("Snapshot::Load: the entity IDs of the image are malformed"); };
+  std::vector<SlotState> states(generations.size(), SlotState::kAlive);
+  for (std::uint32_t index : free_indices) {
+    if (index >= states.size() || states[index] != SlotState::kAlive) {
+      fail();
+    }
+    states[index] = SlotState::kFree;
+  }
+  // Every row holds a distinct alive ID of the current generation of its slot; ReadTable() checked the indices.
+  for (const TableImage& table_image : tables) {
+    for (const EntityID& entity_id : table_image.entity_ids) {
+      std::uint32_t index = entity_id.GetIndex();
+      if (states[index] != SlotState::kAlive || entity_id.GetGeneration() != generations[index]) {
+        fail();
+      }
+      states[index] = SlotState::kStored;
+    }
+  }
+  // Every stored entity is linked at most once, below the root or below an entity linked before it.
+  for (const LinkRecord& link : links) {
+    std::uint32_t index = link.entity.GetIndex();
+    if (index >= states.size() || states[index] != SlotState::kStored ||
+        link.entity.GetGeneration() != generations[index]) {
+      fail();
+    }
+    std::uint32_t parent_index = link.parent.GetIndex();
+    if (link.parent != EntityID::GetRootID() &&
+        (parent_index >= states.size() || states[parent_index] != SlotState::kLinked ||
+         link.parent.GetGeneration() != generations[parent_index])) {
+      fail();
+    }
+    states[index] = SlotState::kLinked;
+  }
+  // Every slot is either free or holds a stored and linked entity.
+  for (SlotState state : states) {
+    if (state != SlotState::kFree && state != SlotState::kLinked) {
+      fail();
+    }
+  }
+
+  entities.Reset();
+  entities.ids_.Restore(generations, free_indices);
+  entities.inner_entities_.resize(generations.size());
+  bool is_adopted = false;
+  for (const TableImage& table_image : tables) {
+    const TableRecord& record = table_image.record;
+    std::size_t table_index = entities.FindOrCreateTable(table_image.signature);
+    ArchetypeTable& table = *entities.tables_[table_index];
+    // Signatures are unique in a valid image, so only a malformed one could make a table receive rows twice; chunks
+    // are adopted only by tables that are still empty.
+    auto* chunks = const_cast<std::byte*>(image.data()) + record.chunks_offset;
+    std::size_t first_row = table.Size();
+    if (storage != nullptr && first_row == 0 &&
+        HasSameLayout(table, table_image, {chunks, record.chunk_count * record.chunk_bytes}, types)) {
+      std::vector<std::byte*> adopted_chunks(record.chunk_count);
+      for (std::size_t chunk = 0; chunk < adopted_chunks.size(); ++chunk) {
+        adopted_chunks[chunk] = chunks + chunk * record.chunk_bytes;
+      }
+      table.AdoptChunks(adopted_chunks);
+      static_cast<void>(table.PushBack(table_image.entity_ids));
+      is_adopted = is_adopted || !adopted_chunks.empty();
+    } else {
+      static_cast<void>(table.PushBack(table_image.entity_ids));
+      for (const ColumnRecord& column : table_image.columns) {
+        std::size_t local_column = table.FindColumn(types[column.type]->id);
+        for (std::size_t chunk = 0; chunk < record.chunk_count; ++chunk) {
+          std::size_t chunk_first_row = chunk * record.chunk_capacity;
+          table.CopyRows(local_column, first_row + chunk_first_row,
+                         std::min<std::size_t>(record.chunk_capacity, record.row_count - chunk_first_row),
+                         chunks + chunk * record.chunk_bytes + column.offset);
+        }
+      }
+    }
+    for (std::size_t row = 0; row < table_image.entity_ids.size(); ++row) {
+      entities.inner_entities_[table_image.entity_ids[row].GetIndex()].SetLocation({table_index, first_row + row});
+    }
+  }
+  for (const LinkRecord& link : links) {
+    entities.hierarchy_.Insert(link.entity, link.parent);
+  }
+  if (is_adopted) {
+    entities.adopted_storage_.push_back(std::move(storage));
+  }
+}
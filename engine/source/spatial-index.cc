@@ -0,0 +1,241 @@
+#include "ecs/spatial-index.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+using engine::ecs::SpatialIndex;
+using engine::ecs::SpatialIndexStatistics;
+using engine::ecs::SpatialNeighbor;
+
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/movement.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Position;
+
+namespace {
+
+/**
+ * @brief Greatest magnitude of a cell coordinate, small enough that ranges of cells never overflow.
+ */
+constexpr float kMaxCell = 1 << 29;
+
+/**
+ * @brief Inserts a neighbour into the first `count` elements of a buffer sorted nearest first, dropping the farthest
+ * one when the buffer is full.
+ * @return The new number of neighbours in the buffer.
+ */
+std::size_t InsertNearest(std::span<SpatialNeighbor> nearest, std::size_t count, const SpatialNeighbor& neighbor) {
+  if (count == nearest.size()) {
+    if (neighbor.distance_squared >= nearest.back().distance_squared) {
+      return count;
+    }
+    --count;
+  }
+  std::size_t position = count;
+  while (position > 0 && nearest[position - 1].distance_squared > neighbor.distance_squared) {
+    nearest[position] = nearest[position - 1];
+    --position;
+  }
+  nearest[position] = neighbor;
+  return count + 1;
+}
+
+}  // namespace
+
+SpatialIndex::SpatialIndex(float cell_size, std::size_t bucket_count)
+    : System("SpatialIndex"),
+      cell_size_(cell_size),
+      inverse_cell_size_(1.0F / cell_size),
+      buckets_(std::bit_ceil(std::max<std::size_t>(bucket_count, 1))) {
+  if (!(cell_size > 0.0F)) {
+    throw std::invalid_argument("SpatialIndex: the cell size must be positive");
+  }
+  DeclareReads<Position>();
+}
+
+void SpatialIndex::Update(EntityCollection& entities) {
+  last_statistics_ = SpatialIndexStatistics{};
+  sync_.Update(
+      entities,
+      [this] {
+        for (auto& bucket : buckets_) {
+          bucket.clear();
+        }
+      },
+      [this](const EntityID& entity_id, const Position& position, EntryLocation& location, bool is_indexed) {
+        Place(entity_id, position, location, is_indexed);
+      },
+      [this](const EntryLocation& location) {
+        Detach(location);
+        ++last_statistics_.removed;
+      });
+}
+
+std::size_t SpatialIndex::Size() const noexcept { return sync_.Size(); }
+
+float SpatialIndex::GetCellSize() const noexcept { return cell_size_; }
+
+const SpatialIndexStatistics& SpatialIndex::GetLastStatistics() const noexcept { return last_statistics_; }
+
+template <typename Function>
+void SpatialIndex::ForEachInCells(std::int32_t min_x, std::int32_t min_y, std::int32_t max_x, std::int32_t max_y,
+                                  Function&& function) const {
+  if (min_x > max_x || min_y > max_y) {
+    return;
+  }
+  auto width = static_cast<std::size_t>(max_x - min_x) + 1;
+  auto height = static_cast<std::size_t>(max_y - min_y) + 1;
+  if (width * height > buckets_.size()) {
+    for (const auto& bucket : buckets_) {
+      std::for_each(bucket.begin(), bucket.end(), function);
+    }
+    return;
+  }
+  for (std::int32_t cell_y = min_y; cell_y <= max_y; ++cell_y) {
+    for (std::int32_t cell_x = min_x; cell_x <= max_x; ++cell_x) {
+      for (const Entry& entry : buckets_[BucketOf(cell_x, cell_y)]) {
+        // Other cells may share the bucket, and must not be reported twice.
+        if (entry.cell_x == cell_x && entry.cell_y == cell_y) {
+          function(entry);
+        }
+      }
+    }
+  }
+}
+
+std::size_t SpatialIndex::QueryRadius(float x, float y, float radius, std::span<EntityID> results) const noexcept {
+  std::size_t count = 0;
+  float radius_squared = radius * radius;
+  ForEachInCells(CellOf(x - radius), CellOf(y - radius), CellOf(x + radius), CellOf(y + radius),
+                 [&](const Entry& entry) {
+                   float delta_x = entry.x_coord - x;
+                   float delta_y = entry.y_coord - y;
+                   if (delta_x * delta_x + delta_y * delta_y <= radius_squared) {
+                     if (count < results.size()) {
+                       results[count] = entry.entity_id;
+                     }
+                     ++count;
+                   }
+                 });
+  return count;
+}
+
+std::size_t SpatialIndex::QueryBox(float min_x, float min_y, float max_x, float max_y,
+                                   std::span<EntityID> results) const noexcept {
+  std::size_t count = 0;
+  ForEachInCells(CellOf(min_x), CellOf(min_y), CellOf(max_x), CellOf(max_y), [&](const Entry& entry) {
+    if (entry.x_coord >= min_x && entry.x_coord <= max_x && entry.y_coord >= min_y && entry.y_coord <= max_y) {
+      if (count < results.size()) {
+        results[count] = entry.entity_id;
+      }
+      ++count;
+    }
+  });
+  return count;
+}
+
+std::size_t SpatialIndex::QueryNearest(float x, float y, std::span<SpatialNeighbor> results) const noexcept {
+  if (results.empty()) {
+    return 0;
+  }
+  std::size_t count = 0;
+  auto consider = [&](const Entry& entry) {
+    float delta_x = entry.x_coord - x;
+    float delta_y = entry.y_coord - y;
+    count = InsertNearest(results, count, {entry.entity_id, delta_x * delta_x + delta_y * delta_y});
+  };
+
+  // Rings of cells are searched outwards from the cell of the point. Every entity outside of the first `ring` rings
+  // is farther than `ring` cells from the point, so the search stops once the farthest neighbour found is closer.
+  std::int32_t center_x = CellOf(x);
+  std::int32_t center_y = CellOf(y);
+  std::size_t visited = 0;
+  for (std::int32_t ring = 0;; ++ring) {
+    auto side = static_cast<std::size_t>(2 * ring + 1);
+    if (side * side > buckets_.size()) {
+      // The rings cover more cells than there are buckets, so scanning every entry once is cheaper.
+      count = 0;
+      for (const auto& bucket : buckets_) {
+        std::for_each(bucket.begin(), bucket.end(), consider);
+      }
+      return count;
+    }
+    auto visit = [&](std::int32_t cell_x, std::int32_t cell_y) {
+      for (const Entry& entry : buckets_[BucketOf(cell_x, cell_y)]) {
+        if (entry.cell_x == cell_x && entry.cell_y == cell_y) {
+          consider(entry);
+          ++visited;
+        }
+      }
+    };
+    if (ring == 0) {
+      visit(center_x, center_y);
+    } else {
+      for (std::int32_t offset = -ring; offset <= ring; ++offset) {
+        visit(center_x + offset, center_y - ring);
+        visit(center_x + offset, center_y + ring);
+      }
+      for (std::int32_t offset = -ring + 1; offset < ring; ++offset) {
+        visit(center_x - ring, center_y + offset);
+        visit(center_x + ring, center_y + offset);
+      }
+    }
+    float reach = static_cast<float>(ring) * cell_size_;
+    if (visited == sync_.Size() || (count == results.size() && results[count - 1].distance_squared <= reach * reach)) {
+      return count;
+    }
+  }
+}
+
+std::int32_t SpatialIndex::CellOf(float coordinate) const noexcept {
+  float cell = std::floor(coordinate * inverse_cell_size_);
+  // Written so that NaN falls to the lower bound.
+  if (!(cell >= -kMaxCell)) {
+    return static_cast<std::int32_t>(-kMaxCell);
+  }
+  return static_cast<std::int32_t>(std::min(cell, kMaxCell));
+}
+
+std::uint32_t SpatialIndex::BucketOf(std::int32_t cell_x, std::int32_t cell_y) const noexcept {
+  std::uint32_t hash = static_cast<std::uint32_t>(cell_x) * 73856093U ^ static_cast<std::uint32_t>(cell_y) * 19349663U;
+  return hash & static_cast<std::uint32_t>(buckets_.size() - 1);
+}
+
+void SpatialIndex::Place(const EntityID& entity_id, const Position& position, EntryLocation& location,
+                         bool is_indexed) {
+  std::int32_t cell_x = CellOf(position.x_coord);
+  std::int32_t cell_y = CellOf(position.y_coord);
+  if (is_indexed) {
+    Entry& entry = buckets_[location.bucket][location.position];
+    if (entry.cell_x == cell_x && entry.cell_y == cell_y) {
+      entry.x_coord = position.x_coord;
+      entry.y_coord = position.y_coord;
+      ++last_statistics_.updated;
+      return;
+    }
+    Detach(location);
+    ++last_statistics_.moved;
+  } else {
+    ++last_statistics_.inserted;
+  }
+
+  std::uint32_t bucket = BucketOf(cell_x, cell_y);
+  location.bucket = bucket;
+  location.position = static_cast<std::uint32_t>(buckets_[bucket].size());
+  buckets_[bucket].push_back({entity_id, position.x_coord, position.y_coord, cell_x, cell_y});
+}
+
+void SpatialIndex::Detach(const EntryLocation& location) noexcept {
+  std::vector<Entry>& bucket = buckets_[location.bucket];
+  // The last entry of the bucket takes the place of the removed one.
+  std::uint32_t position = location.position;
+  bucket[position] = bucket.back();
+  sync_.LocationOf(bucket[position].entity_id).position = position;
+  bucket.pop_back();
+}
@@ -0,0 +1,31 @@
+#include "ecs/system.h"
+
+#include <string>
+#include <string_view>
+using engine::ecs::System;
+
+#include "ecs/change-tick.h"
+#include "ecs/component-signature.h"
+using engine::ecs::ComponentSignature;
+using engine::ecs::Tick;
+
+System::System(std::string_view name) : name_(name) {}
+
+const std::string& System::GetName() const noexcept { return name_; }
+
+const ComponentSignature& System::GetReads() const noexcept { return reads_; }
+
+const ComponentSignature& System::GetWrites() const noexcept { return writes_; }
+
+bool System::IsExclusive() const noexcept { return is_exclusive_; }
+
+bool System::ConflictsWith(const System& other) const noexcept {
+  if (is_exclusive_ || other.is_exclusive_) {
+    return true;
+  }
+  return writes_.ContainsAny(other.reads_ | other.writes_) || other.writes_.ContainsAny(reads_);
+}
+
+Tick System::GetLastRunTick() const noexcept { return last_run_tick_; }
+
+void System::DeclareExclusive() noexcept { is_exclusive_ = true; }
@@ -0,0 +1,113 @@
+#include "ecs/transform-system.h"
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+using engine::ecs::TransformStatistics;
+using engine::ecs::TransformSystem;
+
+#include "ecs/entity-collection.h"
+#include "ecs/entity-hierarchy.h"
+#include "ecs/entity-id.h"
+#include "ecs/entity-ref.h"
+#include "ecs/transform.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityHierarchy;
+using engine::ecs::EntityID;
+using engine::ecs::EntityRef;
+using engine::ecs::LocalTransform;
+using engine::ecs::Transform;
+
+#include "jobs/job-system.h"
+using engine::jobs::JobSystem;
+
+namespace {
+
+/**
+ * @brief Recomputes the world transform of an entity from the world transform of its parent.
+ * @return True if the entity has both transform components, otherwise false.
+ */
+bool Recompute(EntityCollection& entities, const EntityID& entity_id) {
+  EntityRef entity = entities.At(entity_id);
+  auto* local = entity.Get<LocalTransform>();
+  auto* world = entity.Get<Transform>();
+  if (local == nullptr || world == nullptr) {
+    return false;
+  }
+
+  Transform parent_world;
+  EntityID parent_id = entities.GetHierarchy().GetParent(entity_id);
+  if (parent_id != EntityID::GetRootID()) {
+    if (const auto* parent = std::as_const(entities).At(parent_id).Get<Transform>()) {
+      parent_world = *parent;
+    }
+  }
+
+  float sine = std::sin(parent_world.rotation);
+  float cosine = std::cos(parent_world.rotation);
+  float x = local->x_coord * parent_world.scale;
+  float y = local->y_coord * parent_world.scale;
+  world->x_coord = parent_world.x_coord + cosine * x - sine * y;
+  world->y_coord = parent_world.y_coord + sine * x + cosine * y;
+  world->rotation = parent_world.rotation + local->rotation;
+  world->scale = parent_world.scale * local->scale;
+  local->is_dirty = false;
+  return true;
+}
+
+}  // namespace
+
+TransformSystem::TransformSystem(JobSystem* jobs) : System("Transform"), jobs_(jobs) {
+  DeclareWrites<LocalTransform, Transform>();
+}
+
+void TransformSystem::Update(EntityCollection& entities) {
+  roots_.clear();
+  entities.GetHierarchy().ForEachRoot([this](const EntityID& root_id) { roots_.push_back(root_id); });
+
+  auto propagate = [this, &entities](std::size_t begin, std::size_t end) {
+    TransformStatistics statistics;
+    for (std::size_t root = begin; root < end; ++root) {
+      TransformStatistics subtree = PropagateFrom(entities, roots_[root]);
+      statistics.recomputed += subtree.recomputed;
+      statistics.skipped += subtree.skipped;
+    }
+    return statistics;
+  };
+  if (jobs_ == nullptr) {
+    last_statistics_ = propagate(0, roots_.size());
+    return;
+  }
+  last_statistics_ = jobs_->ParallelReduce(roots_.size(), kRootsPerJob, TransformStatistics{}, propagate,
+                                           [](TransformStatistics accumulated, TransformStatistics partial) {
+                                             accumulated.recomputed += partial.recomputed;
+                                             accumulated.skipped += partial.skipped;
+                                             return accumulated;
+                                           });
+}
+
+const TransformStatistics& TransformSystem::GetLastStatistics() const noexcept { return last_statistics_; }
+
+TransformStatistics TransformSystem::PropagateFrom(EntityCollection& entities, const EntityID& root_id) {
+  const EntityHierarchy& hierarchy = entities.GetHierarchy();
+  TransformStatistics statistics;
+  hierarchy.WalkSubtree(root_id, [&entities, &hierarchy, &statistics](const EntityID& entity_id) {
+    const auto* local = std::as_const(entities).At(entity_id).Get<LocalTransform>();
+    if (local == nullptr || !local->is_dirty) {
+      statistics.skipped++;
+      return true;
+    }
+    // Everything below a dirty entity depends on it, so the whole subtree is recomputed without further checks.
+    auto recompute = [&entities, &statistics](const EntityID& id) {
+      if (Recompute(entities, id)) {
+        statistics.recomputed++;
+      } else {
+        statistics.skipped++;
+      }
+    };
+    recompute(entity_id);
+    hierarchy.ForEachDescendant(entity_id, recompute);
+    return false;
+  });
+  return statistics;
+}
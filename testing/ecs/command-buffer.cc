@@ -0,0 +1,148 @@
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "ecs/component-base.h"
+using engine::ecs::ComponentBase;
+
+struct Position final : public ComponentBase {
+ public:
+  Position() = default;
+  Position(float x, float y) : x_coord(x), y_coord(y) {}
+  ~Position() override = default;
+  Position(const Position& other) = default;
+  Position& operator=(const Position& other) = default;
+
+  float x_coord{}, y_coord{};
+};
+
+struct Velocity final : public ComponentBase {
+ public:
+  Velocity() = default;
+  Velocity(float x, float y) : x_comp(x), y_comp(y) {}
+  ~Velocity() override = default;
+  Velocity(const Velocity& other) = default;
+  Velocity& operator=(const Velocity& other) = default;
+
+  float x_comp{}, y_comp{};
+};
+
+#include "ecs/tag-component.h"
+using engine::ecs::TagComponent;
+
+struct MoveableMarker final : public TagComponent {};
+
+#include "ecs/archetype.h"
+using engine::ecs::Archetype;
+
+using Moveable = Archetype<MoveableMarker, Position, Velocity>;
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "ecs/command-buffer.h"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query.h"
+#include "jobs/job-system.h"
+using engine::ecs::CommandBuffer;
+using engine::ecs::CommandQueue;
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::View;
+using engine::jobs::JobSystem;
+
+TEST_CASE("CommandBuffer Recording") {
+  EntityCollection entities;
+  ComponentCollection data;
+  data.Emplace<Position>(0, 0);
+  std::vector<EntityID> ids;
+  for (std::size_t i = 0; i < 100; ++i) {
+    data.Emplace<Position>();
+    ids.push_back(entities.Insert(data).first);
+  }
+  CommandBuffer commands;
+
+  SECTION("Structural changes during iteration") {
+    std::size_t index = 0;
+    View<Position>(entities).Each([&commands, &index](const EntityID& id, Position&) {
+      if (index % 2 == 0) {
+        commands.Erase(id);
+      } else {
+        commands.Emplace<Velocity>(id, 1, 2);
+      }
+      if (index % 10 == 0) {
+        ComponentCollection spawned;
+        spawned.Emplace<MoveableMarker>();
+        commands.Insert(spawned);
+      }
+      ++index;
+    });
+    REQUIRE(entities.Size() == 100);
+    REQUIRE(commands.Size() == 110);
+
+    std::vector<EntityID> inserted = commands.Flush(entities);
+    REQUIRE(commands.Empty() == true);
+    REQUIRE(inserted.size() == 10);
+    REQUIRE(entities.Size() == 60);
+    REQUIRE(View<Position, Velocity>(entities).Count() == 50);
+    REQUIRE(View<MoveableMarker>(entities).Count() == 10);
+    REQUIRE(entities.At(inserted.front()).HasAll<MoveableMarker>() == true);
+  }
+  SECTION("Commands are coalesced per entity") {
+    std::size_t table_count = entities.TableCount();
+    commands.Emplace<Velocity>(ids[0], 3, 4);
+    commands.Emplace<MoveableMarker>(ids[0]);
+    commands.Emplace<Velocity>(ids[0], 5, 6);
+    static_cast<void>(commands.Flush(entities));
+
+    REQUIRE(entities.TableCount() == table_count + 1);
+    REQUIRE(entities.At(ids[0]).HasAll<Position, Velocity, MoveableMarker>() == true);
+    REQUIRE(entities.At(ids[0]).Get<Velocity>()->x_comp == 3);
+  }
+  SECTION("Commands keep their recording order") {
+    commands.Remove<Position>(ids[1]);
+    commands.Emplace<Position>(ids[1], 7, 8);
+    commands.Emplace<Velocity>(ids[2], 1, 1);
+    commands.Remove<Velocity>(ids[2]);
+    commands.Emplace<Velocity>(ids[3], 1, 1);
+    commands.Erase(ids[3]);
+    commands.Emplace<Velocity>(ids[3], 1, 1);
+    static_cast<void>(commands.Flush(entities));
+
+    REQUIRE(entities.At(ids[1]).Get<Position>()->x_coord == 7);
+    REQUIRE(entities.At(ids[2]).HasNoneOf<Velocity>() == true);
+    REQUIRE(entities.Contains(ids[3]) == false);
+  }
+  SECTION("Commands for stale IDs are ignored") {
+    entities.Erase(ids[4]);
+    commands.Emplace<Velocity>(ids[4], 1, 1);
+    commands.Erase(ids[4]);
+    static_cast<void>(commands.Flush(entities));
+    REQUIRE(entities.Size() == 99);
+  }
+}
+
+TEST_CASE("CommandQueue Parallel Recording") {
+  EntityCollection entities;
+  ComponentCollection data;
+  data.Emplace<Position>(0, 0);
+  data.Emplace<Velocity>(1, 1);
+  for (std::size_t i = 0; i < 5000; ++i) {
+    static_cast<void>(entities.Insert(data));
+  }
+
+  JobSystem jobs(3);
+  CommandQueue queue;
+  View<Position, const Velocity>(entities).ParEachChunk(
+      jobs, [&queue](std::span<const EntityID> ids, std::span<Position>, std::span<const Velocity>) {
+        CommandBuffer& commands = queue.Local();
+        for (std::size_t i = 0; i < ids.size(); i += 2) {
+          commands.Emplace<MoveableMarker>(ids[i]);
+        }
+      });
+  static_cast<void>(queue.Flush(entities));
+
+  REQUIRE(View<MoveableMarker>(entities).Count() == 2500);
+  REQUIRE(View<Position, Velocity>(entities).Count() == 5000);
+}
@@ -1,4 +1,5 @@
 #include <memory>
+#include <utility>
 
 #include "ecs/component-base.h"
 using engine::ecs::ComponentBase;
@@ -87,6 +88,13 @@ TEST_CASE("ComponentCollection Manipulation Methods") {
       REQUIRE(tmp->y_comp == 1);
     }
   }
+  SECTION("Move constructor") {
+    collection.Emplace<Velocity>(1, 2);
+    ComponentCollection moved(std::move(collection));
+    REQUIRE(moved.HasAll<Velocity>() == true);
+    REQUIRE(collection.Empty() == true);
+    REQUIRE(collection.HasAny<Velocity>() == false);
+  }
 }
 
 TEST_CASE("ComponentCollection Query Methods") {
@@ -95,5 +103,15 @@ TEST_CASE("ComponentCollection Query Methods") {
   collection.Emplace<Velocity>(1, 1);
   SECTION("Method HasAll()") { REQUIRE(collection.HasAll<Position, Velocity>() == true); }
   SECTION("Method HasAny()") { REQUIRE(collection.HasAny<Position, MoveableMarker>() == true); }
-  SECTION("Method HasNoneOf()") { REQUIRE(collection.HasNoneOf<MoveableMarker>() == true); }
+  SECTION("Method HasNoneOf()") {
+    REQUIRE(collection.HasNoneOf<MoveableMarker>() == true);
+    REQUIRE(collection.HasNoneOf<Position, MoveableMarker>() == false);
+  }
+  SECTION("Method GetSignature()") {
+    REQUIRE(collection.GetSignature().Count() == 2);
+    collection.Erase<Velocity>();
+    REQUIRE(collection.GetSignature().Count() == 1);
+    REQUIRE(collection.HasAny<Velocity, MoveableMarker>() == false);
+    REQUIRE(collection.HasAll<Position>() == true);
+  }
 }
\ No newline at end of file
@@ -0,0 +1,524 @@
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ecs/component-base.h"
+using engine::ecs::ComponentBase;
+
+struct Position final : public ComponentBase {
+ public:
+  Position() = default;
+  Position(float x, float y) : x_coord(x), y_coord(y) {}
+  ~Position() override = default;
+  Position(const Position& other) = default;
+  Position& operator=(const Position& other) = default;
+
+  float x_coord{}, y_coord{};
+};
+
+struct Velocity final : public ComponentBase {
+ public:
+  Velocity() = default;
+  Velocity(float x, float y) : x_comp(x), y_comp(y) {}
+  ~Velocity() override = default;
+  Velocity(const Velocity& other) = default;
+  Velocity& operator=(const Velocity& other) = default;
+
+  float x_comp{}, y_comp{};
+};
+
+struct Health {
+  int points{100};
+};
+
+struct Name {
+  std::string value;
+};
+
+struct Frozen {};
+
+#include "ecs/tag-component.h"
+using engine::ecs::TagComponent;
+
+struct MoveableMarker final : public TagComponent {};
+
+#include "ecs/archetype.h"
+using engine::ecs::Archetype;
+
+using Moveable = Archetype<MoveableMarker, Position, Velocity>;
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/component-info.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/entity-ref.h"
+#include "ecs/memory-statistics.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::ComponentInfo;
+using engine::ecs::ComponentSignatureOf;
+using engine::ecs::ConstEntityRef;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::MemoryStatistics;
+using engine::ecs::WriteMemoryStatistics;
+
+TEST_CASE("EntityCollection Manipulation Methods") {
+  EntityCollection entities;
+  ComponentCollection data;
+  data.Emplace<Position>(1, 2);
+  data.Emplace<Velocity>(3, 4);
+
+  SECTION("Method Insert()") {
+    auto [id, was_inserted] = entities.Insert(data);
+    REQUIRE(was_inserted == true);
+    REQUIRE(entities.Size() == 1);
+    REQUIRE(entities.Contains(id) == true);
+    REQUIRE(entities.At(id).HasAll<Position, Velocity>() == true);
+    REQUIRE(entities.At(id).Get<Position>()->x_coord == 1);
+    REQUIRE(entities.At(id).Get<Velocity>()->y_comp == 4);
+  }
+  SECTION("Method Extract()") {
+    auto [id, was_inserted] = entities.Insert(data);
+    auto [extracted, was_extracted] = entities.Extract(id);
+    REQUIRE(was_extracted == true);
+    REQUIRE(entities.Empty() == true);
+    REQUIRE(extracted.HasAll<Position, Velocity>() == true);
+    if (auto position = extracted.Get<Position>().lock()) {
+      REQUIRE(position->y_coord == 2);
+    }
+  }
+  SECTION("Method Emplace()") {
+    auto [id, was_inserted] = entities.Insert(data);
+    REQUIRE(entities.Emplace<MoveableMarker>(id) == true);
+    REQUIRE(entities.Emplace<MoveableMarker>(id) == false);
+    REQUIRE(entities.At(id).HasAll<MoveableMarker, Position, Velocity>() == true);
+    REQUIRE(entities.At(id).Get<Position>()->x_coord == 1);
+  }
+  SECTION("Method Remove()") {
+    auto [id, was_inserted] = entities.Insert(data);
+    REQUIRE(entities.Remove<Velocity>(id) == true);
+    REQUIRE(entities.Remove<Velocity>(id) == false);
+    REQUIRE(entities.At(id).HasNoneOf<Velocity>() == true);
+    REQUIRE(entities.At(id).Get<Position>()->y_coord == 2);
+  }
+  SECTION("Method Erase()") {
+    auto [first_id, first_inserted] = entities.Insert(data);
+    auto [second_id, second_inserted] = entities.Insert(data);
+    REQUIRE(entities.Erase(first_id) == true);
+    REQUIRE(entities.Erase(first_id) == false);
+    REQUIRE(entities.Contains(second_id) == true);
+    REQUIRE(entities.At(second_id).Get<Position>()->x_coord == 1);
+  }
+}
+
+TEST_CASE("EntityCollection archetype storage") {
+  EntityCollection entities;
+  constexpr std::size_t kEntityCount = 5000;
+
+  SECTION("Entities with the same components share a table") {
+    for (std::size_t i = 0; i < kEntityCount; ++i) {
+      ComponentCollection data;
+      data.Emplace<Position>(static_cast<float>(i), 0);
+      data.Emplace<Velocity>();
+      static_cast<void>(entities.Insert(std::move(data)));
+    }
+    REQUIRE(entities.TableCount() == 1);
+    const auto& table = entities.GetTable(0);
+    REQUIRE(table.Size() == kEntityCount);
+    REQUIRE(table.ChunkCount() > 1);
+
+    float expected = 0;
+    for (std::size_t chunk = 0; chunk < table.ChunkCount(); ++chunk) {
+      auto* positions = entities.GetTable(0).Column<Position>(chunk);
+      for (std::size_t i = 0; i < table.ChunkSize(chunk); ++i) {
+        REQUIRE(positions[i].x_coord == expected);
+        expected += 1;
+      }
+    }
+  }
+  SECTION("Tags are stored only in the signature") {
+    ComponentCollection data;
+    data.Emplace<Position>(1, 2);
+    data.Emplace<MoveableMarker>();
+    REQUIRE(data.Size() == 2);
+    REQUIRE(ComponentCollection(data).HasAll<Position, MoveableMarker>() == true);
+
+    auto [id, was_inserted] = entities.Insert(data);
+    const auto& tagged_table = entities.GetTable(0);
+    REQUIRE(tagged_table.Signature().Count() == 2);
+    REQUIRE(tagged_table.Layout().size() == 1);
+    REQUIRE(tagged_table.FindColumn<MoveableMarker>() == engine::ecs::ArchetypeTable::kNoColumn);
+
+    REQUIRE(entities.Remove<MoveableMarker>(id) == true);
+    REQUIRE(entities.At(id).HasNoneOf<MoveableMarker>() == true);
+    REQUIRE(entities.Emplace<MoveableMarker>(id) == true);
+    REQUIRE(entities.At(id).HasAll<Position, MoveableMarker>() == true);
+    REQUIRE(entities.At(id).Get<Position>()->y_coord == 2);
+    REQUIRE(entities.TableCount() == 2);
+  }
+  SECTION("Rows stay consistent after erasure") {
+    std::vector<EntityID> ids;
+    for (std::size_t i = 0; i < kEntityCount; ++i) {
+      ids.push_back(Moveable::CreateInstance(entities).first);
+      entities.At(ids.back()).Get<Position>()->x_coord = static_cast<float>(i);
+    }
+    for (std::size_t i = 0; i < kEntityCount; i += 2) {
+      REQUIRE(entities.Erase(ids[i]) == true);
+    }
+    REQUIRE(entities.Size() == kEntityCount / 2);
+    for (std::size_t i = 1; i < kEntityCount; i += 2) {
+      REQUIRE(entities.At(ids[i]).Get<Position>()->x_coord == static_cast<float>(i));
+    }
+  }
+  SECTION("Predicate scans") {
+    for (std::size_t i = 0; i < kEntityCount; ++i) {
+      static_cast<void>(Moveable::CreateInstance(entities));
+      ComponentCollection data;
+      data.Emplace<Position>();
+      static_cast<void>(entities.Insert(std::move(data)));
+    }
+    auto is_moveable = [](const ConstEntityRef& entity) { return entity.HasAll<MoveableMarker>(); };
+    REQUIRE(entities.CountIf(is_moveable) == kEntityCount);
+    REQUIRE(entities.Filter(is_moveable).size() == kEntityCount);
+    REQUIRE(entities.EraseIf(is_moveable) == true);
+    REQUIRE(entities.Size() == kEntityCount);
+    REQUIRE(entities.CountIf(is_moveable) == 0);
+  }
+}
+
+TEST_CASE("EntityCollection stale IDs") {
+  EntityCollection entities;
+  auto [old_id, was_inserted] = Moveable::CreateInstance(entities);
+  REQUIRE(entities.Erase(old_id) == true);
+  auto [new_id, was_reinserted] = Moveable::CreateInstance(entities);
+  REQUIRE(new_id.GetIndex() == old_id.GetIndex());
+  REQUIRE(entities.Contains(old_id) == false);
+  REQUIRE(entities.Contains(new_id) == true);
+  REQUIRE(entities.Erase(old_id) == false);
+  REQUIRE_THROWS_AS(entities.At(old_id), std::out_of_range);
+}
+
+TEST_CASE("EntityCollection batch methods") {
+  EntityCollection entities;
+  constexpr std::size_t kEntityCount = 50000;
+
+  SECTION("Method InsertBatch() with a signature") {
+    auto ids = Moveable::CreateInstances(entities, kEntityCount);
+    REQUIRE(ids.size() == kEntityCount);
+    REQUIRE(entities.Size() == kEntityCount);
+    REQUIRE(entities.TableCount() == 1);
+    REQUIRE(entities.At(ids.front()).HasAll<MoveableMarker, Position, Velocity>() == true);
+    REQUIRE(entities.At(ids.back()).Get<Velocity>()->x_comp == 0);
+  }
+  SECTION("Method InsertBatch() with a prototype") {
+    ComponentCollection prototype;
+    prototype.Emplace<Position>(1, 2);
+    prototype.Emplace<Velocity>(3, 4);
+    std::vector<EntityID> ids;
+    for (const auto& id : entities.InsertBatch(kEntityCount, prototype)) {
+      ids.push_back(id);
+    }
+    REQUIRE(entities.Size() == kEntityCount);
+    std::size_t matching = 0;
+    for (const auto& id : ids) {
+      ConstEntityRef entity = std::as_const(entities).At(id);
+      matching += entity.Get<Position>()->y_coord == 2 && entity.Get<Velocity>()->x_comp == 3 ? 1 : 0;
+    }
+    REQUIRE(matching == kEntityCount);
+  }
+  SECTION("Method EraseBatch()") {
+    auto span = Moveable::CreateInstances(entities, kEntityCount);
+    std::vector<EntityID> ids(span.begin(), span.end());
+    for (std::size_t i = 0; i < kEntityCount; ++i) {
+      entities.At(ids[i]).Get<Position>()->x_coord = static_cast<float>(i);
+    }
+
+    std::vector<EntityID> erased;
+    for (std::size_t i = 0; i < kEntityCount; i += 3) {
+      erased.push_back(ids[i]);
+    }
+    erased.push_back(ids[0]);
+    REQUIRE(entities.EraseBatch(erased) == erased.size() - 1);
+    REQUIRE(entities.Size() == kEntityCount - (erased.size() - 1));
+    REQUIRE(entities.EraseBatch(erased) == 0);
+
+    std::size_t intact = 0;
+    for (std::size_t i = 0; i < kEntityCount; ++i) {
+      if (i % 3 == 0) {
+        REQUIRE(entities.Contains(ids[i]) == false);
+      } else {
+        intact += entities.At(ids[i]).Get<Position>()->x_coord == static_cast<float>(i) ? 1 : 0;
+      }
+    }
+    REQUIRE(intact == entities.Size());
+  }
+}
+
+TEST_CASE("EntityCollection hierarchy") {
+  EntityCollection entities;
+  auto [root_id, root_inserted] = Moveable::CreateInstance(entities);
+  auto [child_id, child_inserted] = Moveable::CreateInstance(entities, root_id);
+  auto [grandchild_id, grandchild_inserted] = Moveable::CreateInstance(entities, child_id);
+
+  SECTION("Method Insert() attaches to the parent") {
+    REQUIRE(entities.GetParent(child_id) == root_id);
+    REQUIRE(entities.GetParent(root_id) == EntityID::GetRootID());
+    REQUIRE(entities.GetDepth(grandchild_id) == 2);
+    REQUIRE(entities.GetHierarchy().GetFirstChild(root_id) == child_id);
+    REQUIRE(entities.GetHierarchy().IsAncestorOf(root_id, grandchild_id) == true);
+  }
+  SECTION("Method SetParent()") {
+    auto [other_id, other_inserted] = Moveable::CreateInstance(entities);
+    REQUIRE(entities.SetParent(root_id, grandchild_id) == false);
+    REQUIRE(entities.SetParent(child_id, other_id) == true);
+    REQUIRE(entities.GetParent(child_id) == other_id);
+    REQUIRE(entities.GetDepth(grandchild_id) == 2);
+    REQUIRE(entities.GetHierarchy().GetFirstChild(root_id) == EntityID::GetRootID());
+    REQUIRE(entities.SetParent(child_id, EntityID::GetRootID()) == true);
+    REQUIRE(entities.GetDepth(grandchild_id) == 1);
+  }
+  SECTION("Method Erase() removes the subtree") {
+    auto [sibling_id, sibling_inserted] = Moveable::CreateInstance(entities, root_id);
+    REQUIRE(entities.Erase(child_id) == true);
+    REQUIRE(entities.Contains(grandchild_id) == false);
+    REQUIRE(entities.Contains(sibling_id) == true);
+    REQUIRE(entities.Erase(root_id) == true);
+    REQUIRE(entities.Empty() == true);
+  }
+  SECTION("Method Extract() promotes the children") {
+    auto [extracted, was_extracted] = entities.Extract(child_id);
+    REQUIRE(was_extracted == true);
+    REQUIRE(entities.GetParent(grandchild_id) == EntityID::GetRootID());
+    REQUIRE(entities.GetDepth(grandchild_id) == 0);
+  }
+  SECTION("Deep hierarchies") {
+    constexpr std::size_t kDepth = 200000;
+    EntityID parent_id = grandchild_id;
+    for (std::size_t i = 0; i < kDepth; ++i) {
+      parent_id = Moveable::CreateInstance(entities, parent_id).first;
+    }
+    REQUIRE(entities.GetDepth(parent_id) == kDepth + 2);
+
+    std::size_t previous_depth = 0;
+    bool is_depth_ordered = true;
+    entities.GetHierarchy().ForEach([&entities, &previous_depth, &is_depth_ordered](const EntityID& id) {
+      std::size_t depth = entities.GetDepth(id);
+      is_depth_ordered &= depth == 0 || depth == previous_depth + 1;
+      previous_depth = depth;
+    });
+    REQUIRE(is_depth_ordered == true);
+
+    std::vector<EntityID> batch{child_id};
+    REQUIRE(entities.EraseBatch(batch) == kDepth + 2);
+    REQUIRE(entities.Size() == 1);
+    REQUIRE(entities.Erase(root_id) == true);
+    REQUIRE(entities.Empty() == true);
+  }
+}
+
+TEST_CASE("EntityCollection plain components") {
+  EntityCollection entities;
+  REQUIRE(ComponentInfo::Of<Health>().is_trivial == true);
+  REQUIRE(ComponentInfo::Of<Name>().is_trivial == false);
+  REQUIRE(ComponentInfo::Of<Frozen>().is_tag == true);
+
+  ComponentCollection prototype;
+  prototype.Emplace<Health>(Health{42});
+  prototype.Emplace<Name>(Name{"prototype"});
+  prototype.Emplace<Frozen>();
+  ComponentCollection copy(prototype);
+  REQUIRE(copy.HasAll<Health, Name, Frozen>() == true);
+  REQUIRE(copy.Get<Name>().lock()->value == "prototype");
+
+  constexpr std::size_t kEntityCount = 1000;
+  std::vector<EntityID> ids;
+  for (EntityID id : entities.InsertBatch(kEntityCount, copy)) {
+    ids.push_back(id);
+  }
+  for (const EntityID& id : ids) {
+    REQUIRE(entities.At(id).Get<Health>()->points == 42);
+    REQUIRE(entities.At(id).Get<Name>()->value == "prototype");
+  }
+
+  for (std::size_t i = 0; i < kEntityCount; i += 2) {
+    entities.At(ids[i]).Get<Health>()->points = static_cast<int>(i);
+    REQUIRE(entities.Remove<Frozen>(ids[i]) == true);
+  }
+  for (std::size_t i = 1; i < kEntityCount; i += 4) {
+    REQUIRE(entities.Erase(ids[i]) == true);
+  }
+  for (std::size_t i = 0; i < kEntityCount; i += 2) {
+    REQUIRE(entities.At(ids[i]).HasNoneOf<Frozen>() == true);
+    REQUIRE(entities.At(ids[i]).Get<Health>()->points == static_cast<int>(i));
+    REQUIRE(entities.At(ids[i]).Get<Name>()->value == "prototype");
+  }
+  for (std::size_t i = 3; i < kEntityCount; i += 4) {
+    REQUIRE(entities.At(ids[i]).Get<Health>()->points == 42);
+  }
+}
+
+TEST_CASE("EntityCollection memory statistics") {
+  EntityCollection entities;
+  auto span = Moveable::CreateInstances(entities, 1000);
+  std::vector<EntityID> ids(span.begin(), span.end());
+  for (std::size_t i = 0; i < 10; ++i) {
+    ComponentCollection data;
+    data.Emplace<Health>();
+    static_cast<void>(entities.Insert(data, ids[i]));
+  }
+
+  MemoryStatistics statistics = entities.GetMemoryStatistics();
+  REQUIRE(statistics.entity_count == 1010);
+  REQUIRE(statistics.archetypes.size() == entities.TableCount());
+  REQUIRE(statistics.components.size() == 4);
+  for (std::size_t i = 1; i < statistics.components.size(); ++i) {
+    REQUIRE(statistics.components[i - 1].info->id < statistics.components[i].info->id);
+  }
+  for (const auto& component : statistics.components) {
+    if (component.info == &ComponentInfo::Of<Health>()) {
+      REQUIRE(component.count == 10);
+      REQUIRE(component.bytes == 10 * sizeof(Health));
+    } else if (component.info == &ComponentInfo::Of<MoveableMarker>()) {
+      REQUIRE(component.count == 1000);
+      REQUIRE(component.bytes == 0);
+      REQUIRE(component.tick_bytes == 0);
+    } else {
+      REQUIRE(component.count == 1000);
+      REQUIRE(component.bytes == 1000 * component.info->size);
+      REQUIRE(component.tick_bytes > 0);
+    }
+  }
+  std::size_t table_rows = 0;
+  for (const auto& archetype : statistics.archetypes) {
+    table_rows += archetype.entity_count;
+    REQUIRE(archetype.chunk_bytes >= archetype.component_bytes);
+    REQUIRE(archetype.Occupancy() > 0.0);
+    REQUIRE(archetype.Occupancy() <= 1.0);
+  }
+  REQUIRE(table_rows == entities.Size());
+  REQUIRE(statistics.component_bytes == 1000 * (sizeof(Position) + sizeof(Velocity)) + 10 * sizeof(Health));
+  REQUIRE(statistics.arena_used_bytes >= statistics.chunk_bytes);
+  REQUIRE(statistics.arena_reserved_bytes >= statistics.arena_used_bytes);
+  REQUIRE(statistics.adopted_bytes == 0);
+  REQUIRE(statistics.hierarchy_bytes > 0);
+  REQUIRE(statistics.id_bytes > 0);
+  REQUIRE(statistics.TotalBytes() > statistics.FragmentationBytes());
+
+  SECTION("Erased entities leave their chunks in place") {
+    for (std::size_t i = 500; i < 1000; ++i) {
+      entities.Erase(ids[i]);
+    }
+    MemoryStatistics after = entities.GetMemoryStatistics();
+    REQUIRE(after.entity_count == 510);
+    REQUIRE(after.chunk_bytes == statistics.chunk_bytes);
+    REQUIRE(after.component_bytes < statistics.component_bytes);
+    REQUIRE(after.FragmentationBytes() - statistics.FragmentationBytes() ==
+            statistics.component_bytes - after.component_bytes);
+  }
+  SECTION("Statistics are written as a single line") {
+    std::ostringstream output;
+    WriteMemoryStatistics(output, statistics);
+    std::string line = output.str();
+    REQUIRE(line.find('\n') == std::string::npos);
+    REQUIRE(line.find("{\"entities\":1010,") == 0);
+    REQUIRE(line.find("\"archetypes\":[{\"type_ids\":[") != std::string::npos);
+  }
+}
+
+TEST_CASE("EntityCollection archetype transitions") {
+  EntityCollection entities;
+  auto span = Moveable::CreateInstances(entities, 100);
+  std::vector<EntityID> ids(span.begin(), span.end());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    entities.At(ids[i]).Get<Position>()->x_coord = static_cast<float>(i);
+  }
+
+  SECTION("Repeated shape changes reuse the same tables") {
+    for (std::size_t frame = 0; frame < 10; ++frame) {
+      for (std::size_t i = frame % 2; i < ids.size(); i += 2) {
+        REQUIRE(entities.Emplace<Health>(ids[i], Health{static_cast<int>(frame)}) == true);
+        REQUIRE(entities.Emplace<Frozen>(ids[i]) == true);
+      }
+      REQUIRE(entities.TableCount() == (frame == 0 ? 3 : 4));
+      for (std::size_t i = frame % 2; i < ids.size(); i += 2) {
+        REQUIRE(std::as_const(entities).At(ids[i]).Get<Health>()->points == static_cast<int>(frame));
+        REQUIRE(entities.Remove<Health>(ids[i]) == true);
+        REQUIRE(entities.Remove<Frozen>(ids[i]) == true);
+      }
+    }
+    REQUIRE(entities.TableCount() == 4);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      ConstEntityRef entity = std::as_const(entities).At(ids[i]);
+      REQUIRE(entity.GetSignature() == Moveable::Signature());
+      REQUIRE(entity.Get<Position>()->x_coord == static_cast<float>(i));
+    }
+  }
+  SECTION("Reshape() follows the same transitions") {
+    auto signature = Moveable::Signature() | ComponentSignatureOf<Frozen>();
+    REQUIRE(entities.Reshape(ids[0], signature, {}) == true);
+    REQUIRE(entities.Emplace<Frozen>(ids[1]) == true);
+    REQUIRE(entities.TableCount() == 2);
+    REQUIRE(entities.Reshape(ids[0], Moveable::Signature(), {}) == true);
+    REQUIRE(entities.At(ids[0]).HasNoneOf<Frozen>() == true);
+    REQUIRE(entities.GetRemovedComponents().back().entity_id == ids[0]);
+  }
+  SECTION("Archetypes supplement live entities in a single move") {
+    ComponentCollection data;
+    data.Emplace<Health>(Health{7});
+    EntityID id = entities.Insert(data).first;
+    std::size_t table_count = entities.TableCount();
+    REQUIRE(Moveable::Supplement(entities, id) == true);
+    REQUIRE(entities.TableCount() == table_count + 1);
+    REQUIRE(entities.At(id).HasAll<MoveableMarker, Position, Velocity, Health>() == true);
+    REQUIRE(std::as_const(entities).At(id).Get<Health>()->points == 7);
+    REQUIRE(Moveable::Supplement(entities, id) == true);
+    REQUIRE(entities.TableCount() == table_count + 1);
+
+    REQUIRE(entities.Erase(id) == true);
+    REQUIRE(Moveable::Supplement(entities, id) == false);
+  }
+  SECTION("Transitions are forgotten by Reset()") {
+    REQUIRE(entities.Emplace<Frozen>(ids[0]) == true);
+    entities.Reset();
+    ComponentCollection data;
+    data.Emplace<Health>();
+    EntityID id = entities.Insert(data).first;
+    REQUIRE(entities.Emplace<Frozen>(id) == true);
+    REQUIRE(entities.TableCount() == 2);
+    REQUIRE(entities.At(id).HasAll<Health, Frozen>() == true);
+  }
+}
+
+// Run with `EntityCollectionTesting [benchmark]`.
+TEST_CASE("EntityCollection archetype transition time", "[.benchmark]") {
+  EntityCollection entities;
+  auto span = Moveable::CreateInstances(entities, 10000);
+  std::vector<EntityID> ids(span.begin(), span.end());
+  auto frozen_signature = Moveable::Signature() | ComponentSignatureOf<Frozen, Health>();
+
+  BENCHMARK("Emplace() and Remove() of two components, 10000 entities") {
+    for (const EntityID& id : ids) {
+      static_cast<void>(entities.Emplace<Frozen>(id));
+      static_cast<void>(entities.Emplace<Health>(id));
+    }
+    for (const EntityID& id : ids) {
+      static_cast<void>(entities.Remove<Frozen>(id));
+      static_cast<void>(entities.Remove<Health>(id));
+    }
+  };
+  BENCHMARK("Reshape() adding and removing two components, 10000 entities") {
+    for (const EntityID& id : ids) {
+      static_cast<void>(entities.Reshape(id, frozen_signature, {}));
+    }
+    for (const EntityID& id : ids) {
+      static_cast<void>(entities.Reshape(id, Moveable::Signature(), {}));
+    }
+  };
+}
\ No newline at end of file
@@ -1,14 +1,59 @@
 #define CATCH_CONFIG_MAIN
 #include "ecs/entity-id.h"
 
+#include <type_traits>
+#include <unordered_set>
+
 #include "catch2/catch.hpp"
+#include "ecs/entity-id-allocator.h"
 using engine::ecs::EntityID;
-
-// TODO(narratives): Make more tests
+using engine::ecs::EntityIDAllocator;
 
 TEST_CASE("EntityID constructor") {
   SECTION("Default constructor") {
     EntityID entity_id{};
-    REQUIRE(entity_id.GetInnerData().empty() == false);
+    REQUIRE(entity_id == EntityID::GetRootID());
+  }
+  SECTION("Constructor from parts") {
+    EntityID entity_id{7, 3};
+    REQUIRE(entity_id.GetIndex() == 7);
+    REQUIRE(entity_id.GetGeneration() == 3);
+    REQUIRE(entity_id != EntityID::GetRootID());
+  }
+  SECTION("Representation") {
+    REQUIRE(sizeof(EntityID) == 8);
+    REQUIRE(std::is_trivially_copyable_v<EntityID> == true);
+  }
+}
+
+TEST_CASE("EntityIDAllocator methods") {
+  EntityIDAllocator allocator;
+  SECTION("Method Allocate()") {
+    std::unordered_set<EntityID, EntityID::Hash> ids;
+    for (int i = 0; i < 1000; ++i) {
+      REQUIRE(ids.insert(allocator.Allocate()).second == true);
+    }
+    REQUIRE(allocator.Size() == 1000);
+    REQUIRE(ids.contains(EntityID::GetRootID()) == false);
+  }
+  SECTION("Method Release()") {
+    EntityID first_id = allocator.Allocate();
+    REQUIRE(allocator.Release(first_id) == true);
+    REQUIRE(allocator.Release(first_id) == false);
+    REQUIRE(allocator.IsAlive(first_id) == false);
+
+    EntityID second_id = allocator.Allocate();
+    REQUIRE(second_id.GetIndex() == first_id.GetIndex());
+    REQUIRE(second_id.GetGeneration() != first_id.GetGeneration());
+    REQUIRE(allocator.IsAlive(second_id) == true);
+    REQUIRE(allocator.IsAlive(first_id) == false);
+    REQUIRE(allocator.Capacity() == 1);
+  }
+  SECTION("Method Clear()") {
+    EntityID entity_id = allocator.Allocate();
+    allocator.Clear();
+    REQUIRE(allocator.Size() == 0);
+    REQUIRE(allocator.IsAlive(entity_id) == false);
+    REQUIRE(allocator.Allocate() != entity_id);
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,157 @@
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Frozen {};
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/movement-system.h"
+#include "ecs/movement.h"
+#include "ecs/query.h"
+#include "jobs/job-system.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::MovementSystem;
+using engine::ecs::Position;
+using engine::ecs::SimdLevel;
+using engine::ecs::Velocity;
+using engine::ecs::View;
+using engine::jobs::JobSystem;
+
+namespace {
+
+std::vector<SimdLevel> SupportedLevels() {
+  std::vector<SimdLevel> levels{SimdLevel::kScalar};
+  for (SimdLevel level : {SimdLevel::kSse, SimdLevel::kAvx2}) {
+    if (static_cast<int>(level) <= static_cast<int>(MovementSystem::DetectSimdLevel())) {
+      levels.push_back(level);
+    }
+  }
+  return levels;
+}
+
+// Inserts entities whose velocities times a power of two are exact, so every kernel must produce the same bits.
+std::vector<EntityID> InsertMovers(EntityCollection& entities, std::size_t count) {
+  std::vector<EntityID> ids;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto value = static_cast<float>(i);
+    ComponentCollection data;
+    data.Emplace<Position>(value, -value);
+    data.Emplace<Velocity>(static_cast<float>(i % 7), -0.5F * static_cast<float>(i % 3));
+    if (i % 5 == 0) {
+      data.Emplace<Frozen>();
+    }
+    ids.push_back(entities.Insert(std::move(data)).first);
+  }
+  return ids;
+}
+
+}  // namespace
+
+TEST_CASE("MovementSystem") {
+  EntityCollection entities;
+  std::vector<EntityID> ids = InsertMovers(entities, 3001);
+  ComponentCollection still;
+  still.Emplace<Position>(1.0F, 2.0F);
+  EntityID still_id = entities.Insert(std::move(still)).first;
+
+  SECTION("Every kernel moves every entity") {
+    for (SimdLevel level : SupportedLevels()) {
+      EntityCollection copy;
+      InsertMovers(copy, ids.size());
+      MovementSystem system(0.25F);
+      system.SetSimdLevel(level);
+      REQUIRE(system.GetSimdLevel() == level);
+      system.Update(copy);
+      for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto value = static_cast<float>(i);
+        const auto* position = copy.At(ids[i]).Get<Position>();
+        REQUIRE(position->x_coord == value + 0.25F * static_cast<float>(i % 7));
+        REQUIRE(position->y_coord == -value - 0.125F * static_cast<float>(i % 3));
+      }
+    }
+    MovementSystem system(0.25F);
+    system.Update(entities);
+    REQUIRE(entities.At(still_id).Get<Position>()->x_coord == 1.0F);
+  }
+  SECTION("Kernels handle unaligned starts and tails") {
+    constexpr std::size_t kCount = 67;
+    for (SimdLevel level : SupportedLevels()) {
+      for (std::size_t offset = 0; offset < 5; ++offset) {
+        for (std::size_t size = 0; size + offset <= kCount; size += 3) {
+          std::vector<Position> positions(kCount, Position(1, 2));
+          std::vector<Velocity> velocities;
+          for (std::size_t i = 0; i < kCount; ++i) {
+            velocities.emplace_back(static_cast<float>(i), -static_cast<float>(i));
+          }
+          MovementSystem::Integrate(std::span(positions).subspan(offset, size),
+                                    std::span<const Velocity>(velocities).subspan(offset, size), 2.0F, level);
+          for (std::size_t i = 0; i < kCount; ++i) {
+            bool is_moved = i >= offset && i < offset + size;
+            REQUIRE(positions[i].x_coord == (is_moved ? 1.0F + 2.0F * static_cast<float>(i) : 1.0F));
+            REQUIRE(positions[i].y_coord == (is_moved ? 2.0F - 2.0F * static_cast<float>(i) : 2.0F));
+          }
+        }
+      }
+    }
+  }
+  SECTION("Chunks are spread over a job system") {
+    JobSystem jobs(4);
+    EntityCollection copy;
+    InsertMovers(copy, ids.size());
+    MovementSystem serial(0.5F);
+    MovementSystem parallel(0.5F, &jobs);
+    serial.Update(entities);
+    parallel.Update(copy);
+    for (const EntityID& id : ids) {
+      REQUIRE(copy.At(id).Get<Position>()->x_coord == entities.At(id).Get<Position>()->x_coord);
+      REQUIRE(copy.At(id).Get<Position>()->y_coord == entities.At(id).Get<Position>()->y_coord);
+    }
+  }
+  SECTION("Unsupported kernels are rejected") {
+    MovementSystem system;
+    if (MovementSystem::DetectSimdLevel() != SimdLevel::kAvx2) {
+      REQUIRE_THROWS_AS(system.SetSimdLevel(SimdLevel::kAvx2), std::invalid_argument);
+    }
+    REQUIRE_NOTHROW(system.SetSimdLevel(SimdLevel::kScalar));
+  }
+}
+
+// Run with `MovementSystemTesting [benchmark]`. The small world fits in the cache; the large one is bound by memory.
+// Integrate() runs the bare kernels, while the system also pays for the query and for stamping the change ticks.
+TEST_CASE("MovementSystem throughput", "[.benchmark]") {
+  const char* kernel_names[] = {"scalar", "SSE", "AVX2"};
+  for (std::size_t entity_count : {std::size_t{16384}, std::size_t{1000000}}) {
+    EntityCollection entities;
+    InsertMovers(entities, entity_count);
+    std::string suffix = ", " + std::to_string(entity_count) + " entities";
+
+    BENCHMARK("Per-entity Each()" + suffix) {
+      View<Position, const Velocity>(entities).Each([](Position& position, const Velocity& velocity) {
+        position.x_coord += velocity.x_speed * 0.5F;
+        position.y_coord += velocity.y_speed * 0.5F;
+      });
+    };
+    std::vector<Position> positions(entity_count);
+    std::vector<Velocity> velocities(entity_count, Velocity(1, -1));
+    for (SimdLevel level : SupportedLevels()) {
+      BENCHMARK(std::string("Integrate(), ") + kernel_names[static_cast<int>(level)] + suffix) {
+        MovementSystem::Integrate(positions, velocities, 0.5F, level);
+      };
+      MovementSystem system(0.5F);
+      system.SetSimdLevel(level);
+      BENCHMARK(std::string("MovementSystem, ") + kernel_names[static_cast<int>(level)] + suffix) {
+        system.Update(entities);
+      };
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct Health {
+  int points{100};
+};
+
+struct Stats {
+  std::vector<int> levels;
+  std::string sprite;
+};
+
+struct Enemy {};
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/prefab.h"
+#include "ecs/shared-component.h"
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Prefab;
+using engine::ecs::SharedComponent;
+
+TEST_CASE("Prefab") {
+  constexpr std::size_t kInstanceCount = 500;
+  EntityCollection entities;
+
+  Prefab enemy;
+  enemy.Emplace<Health>(Health{30});
+  enemy.Emplace<Enemy>();
+  enemy.Emplace<SharedComponent<Stats>>(Stats{{1, 2, 3}, "orc.png"});
+  Prefab& weapon = enemy.AddChild(Prefab{});
+  weapon.Emplace<Health>(Health{5});
+  enemy.AddChild(Prefab{}).Emplace<Health>(Health{7});
+
+  SECTION("Method Instantiate()") {
+    std::vector<EntityID> ids = enemy.Instantiate(entities, kInstanceCount);
+    REQUIRE(ids.size() == kInstanceCount);
+    REQUIRE(entities.Size() == kInstanceCount * 3);
+
+    const Stats* shared_stats = &entities.At(ids.front()).Get<SharedComponent<Stats>>()->Get();
+    for (const EntityID& id : ids) {
+      auto entity = entities.At(id);
+      REQUIRE(entity.HasAll<Enemy>() == true);
+      REQUIRE(entity.Get<Health>()->points == 30);
+      REQUIRE(&entity.Get<SharedComponent<Stats>>()->Get() == shared_stats);
+
+      std::vector<int> child_points;
+      entities.GetHierarchy().ForEachChild(id, [&entities, &child_points](const EntityID& child_id) {
+        child_points.push_back(entities.At(child_id).Get<Health>()->points);
+      });
+      REQUIRE(child_points == std::vector<int>{5, 7});
+    }
+  }
+  SECTION("Shared components are copied on write") {
+    std::vector<EntityID> ids = enemy.Instantiate(entities, 2);
+    auto* first = entities.At(ids[0]).Get<SharedComponent<Stats>>();
+    auto* second = entities.At(ids[1]).Get<SharedComponent<Stats>>();
+    REQUIRE(first->IsShared() == true);
+
+    first->Mutate().sprite = "boss.png";
+    REQUIRE(first->Get().sprite == "boss.png");
+    REQUIRE(second->Get().sprite == "orc.png");
+    REQUIRE(&first->Get() != &second->Get());
+    REQUIRE(first->IsShared() == false);
+  }
+  SECTION("Method Capture()") {
+    std::vector<EntityID> ids = enemy.Instantiate(entities, 1);
+    Prefab captured = Prefab::Capture(entities, ids.front());
+    REQUIRE(captured.GetComponents().HasAll<Health, Enemy, SharedComponent<Stats>>() == true);
+    REQUIRE(captured.GetChildren().size() == 2);
+
+    std::vector<EntityID> copies = captured.Instantiate(entities, 10);
+    REQUIRE(entities.Size() == 33);
+    REQUIRE(entities.At(copies.back()).Get<Health>()->points == 30);
+    REQUIRE(entities.GetHierarchy().GetFirstChild(copies.back()) != EntityID::GetRootID());
+    REQUIRE(Prefab::Capture(entities, EntityID::GetRootID()).GetComponents().Empty() == true);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,389 @@
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ecs/component-base.h"
+using engine::ecs::ComponentBase;
+
+struct Position final : public ComponentBase {
+ public:
+  Position() = default;
+  Position(float x, float y) : x_coord(x), y_coord(y) {}
+  ~Position() override = default;
+  Position(const Position& other) = default;
+  Position& operator=(const Position& other) = default;
+
+  float x_coord{}, y_coord{};
+};
+
+struct Velocity final : public ComponentBase {
+ public:
+  Velocity() = default;
+  Velocity(float x, float y) : x_comp(x), y_comp(y) {}
+  ~Velocity() override = default;
+  Velocity(const Velocity& other) = default;
+  Velocity& operator=(const Velocity& other) = default;
+
+  float x_comp{}, y_comp{};
+};
+
+#include "ecs/tag-component.h"
+using engine::ecs::TagComponent;
+
+struct MoveableMarker final : public TagComponent {};
+
+#include "ecs/archetype.h"
+using engine::ecs::Archetype;
+
+using Moveable = Archetype<MoveableMarker, Position, Velocity>;
+
+template <std::size_t Index>
+struct Marker {
+  std::size_t value{Index};
+};
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+#include "ecs/change-tick.h"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query.h"
+#include "jobs/job-system.h"
+using engine::ecs::Added;
+using engine::ecs::Changed;
+using engine::ecs::ComponentCollection;
+using engine::ecs::Has;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Query;
+using engine::ecs::QueryCache;
+using engine::ecs::Removed;
+using engine::ecs::Tick;
+using engine::ecs::View;
+using engine::ecs::With;
+using engine::ecs::Without;
+using engine::jobs::JobSystem;
+
+namespace {
+
+template <std::size_t... Indices>
+void EmplaceMarkers(ComponentCollection& data, std::size_t mask, std::index_sequence<Indices...>) {
+  (
+      [&] {
+        if ((mask & (std::size_t{1} << Indices)) != 0) {
+          data.Emplace<Marker<Indices>>();
+        }
+      }(),
+      ...);
+}
+
+// Inserts entities into one archetype per mask, made of a Position and of the markers whose bit is set in the mask.
+void InsertArchetypes(EntityCollection& entities, std::size_t first_mask, std::size_t last_mask,
+                      std::size_t entity_count) {
+  for (std::size_t mask = first_mask; mask < last_mask; ++mask) {
+    ComponentCollection data;
+    data.Emplace<Position>(0, 0);
+    EmplaceMarkers(data, mask, std::make_index_sequence<8>{});
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      static_cast<void>(entities.Insert(data));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Query Matching") {
+  EntityCollection entities;
+  ComponentCollection positioned;
+  positioned.Emplace<Position>(1, 1);
+  ComponentCollection moving(positioned);
+  moving.Emplace<Velocity>(2, 3);
+  ComponentCollection marked(moving);
+  marked.Emplace<MoveableMarker>();
+
+  for (std::size_t i = 0; i < 10; ++i) {
+    static_cast<void>(entities.Insert(positioned));
+    static_cast<void>(entities.Insert(moving));
+    static_cast<void>(entities.Insert(marked));
+  }
+
+  SECTION("Method Count()") {
+    REQUIRE(View<Position>(entities).Count() == 30);
+    REQUIRE(View<Position, Velocity>(entities).Count() == 20);
+    REQUIRE(View<MoveableMarker>(entities).Count() == 10);
+    REQUIRE(Query<With<Position>, Without<Velocity>>(entities).Count() == 10);
+    REQUIRE(Query<With<Position, const Velocity>, Without<MoveableMarker>>(entities).Count() == 10);
+  }
+  SECTION("Method Each()") {
+    View<Position, const Velocity> view(entities);
+    view.Each([](Position& position, const Velocity& velocity) {
+      position.x_coord += velocity.x_comp;
+      position.y_coord += velocity.y_comp;
+    });
+
+    std::size_t moved = 0, still = 0;
+    View<const Position>(entities).Each([&moved, &still](const Position& position) {
+      if (position.x_coord == 3 && position.y_coord == 4) {
+        ++moved;
+      } else if (position.x_coord == 1 && position.y_coord == 1) {
+        ++still;
+      }
+    });
+    REQUIRE(moved == 20);
+    REQUIRE(still == 10);
+  }
+  SECTION("Method Each() with IDs") {
+    std::vector<EntityID> visited;
+    Query<With<Velocity>, Without<MoveableMarker>>(entities).Each(
+        [&visited](const EntityID& id, Velocity&) { visited.push_back(id); });
+    REQUIRE(visited.size() == 10);
+    for (const EntityID& id : visited) {
+      REQUIRE(entities.At(id).HasAll<Position, Velocity>() == true);
+      REQUIRE(entities.At(id).HasNoneOf<MoveableMarker>() == true);
+    }
+  }
+  SECTION("Filter Has") {
+    std::size_t visited = 0;
+    Query<With<const Position>, Without<>, Has<MoveableMarker>>(entities).Each([&visited](const Position&) {
+      ++visited;
+    });
+    REQUIRE(visited == 10);
+    REQUIRE(Query<With<Velocity>, Without<>, Has<MoveableMarker>>(entities).Count() == 10);
+  }
+  SECTION("Method Matches()") {
+    REQUIRE(View<Position>::Matches(positioned.GetSignature()) == true);
+    REQUIRE(View<Position, Velocity>::Matches(positioned.GetSignature()) == false);
+    REQUIRE(Query<With<Position>, Without<MoveableMarker>>::Matches(marked.GetSignature()) == false);
+  }
+}
+
+TEST_CASE("Query Chunk Iteration") {
+  EntityCollection entities;
+  ComponentCollection data;
+  data.Emplace<Position>(0, 0);
+  data.Emplace<Velocity>(1, 2);
+
+  constexpr std::size_t kEntityCount = 5000;
+  for (std::size_t i = 0; i < kEntityCount; ++i) {
+    static_cast<void>(entities.Insert(data));
+  }
+
+  std::size_t chunk_count = 0, entity_count = 0;
+  bool are_sizes_equal = true;
+  View<Position, const Velocity>(entities).EachChunk(
+      [&](std::span<const EntityID> ids, std::span<Position> positions, std::span<const Velocity> velocities) {
+        ++chunk_count;
+        entity_count += ids.size();
+        are_sizes_equal = are_sizes_equal && ids.size() == positions.size() && ids.size() == velocities.size();
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+          positions[i].x_coord += velocities[i].x_comp;
+        }
+      });
+  REQUIRE(chunk_count > 1);
+  REQUIRE(entity_count == kEntityCount);
+  REQUIRE(are_sizes_equal == true);
+
+  std::size_t moved = 0;
+  View<const Position>(entities).Each([&moved](const Position& position) { moved += position.x_coord == 1 ? 1 : 0; });
+  REQUIRE(moved == kEntityCount);
+}
+
+TEST_CASE("Query Parallel Execution") {
+  EntityCollection entities;
+  ComponentCollection data;
+  data.Emplace<Position>(0, 0);
+  data.Emplace<Velocity>(0.1F, 2);
+  ComponentCollection marked(data);
+  marked.Emplace<MoveableMarker>();
+
+  constexpr std::size_t kEntityCount = 6000;
+  for (std::size_t i = 0; i < kEntityCount; ++i) {
+    static_cast<void>(entities.Insert(i % 3 == 0 ? marked : data));
+  }
+  JobSystem jobs(3);
+
+  SECTION("Method ParEach()") {
+    View<Position, const Velocity>(entities).ParEach(jobs, [](Position& position, const Velocity& velocity) {
+      position.x_coord += velocity.x_comp;
+      position.y_coord += velocity.y_comp;
+    });
+    std::size_t moved = 0;
+    View<const Position>(entities).Each([&moved](const Position& position) { moved += position.y_coord == 2 ? 1 : 0; });
+    REQUIRE(moved == kEntityCount);
+  }
+  SECTION("Method ParReduce()") {
+    auto sum = [&entities](JobSystem& job_system) {
+      return View<const Velocity>(entities).ParReduce(
+          job_system, 0.0F, [](const Velocity& velocity) { return velocity.x_comp; },
+          [](float accumulated, float partial) { return accumulated + partial; });
+    };
+    JobSystem serial(0);
+    float expected = sum(serial);
+    for (int repeat = 0; repeat < 5; ++repeat) {
+      REQUIRE(sum(jobs) == expected);
+    }
+    REQUIRE(expected == Approx(0.1F * kEntityCount).epsilon(0.01));
+  }
+  SECTION("Parallel CountIf() and Filter()") {
+    auto is_marked = [](const auto& entity) { return entity.template HasAll<MoveableMarker>(); };
+    REQUIRE(entities.CountIf(is_marked, jobs) == kEntityCount / 3);
+    REQUIRE(entities.Filter(is_marked, jobs) == entities.Filter(is_marked));
+  }
+}
+
+
+TEST_CASE("Query Change Filters") {
+  constexpr std::size_t kEntityCount = 100;
+  EntityCollection entities;
+  ComponentCollection moving;
+  moving.Emplace<Position>(0, 0);
+  moving.Emplace<Velocity>(1, 1);
+
+  std::vector<EntityID> ids;
+  for (std::size_t i = 0; i < kEntityCount; ++i) {
+    ids.push_back(entities.Insert(moving).first);
+  }
+  Tick inserted = entities.GetChangeTick();
+
+  SECTION("Filter Added") {
+    REQUIRE(Query<With<const Position>, Without<>, Added<Velocity>>(entities).Count() == kEntityCount);
+    REQUIRE(Query<With<const Position>, Without<>, Added<Velocity>>(entities, inserted).Count() == 0);
+  }
+
+  SECTION("Filter Changed") {
+    static_cast<void>(entities.AdvanceChangeTick());
+    for (std::size_t i = 0; i < 10; ++i) {
+      entities.At(ids[i * 7]).Get<Position>()->x_coord = 1;
+    }
+    REQUIRE(Query<With<const Position>, Without<>, Changed<Position>>(entities, inserted).Count() == 10);
+    REQUIRE(Query<With<const Position>, Without<>, Changed<Velocity>>(entities, inserted).Count() == 0);
+    REQUIRE(Query<With<const Position>, Without<>, Added<Position>>(entities, inserted).Count() == 0);
+
+    std::size_t visited = 0;
+    Query<With<const Position>, Without<>, Changed<Position>>(entities, inserted)
+        .Each([&visited](const EntityID&, const Position& position) {
+          REQUIRE(position.x_coord == 1);
+          ++visited;
+        });
+    REQUIRE(visited == 10);
+
+    std::size_t chunk_entities = 0;
+    Query<With<const Position>, Without<>, Changed<Position>>(entities, inserted)
+        .EachChunk([&chunk_entities](std::span<const EntityID> chunk_ids, std::span<const Position>) {
+          chunk_entities += chunk_ids.size();
+        });
+    REQUIRE(chunk_entities >= 10);
+    REQUIRE(chunk_entities <= kEntityCount);
+  }
+
+  SECTION("Mutable access stamps changes") {
+    Tick read = entities.AdvanceChangeTick();
+    View<const Position>(entities).Each([](const Position&) {});
+    REQUIRE(Query<With<const Position>, Without<>, Changed<Position>>(entities, inserted).Count() == 0);
+
+    static_cast<void>(entities.AdvanceChangeTick());
+    View<Position, const Velocity>(entities).Each([](Position&, const Velocity&) {});
+    REQUIRE(Query<With<const Position>, Without<>, Changed<Position>>(entities, read).Count() == kEntityCount);
+    REQUIRE(Query<With<const Position>, Without<>, Changed<Velocity>>(entities, read).Count() == 0);
+  }
+
+  SECTION("Rows moved into a stamped chunk keep their ticks") {
+    ComponentCollection still;
+    still.Emplace<Position>(2, 2);
+    EntityID still_id = entities.Insert(still).first;
+    Tick stamped = entities.AdvanceChangeTick();
+    // Every row of the chunk is written, so the chunk is stamped once instead of every row.
+    View<Position, const Velocity>(entities).EachChunk(
+        [](std::span<const EntityID>, std::span<Position>, std::span<const Velocity>) {});
+    using ChangedPosition = Query<With<const Position>, Without<>, Changed<Position>>;
+    REQUIRE(ChangedPosition(entities, stamped - 1).Count() == kEntityCount);
+
+    entities.Emplace<Velocity>(still_id, 0, 0);
+    REQUIRE(ChangedPosition(entities, stamped - 1).Count() == kEntityCount);
+    entities.Erase(ids[0]);
+    REQUIRE(ChangedPosition(entities, stamped - 1).Count() == kEntityCount - 1);
+  }
+
+  SECTION("Filter Removed") {
+    Tick before = entities.AdvanceChangeTick();
+    for (std::size_t i = 0; i < 5; ++i) {
+      entities.Remove<Velocity>(ids[i]);
+    }
+    using RemovedVelocity = Query<With<const Position>, Without<>, Removed<Velocity>>;
+    REQUIRE(RemovedVelocity(entities, before - 1).Count() == 5);
+    REQUIRE(RemovedVelocity(entities, before).Count() == 0);
+
+    entities.Emplace<Velocity>(ids[0], 1, 1);
+    entities.Erase(ids[1]);
+    std::vector<EntityID> visited;
+    RemovedVelocity(entities, before - 1).Each([&visited](const EntityID& id, const Position&) {
+      visited.push_back(id);
+    });
+    REQUIRE(visited == std::vector<EntityID>{ids[2], ids[3], ids[4]});
+  }
+}
+
+TEST_CASE("Query Cache") {
+  EntityCollection entities;
+  InsertArchetypes(entities, 0, 128, 3);
+  // A quarter of the masks have the first marker and not the second one.
+  using MarkedQuery = Query<With<Position, const Marker<0>>, Without<Marker<1>>>;
+  QueryCache cache;
+  REQUIRE(MarkedQuery(entities, cache).Count() == MarkedQuery(entities).Count());
+  REQUIRE(MarkedQuery(entities, cache).Count() == 96);
+  REQUIRE(cache.GetTableIndices().size() == 32);
+  REQUIRE(cache.GetTestCount() == 128);
+
+  SECTION("Only new tables are tested") {
+    std::size_t visited = 0;
+    MarkedQuery(entities, cache).Each([&visited](Position&, const Marker<0>& marker) { visited += marker.value + 1; });
+    REQUIRE(visited == 96);
+    REQUIRE(cache.GetTestCount() == 128);
+
+    InsertArchetypes(entities, 128, 256, 3);
+    REQUIRE(MarkedQuery(entities, cache).Count() == 192);
+    REQUIRE(cache.GetTestCount() == 256);
+  }
+  SECTION("Empty tables are skipped") {
+    std::vector<EntityID> ids;
+    View<const Marker<0>>(entities).Each([&ids](const EntityID& id, const Marker<0>&) { ids.push_back(id); });
+    REQUIRE(entities.EraseBatch(ids) == 192);
+    std::size_t chunk_count = 0;
+    MarkedQuery(entities, cache).EachChunk([&chunk_count](auto&&...) { ++chunk_count; });
+    REQUIRE(chunk_count == 0);
+    REQUIRE(cache.GetTableIndices().size() == 32);
+  }
+  SECTION("The cache is rebuilt after a reset or for another collection") {
+    entities.Reset();
+    InsertArchetypes(entities, 0, 4, 1);
+    REQUIRE(MarkedQuery(entities, cache).Count() == 1);
+    REQUIRE(cache.GetTableIndices().size() == 1);
+
+    EntityCollection other;
+    InsertArchetypes(other, 0, 2, 5);
+    REQUIRE(MarkedQuery(other, cache).Count() == 5);
+    REQUIRE(cache.GetTableIndices().size() == 1);
+  }
+}
+
+// Run with `QueryTesting [benchmark]`.
+TEST_CASE("Query Cache time", "[.benchmark]") {
+  EntityCollection entities;
+  InsertArchetypes(entities, 0, 256, 64);
+  using MarkedQuery = Query<With<Position>, Without<>, Has<Marker<0>>, Has<Marker<1>>, Has<Marker<2>>>;
+  QueryCache cache;
+
+  BENCHMARK("Each() over 32 of 256 tables, every table tested") {
+    float sum = 0;
+    MarkedQuery(entities).Each([&sum](const Position& position) { sum += position.x_coord; });
+    return sum;
+  };
+  BENCHMARK("Each() over 32 of 256 tables, tables cached") {
+    float sum = 0;
+    MarkedQuery(entities, cache).Each([&sum](const Position& position) { sum += position.x_coord; });
+    return sum;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ecs/component-base.h"
+using engine::ecs::ComponentBase;
+
+struct Position final : public ComponentBase {
+ public:
+  Position() = default;
+  Position(float x, float y) : x_coord(x), y_coord(y) {}
+  ~Position() override = default;
+  Position(const Position& other) = default;
+  Position& operator=(const Position& other) = default;
+
+  float x_coord{}, y_coord{};
+};
+
+struct Velocity final : public ComponentBase {
+ public:
+  Velocity() = default;
+  Velocity(float x, float y) : x_comp(x), y_comp(y) {}
+  ~Velocity() override = default;
+  Velocity(const Velocity& other) = default;
+  Velocity& operator=(const Velocity& other) = default;
+
+  float x_comp{}, y_comp{};
+};
+
+#include "ecs/tag-component.h"
+using engine::ecs::TagComponent;
+
+struct MoveableMarker final : public TagComponent {};
+
+#include "ecs/archetype.h"
+using engine::ecs::Archetype;
+
+using Moveable = Archetype<MoveableMarker, Position, Velocity>;
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/query.h"
+#include "ecs/scheduler.h"
+#include "ecs/system.h"
+#include "jobs/job-system.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::CriticalPath;
+using engine::ecs::EntityCollection;
+using engine::ecs::Scheduler;
+using engine::ecs::System;
+using engine::ecs::View;
+using engine::jobs::JobSystem;
+
+class MovementSystem final : public System {
+ public:
+  MovementSystem() : System("Movement") {
+    DeclareReads<Velocity>();
+    DeclareWrites<Position>();
+  }
+
+  void Update(EntityCollection& entities) override {
+    View<Position, const Velocity>(entities).Each([](Position& position, const Velocity& velocity) {
+      position.x_coord += velocity.x_comp;
+      position.y_coord += velocity.y_comp;
+    });
+  }
+};
+
+class DampingSystem final : public System {
+ public:
+  DampingSystem() : System("Damping") { DeclareWrites<Velocity>(); }
+
+  void Update(EntityCollection& entities) override {
+    View<Velocity>(entities).Each([](Velocity& velocity) {
+      velocity.x_comp *= 0.5F;
+      velocity.y_comp *= 0.5F;
+    });
+  }
+};
+
+class CounterSystem final : public System {
+ public:
+  explicit CounterSystem(std::string name) : System(name) { DeclareReads<Position>(); }
+
+  void Update(EntityCollection& entities) override { count = View<const Position>(entities).Count(); }
+
+  std::size_t count{0};
+};
+
+class SpawnSystem final : public System {
+ public:
+  SpawnSystem() : System("Spawn") { DeclareExclusive(); }
+
+  void Update(EntityCollection& entities) override {
+    ComponentCollection data;
+    data.Emplace<Position>(0, 0);
+    static_cast<void>(entities.Insert(data));
+  }
+};
+
+TEST_CASE("System Conflicts") {
+  MovementSystem movement;
+  DampingSystem damping;
+  CounterSystem counter("Counter");
+  CounterSystem other_counter("Other counter");
+  SpawnSystem spawn;
+
+  REQUIRE(movement.ConflictsWith(damping) == true);
+  REQUIRE(damping.ConflictsWith(movement) == true);
+  REQUIRE(movement.ConflictsWith(counter) == true);
+  REQUIRE(damping.ConflictsWith(counter) == false);
+  REQUIRE(counter.ConflictsWith(other_counter) == false);
+  REQUIRE(spawn.ConflictsWith(counter) == true);
+  REQUIRE(counter.ConflictsWith(spawn) == true);
+}
+
+TEST_CASE("Scheduler Graph") {
+  Scheduler scheduler;
+  scheduler.Emplace<CounterSystem>("Counter");  // 0
+  scheduler.Emplace<MovementSystem>();          // 1, after 0
+  scheduler.Emplace<DampingSystem>();           // 2, after 1
+  scheduler.Emplace<CounterSystem>("Late");     // 3, after 1
+  scheduler.Emplace<SpawnSystem>();             // 4, after everything
+  REQUIRE(scheduler.Size() == 5);
+
+  REQUIRE(scheduler.GetSuccessors(0) == std::vector<std::size_t>{1, 4});
+  REQUIRE(scheduler.GetSuccessors(1) == std::vector<std::size_t>{2, 3, 4});
+  REQUIRE(scheduler.GetSuccessors(2) == std::vector<std::size_t>{4});
+  REQUIRE(scheduler.GetSuccessors(3) == std::vector<std::size_t>{4});
+  REQUIRE(scheduler.GetSuccessors(4).empty() == true);
+
+  EntityCollection entities;
+  scheduler.Run(entities);
+  CriticalPath path = scheduler.GetCriticalPath();
+  REQUIRE(path.systems.front() == 0);
+  REQUIRE(path.systems[1] == 1);
+  REQUIRE(path.systems.back() == 4);
+
+  std::string dot = scheduler.ToDot();
+  REQUIRE(dot.find("digraph") != std::string::npos);
+  REQUIRE(dot.find("Movement") != std::string::npos);
+  REQUIRE(dot.find("s1 -> s2") != std::string::npos);
+}
+
+TEST_CASE("Scheduler Execution") {
+  ComponentCollection data;
+  data.Emplace<Position>(0, 0);
+  data.Emplace<Velocity>(4, 8);
+
+  auto simulate = [&data](bool is_parallel) {
+    EntityCollection entities;
+    for (std::size_t i = 0; i < 3000; ++i) {
+      static_cast<void>(entities.Insert(data));
+    }
+    Scheduler scheduler;
+    scheduler.Emplace<MovementSystem>();
+    scheduler.Emplace<DampingSystem>();
+    auto& counter = scheduler.Emplace<CounterSystem>("Counter");
+    scheduler.Emplace<SpawnSystem>();
+
+    JobSystem jobs(3);
+    for (int frame = 0; frame < 4; ++frame) {
+      if (is_parallel) {
+        scheduler.Run(entities, jobs);
+      } else {
+        scheduler.Run(entities);
+      }
+    }
+
+    std::vector<float> positions;
+    View<const Position>(entities).Each([&positions](const Position& position) {
+      positions.push_back(position.x_coord);
+      positions.push_back(position.y_coord);
+    });
+    return std::pair{counter.count, positions};
+  };
+
+  auto serial = simulate(false);
+  auto parallel = simulate(true);
+  REQUIRE(serial.first == 3003);
+  REQUIRE(parallel.first == serial.first);
+  REQUIRE(parallel.second == serial.second);
+}
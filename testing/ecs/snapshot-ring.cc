@@ -0,0 +1,136 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Position {
+  float x{}, y{};
+};
+
+struct Velocity {
+  float x{}, y{};
+};
+
+struct Name {
+  std::string value;
+};
+
+struct Frozen {};
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query.h"
+#include "ecs/snapshot-ring.h"
+#include "ecs/snapshot.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Query;
+using engine::ecs::Snapshot;
+using engine::ecs::SnapshotRing;
+using engine::ecs::View;
+using engine::ecs::With;
+using engine::ecs::Without;
+
+namespace {
+
+// Moves the entities, spawns a few children, erases some entities and freezes or thaws one, all depending on the frame.
+void Simulate(EntityCollection& entities, int frame) {
+  Query<With<Position, const Velocity>, Without<Frozen>>(entities).Each(
+      [](Position& position, const Velocity& velocity) {
+        position.x += velocity.x;
+        position.y += velocity.y;
+      });
+
+  std::vector<EntityID> ids;
+  View<const Position>(entities).Each([&ids](const EntityID& id, const Position&) { ids.push_back(id); });
+  for (int i = 0; i < 3; ++i) {
+    ComponentCollection data;
+    data.Emplace<Position>(Position{static_cast<float>(frame), static_cast<float>(i)});
+    data.Emplace<Velocity>(Velocity{0.5F * static_cast<float>(frame), 1});
+    static_cast<void>(entities.Insert(std::move(data), ids[static_cast<std::size_t>(frame * 31 + i) % ids.size()]));
+  }
+  if (frame % 2 == 0) {
+    std::vector<EntityID> erased;
+    for (std::size_t i = static_cast<std::size_t>(frame); i < ids.size(); i += 97) {
+      erased.push_back(ids[i]);
+    }
+    entities.EraseBatch(erased);
+  }
+  if (frame % 3 == 0) {
+    const EntityID& id = ids[static_cast<std::size_t>(frame * 13) % ids.size()];
+    if (entities.Contains(id) && !entities.Remove<Frozen>(id)) {
+      entities.Emplace<Frozen>(id);
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("SnapshotRing") {
+  constexpr std::size_t kCapacity = 8;
+  constexpr int kFrameCount = 20;
+  EntityCollection world;
+  for (int i = 0; i < 2000; ++i) {
+    ComponentCollection data;
+    data.Emplace<Position>(Position{static_cast<float>(i), 0});
+    data.Emplace<Velocity>(Velocity{0.25F, static_cast<float>(i % 5)});
+    static_cast<void>(world.Insert(std::move(data)));
+  }
+
+  // images[frame] is the world after the frame; the ring holds the worlds before the last kCapacity frames.
+  SnapshotRing ring(kCapacity);
+  std::vector<std::vector<std::byte>> images(kFrameCount + 1);
+  images[0] = Snapshot::Save(world);
+  for (int frame = 1; frame <= kFrameCount; ++frame) {
+    ring.Save(world);
+    Simulate(world, frame);
+    images[frame] = Snapshot::Save(world);
+  }
+  REQUIRE(ring.Size() == kCapacity);
+
+  SECTION("Resimulation from a restored state is bit-identical") {
+    constexpr int kFirstFrame = kFrameCount - static_cast<int>(kCapacity) + 1;
+    REQUIRE(ring.Restore(world, kCapacity - 1) == true);
+    REQUIRE(ring.Size() == 1);
+    REQUIRE(Snapshot::Save(world) == images[kFirstFrame - 1]);
+    for (int frame = kFirstFrame; frame <= kFrameCount; ++frame) {
+      ring.Save(world);
+      Simulate(world, frame);
+      REQUIRE(Snapshot::Save(world) == images[frame]);
+    }
+
+    // Rolling back a single frame restores the newest state.
+    REQUIRE(ring.Restore(world) == true);
+    REQUIRE(Snapshot::Save(world) == images[kFrameCount - 1]);
+  }
+  SECTION("Only chunks changed since the state of a slot are copied") {
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+      ring.Save(world);
+    }
+    REQUIRE(ring.Save(world) == 0);
+
+    std::vector<EntityID> ids;
+    View<const Position>(world).Each([&ids](const EntityID& id, const Position&) { ids.push_back(id); });
+    float saved_x = world.At(ids.front()).Get<Position>()->x;
+    world.At(ids.front()).Get<Position>()->x += 1;
+    REQUIRE(ring.Save(world) == 1);
+    REQUIRE(ring.Restore(world, 1) == true);
+    REQUIRE(world.At(ids.front()).Get<Position>()->x == saved_x);
+  }
+  SECTION("Unavailable states") {
+    REQUIRE(ring.Restore(world, kCapacity) == false);
+    EntityCollection other;
+    REQUIRE(ring.Restore(other) == false);
+    REQUIRE(ring.Restore(world, 2) == true);
+    REQUIRE(ring.Size() == kCapacity - 2);
+
+    ComponentCollection data;
+    data.Emplace<Name>(Name{"orc"});
+    static_cast<void>(world.Insert(data));
+    REQUIRE_THROWS_AS(ring.Save(world), std::invalid_argument);
+  }
+}
\ No newline at end of file
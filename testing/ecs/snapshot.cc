@@ -0,0 +1,293 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Position {
+  float x{}, y{};
+};
+
+struct Velocity {
+  float x{}, y{};
+};
+
+struct Health {
+  int points{100};
+};
+
+struct Name {
+  std::string value;
+};
+
+struct Frozen {};
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/snapshot.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Snapshot;
+using engine::ecs::SnapshotLoadMode;
+
+namespace {
+
+// Builds a world of moving roots, some frozen, a third of them with two children, then erases every tenth root.
+std::vector<EntityID> BuildWorld(EntityCollection& entities, std::size_t root_count) {
+  std::vector<EntityID> roots;
+  for (std::size_t i = 0; i < root_count; ++i) {
+    auto value = static_cast<float>(i);
+    ComponentCollection data;
+    data.Emplace<Position>(Position{value, -value});
+    data.Emplace<Velocity>(Velocity{1, value});
+    if (i % 4 == 0) {
+      data.Emplace<Frozen>();
+    }
+    EntityID root_id = entities.Insert(std::move(data)).first;
+    if (i % 3 == 0) {
+      ComponentCollection child;
+      child.Emplace<Health>(Health{static_cast<int>(i)});
+      static_cast<void>(entities.Insert(child, root_id));
+      static_cast<void>(entities.Insert(child, root_id));
+    }
+    roots.push_back(root_id);
+  }
+  for (std::size_t i = 0; i < root_count; i += 10) {
+    entities.Erase(roots[i]);
+  }
+  return roots;
+}
+
+std::vector<EntityID> ChildrenOf(const EntityCollection& entities, const EntityID& parent_id) {
+  std::vector<EntityID> children;
+  auto append = [&children](const EntityID& child_id) { children.push_back(child_id); };
+  if (parent_id == EntityID::GetRootID()) {
+    entities.GetHierarchy().ForEachRoot(append);
+  } else {
+    entities.GetHierarchy().ForEachChild(parent_id, append);
+  }
+  return children;
+}
+
+// Checks that two collections hold the same entities, components and relations.
+void RequireSameWorld(const EntityCollection& expected, const EntityCollection& actual,
+                      const std::vector<EntityID>& roots) {
+  REQUIRE(actual.Size() == expected.Size());
+  REQUIRE(ChildrenOf(actual, EntityID::GetRootID()) == ChildrenOf(expected, EntityID::GetRootID()));
+  for (const EntityID& root_id : roots) {
+    REQUIRE(actual.Contains(root_id) == expected.Contains(root_id));
+    if (!expected.Contains(root_id)) {
+      continue;
+    }
+    auto expected_root = expected.At(root_id);
+    auto actual_root = actual.At(root_id);
+    REQUIRE(actual_root.HasAll<Frozen>() == expected_root.HasAll<Frozen>());
+    REQUIRE(std::memcmp(actual_root.Get<Position>(), expected_root.Get<Position>(), sizeof(Position)) == 0);
+    REQUIRE(std::memcmp(actual_root.Get<Velocity>(), expected_root.Get<Velocity>(), sizeof(Velocity)) == 0);
+    std::vector<EntityID> children = ChildrenOf(actual, root_id);
+    REQUIRE(children == ChildrenOf(expected, root_id));
+    for (const EntityID& child_id : children) {
+      REQUIRE(actual.At(child_id).Get<Health>()->points == expected.At(child_id).Get<Health>()->points);
+    }
+  }
+}
+
+// Offsets of fields of the header and of the table records of an image, as written by Snapshot::Save().
+constexpr std::size_t kTableCountField = 40;
+constexpr std::size_t kTablesOffsetField = 48;
+constexpr std::size_t kGenerationsOffsetField = 64;
+constexpr std::size_t kFreeCountField = 72;
+constexpr std::size_t kFreeOffsetField = 80;
+constexpr std::size_t kLinkCountField = 88;
+constexpr std::size_t kLinksOffsetField = 96;
+constexpr std::size_t kRowCountField = 32;
+constexpr std::size_t kEntitiesOffsetField = 40;
+
+template <typename T>
+T ReadAt(const std::vector<std::byte>& image, std::uint64_t offset) {
+  T value;
+  std::memcpy(&value, image.data() + offset, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void WriteAt(std::vector<std::byte>& image, std::uint64_t offset, const T& value) {
+  std::memcpy(image.data() + offset, &value, sizeof(T));
+}
+
+// Finds the offset of the ID of a row in the tables of an image.
+std::uint64_t FindRowOffset(const std::vector<std::byte>& image, const EntityID& entity_id) {
+  auto tables = ReadAt<std::uint64_t>(image, kTablesOffsetField);
+  for (std::uint64_t table = 0; table < ReadAt<std::uint64_t>(image, kTableCountField); ++table) {
+    auto record = ReadAt<std::uint64_t>(image, tables + table * sizeof(std::uint64_t));
+    auto entities = ReadAt<std::uint64_t>(image, record + kEntitiesOffsetField);
+    for (std::uint64_t row = 0; row < ReadAt<std::uint64_t>(image, record + kRowCountField); ++row) {
+      if (ReadAt<EntityID>(image, entities + row * sizeof(EntityID)) == entity_id) {
+        return entities + row * sizeof(EntityID);
+      }
+    }
+  }
+  FAIL("The entity is not stored in the image");
+  return 0;
+}
+
+// Finds the offset of the parent of an entity in the links of an image.
+std::uint64_t FindParentOffset(const std::vector<std::byte>& image, const EntityID& entity_id) {
+  auto links = ReadAt<std::uint64_t>(image, kLinksOffsetField);
+  for (std::uint64_t link = 0; link < ReadAt<std::uint64_t>(image, kLinkCountField); ++link) {
+    if (ReadAt<EntityID>(image, links + link * 2 * sizeof(EntityID)) == entity_id) {
+      return links + link * 2 * sizeof(EntityID) + sizeof(EntityID);
+    }
+  }
+  FAIL("The entity is not linked in the image");
+  return 0;
+}
+
+}  // namespace
+
+TEST_CASE("Snapshot") {
+  constexpr std::size_t kRootCount = 3000;
+  EntityCollection world;
+  std::vector<EntityID> roots = BuildWorld(world, kRootCount);
+
+  SECTION("Round trip through an image") {
+    EntityCollection loaded;
+    Snapshot::Load(loaded, Snapshot::Save(world));
+    RequireSameWorld(world, loaded, roots);
+
+    // The allocator continues where the saved one stopped, so both worlds issue the same IDs.
+    auto [expected_id, was_inserted] = world.Insert(ComponentCollection{});
+    REQUIRE(loaded.Insert(ComponentCollection{}).first == expected_id);
+    REQUIRE(loaded.Contains(roots[0]) == false);
+  }
+  SECTION("Round trip through a mapped file") {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "engine-snapshot-testing.bin";
+    Snapshot::Save(world, path);
+
+    EntityCollection adopted;
+    Snapshot::Load(adopted, path, SnapshotLoadMode::kAdopt);
+    RequireSameWorld(world, adopted, roots);
+    // Writes to adopted chunks stay private to the mapping, and new rows go to chunks of the arena.
+    adopted.At(roots[1]).Get<Position>()->x = 100;
+    ComponentCollection data;
+    data.Emplace<Position>(Position{1, 2});
+    data.Emplace<Velocity>();
+    for (int i = 0; i < 1000; ++i) {
+      static_cast<void>(adopted.Insert(data));
+    }
+    REQUIRE(adopted.At(roots[1]).Get<Position>()->x == 100);
+
+    EntityCollection copied;
+    Snapshot::Load(copied, path, SnapshotLoadMode::kCopy);
+    RequireSameWorld(world, copied, roots);
+
+    adopted.Reset();
+    std::filesystem::remove(path);
+  }
+  SECTION("Rejected snapshots") {
+    EntityCollection named;
+    ComponentCollection data;
+    data.Emplace<Name>(Name{"orc"});
+    static_cast<void>(named.Insert(data));
+    REQUIRE_THROWS_AS(Snapshot::Save(named), std::invalid_argument);
+
+    std::vector<std::byte> image = Snapshot::Save(world);
+    image[8] = std::byte{0xFF};
+    EntityCollection loaded;
+    static_cast<void>(loaded.Insert(data));
+    REQUIRE_THROWS_AS(Snapshot::Load(loaded, image), std::invalid_argument);
+    REQUIRE(loaded.Size() == 1);
+    image.resize(image.size() / 2);
+    REQUIRE_THROWS_AS(Snapshot::Load(loaded, image), std::invalid_argument);
+  }
+  SECTION("Malformed entity IDs are rejected") {
+    EntityCollection small;
+    ComponentCollection data;
+    data.Emplace<Position>();
+    EntityID parent_id = small.Insert(data).first;
+    EntityID other_id = small.Insert(data).first;
+    EntityID erased_id = small.Insert(data).first;
+    ComponentCollection child;
+    child.Emplace<Health>();
+    EntityID child_id = small.Insert(child, parent_id).first;
+    small.Erase(erased_id);
+    const std::vector<std::byte> image = Snapshot::Save(small);
+    auto generation_of = [&image](const EntityID& entity_id) {
+      return ReadAt<std::uint32_t>(image, ReadAt<std::uint64_t>(image, kGenerationsOffsetField) +
+                                              entity_id.GetIndex() * sizeof(std::uint32_t));
+    };
+
+    EntityCollection loaded;
+    static_cast<void>(loaded.Insert(data));
+    auto require_rejected = [&loaded](const std::vector<std::byte>& malformed) {
+      REQUIRE_THROWS_AS(Snapshot::Load(loaded, malformed), std::invalid_argument);
+      REQUIRE(loaded.Size() == 1);
+    };
+    std::vector<std::byte> malformed = image;
+    WriteAt(malformed, FindParentOffset(image, child_id), EntityID(1000, 0));
+    require_rejected(malformed);
+
+    malformed = image;
+    WriteAt(malformed, FindParentOffset(image, child_id), EntityID(erased_id.GetIndex(), generation_of(erased_id)));
+    require_rejected(malformed);
+
+    malformed = image;
+    WriteAt(malformed, FindRowOffset(image, other_id), parent_id);
+    require_rejected(malformed);
+
+    malformed = image;
+    WriteAt(malformed, FindRowOffset(image, other_id), EntityID(other_id.GetIndex(), other_id.GetGeneration() + 1));
+    require_rejected(malformed);
+
+    malformed = image;
+    WriteAt(malformed, ReadAt<std::uint64_t>(image, kFreeOffsetField), other_id.GetIndex());
+    require_rejected(malformed);
+
+    // Link dropped: the last link record is cut off.
+    malformed = image;
+    WriteAt(malformed, kLinkCountField, ReadAt<std::uint64_t>(image, kLinkCountField) - 1);
+    require_rejected(malformed);
+
+    // Free entry dropped: the slot of the erased entity is neither free nor stored.
+    malformed = image;
+    WriteAt(malformed, kFreeCountField, ReadAt<std::uint64_t>(image, kFreeCountField) - 1);
+    require_rejected(malformed);
+
+    Snapshot::Load(loaded, image);
+    REQUIRE(loaded.Size() == 3);
+    REQUIRE(loaded.GetParent(child_id) == parent_id);
+  }
+}
+
+// Run with `SnapshotTesting [benchmark]`.
+TEST_CASE("Snapshot load time", "[.benchmark]") {
+  constexpr std::size_t kRootCount = 100000;
+  EntityCollection world;
+  BuildWorld(world, kRootCount);
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "engine-snapshot-benchmark.bin";
+  Snapshot::Save(world, path);
+
+  BENCHMARK("Rebuild through Insert()") {
+    EntityCollection rebuilt;
+    BuildWorld(rebuilt, kRootCount);
+    return rebuilt.Size();
+  };
+  BENCHMARK("Snapshot::Load(), copied") {
+    EntityCollection loaded;
+    Snapshot::Load(loaded, path, SnapshotLoadMode::kCopy);
+    return loaded.Size();
+  };
+  BENCHMARK("Snapshot::Load(), adopted") {
+    EntityCollection loaded;
+    Snapshot::Load(loaded, path, SnapshotLoadMode::kAdopt);
+    return loaded.Size();
+  };
+  std::filesystem::remove(path);
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+struct Health {
+  int points{100};
+};
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/movement.h"
+#include "ecs/query.h"
+#include "ecs/snapshot-ring.h"
+#include "ecs/spatial-index.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Position;
+using engine::ecs::SnapshotRing;
+using engine::ecs::SpatialIndex;
+using engine::ecs::SpatialNeighbor;
+using engine::ecs::View;
+
+namespace {
+
+// A small deterministic generator, so that failures can be reproduced.
+float NextCoordinate(std::uint32_t& state) {
+  state = state * 1664525U + 1013904223U;
+  return static_cast<float>(state >> 8U) / static_cast<float>(1U << 24U) * 1000.0F;
+}
+
+std::vector<EntityID> InsertScattered(EntityCollection& entities, std::size_t count, std::uint32_t& state) {
+  std::vector<EntityID> ids;
+  for (std::size_t i = 0; i < count; ++i) {
+    ComponentCollection data;
+    float x = NextCoordinate(state);
+    data.Emplace<Position>(x, NextCoordinate(state));
+    if (i % 4 == 0) {
+      data.Emplace<Health>();
+    }
+    ids.push_back(entities.Insert(std::move(data)).first);
+  }
+  return ids;
+}
+
+std::vector<EntityID> BruteForceRadius(EntityCollection& entities, float x, float y, float radius) {
+  std::vector<EntityID> found;
+  View<const Position>(entities).Each([&](const EntityID& id, const Position& position) {
+    float delta_x = position.x_coord - x;
+    float delta_y = position.y_coord - y;
+    if (delta_x * delta_x + delta_y * delta_y <= radius * radius) {
+      found.push_back(id);
+    }
+  });
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+// Checks every kind of query against a scan of the whole collection, around a few points.
+void RequireMatchesCollection(const SpatialIndex& index, EntityCollection& entities) {
+  REQUIRE(index.Size() == View<const Position>(entities).Count());
+  std::vector<EntityID> buffer(index.Size());
+  for (auto [x, y, radius] : {std::tuple{500.0F, 500.0F, 25.0F}, std::tuple{0.0F, 1000.0F, 80.0F},
+                              std::tuple{123.4F, 876.5F, 5.0F}, std::tuple{500.0F, 500.0F, 2000.0F}}) {
+    std::vector<EntityID> expected = BruteForceRadius(entities, x, y, radius);
+    std::size_t count = index.QueryRadius(x, y, radius, buffer);
+    std::vector<EntityID> found(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == expected);
+
+    std::vector<EntityID> in_box;
+    View<const Position>(entities).Each([&](const EntityID& id, const Position& position) {
+      if (position.x_coord >= x - radius && position.x_coord <= x + radius && position.y_coord >= y &&
+          position.y_coord <= y + radius) {
+        in_box.push_back(id);
+      }
+    });
+    std::sort(in_box.begin(), in_box.end());
+    count = index.QueryBox(x - radius, y, x + radius, y + radius, buffer);
+    found.assign(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == in_box);
+
+    std::vector<SpatialNeighbor> nearest(7);
+    REQUIRE(index.QueryNearest(x, y, nearest) == 7);
+    std::vector<float> expected_distances;
+    View<const Position>(entities).Each([&](const Position& position) {
+      float delta_x = position.x_coord - x;
+      float delta_y = position.y_coord - y;
+      expected_distances.push_back(delta_x * delta_x + delta_y * delta_y);
+    });
+    std::sort(expected_distances.begin(), expected_distances.end());
+    for (std::size_t i = 0; i < nearest.size(); ++i) {
+      REQUIRE(nearest[i].distance_squared == expected_distances[i]);
+      const auto* position = std::as_const(entities).At(nearest[i].entity_id).Get<Position>();
+      float delta_x = position->x_coord - x;
+      float delta_y = position->y_coord - y;
+      REQUIRE(delta_x * delta_x + delta_y * delta_y == expected_distances[i]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("SpatialIndex") {
+  std::uint32_t state = 7;
+  EntityCollection entities;
+  std::vector<EntityID> ids = InsertScattered(entities, 3000, state);
+  SpatialIndex index(10.0F);
+  index.Update(entities);
+  REQUIRE(index.GetLastStatistics().inserted == ids.size());
+  RequireMatchesCollection(index, entities);
+
+  SECTION("Only entities that cross cells are moved") {
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().updated == 0);
+    REQUIRE(index.GetLastStatistics().moved == 0);
+
+    // The first entity stays in its cell, the second one jumps across the world.
+    auto* position = entities.At(ids[0]).Get<Position>();
+    position->x_coord = std::floor(position->x_coord / 10.0F) * 10.0F + 5.0F;
+    auto* jumper = entities.At(ids[1]).Get<Position>();
+    jumper->x_coord = 1000.0F - jumper->x_coord + 10.0F;
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().updated == 1);
+    REQUIRE(index.GetLastStatistics().moved == 1);
+    RequireMatchesCollection(index, entities);
+  }
+  SECTION("Structural changes are followed") {
+    for (std::size_t i = 0; i < 100; ++i) {
+      entities.Remove<Position>(ids[i]);
+    }
+    for (std::size_t i = 100; i < 300; ++i) {
+      entities.Erase(ids[i]);
+    }
+    std::vector<EntityID> added = InsertScattered(entities, 150, state);
+    entities.Emplace<Position>(ids[0], 1.0F, 1.0F);
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().removed == 299);
+    REQUIRE(index.GetLastStatistics().inserted == 150);
+    REQUIRE(index.GetLastStatistics().updated + index.GetLastStatistics().moved == 1);
+    RequireMatchesCollection(index, entities);
+
+    entities.Clear();
+    index.Update(entities);
+    REQUIRE(index.Size() == 0);
+    std::vector<SpatialNeighbor> nearest(3);
+    REQUIRE(index.QueryNearest(0.0F, 0.0F, nearest) == 0);
+  }
+  SECTION("Rollbacks are followed") {
+    ComponentCollection data;
+    data.Emplace<Health>();
+    EntityID late_id = entities.Insert(std::move(data)).first;
+    SnapshotRing ring(1);
+    ring.Save(entities);
+    entities.Emplace<Position>(late_id, 5.0F, 5.0F);
+    index.Update(entities);
+    REQUIRE(index.Size() == ids.size() + 1);
+
+    // The restored entity loses its Position without a removal record.
+    REQUIRE(ring.Restore(entities) == true);
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().removed == 1);
+    RequireMatchesCollection(index, entities);
+    std::vector<EntityID> found(ids.size());
+    found.resize(index.QueryRadius(5.0F, 5.0F, 1.0F, found));
+    REQUIRE(std::find(found.begin(), found.end(), late_id) == found.end());
+  }
+  SECTION("Small buffers receive the first results") {
+    std::vector<EntityID> buffer(4);
+    std::size_t count = index.QueryRadius(500.0F, 500.0F, 100.0F, buffer);
+    REQUIRE(count == BruteForceRadius(entities, 500.0F, 500.0F, 100.0F).size());
+    REQUIRE(count > buffer.size());
+
+    std::vector<SpatialNeighbor> nearest(ids.size() + 5);
+    REQUIRE(index.QueryNearest(10.0F, 10.0F, nearest) == ids.size());
+  }
+  SECTION("Cells that share a bucket are reported once") {
+    SpatialIndex crowded(10.0F, 4);
+    crowded.Update(entities);
+    RequireMatchesCollection(crowded, entities);
+  }
+  SECTION("Invalid cell sizes are rejected") {
+    REQUIRE_THROWS_AS(SpatialIndex(0.0F), std::invalid_argument);
+  }
+}
+
+// Run with `SpatialIndexTesting [benchmark]`.
+TEST_CASE("SpatialIndex query time", "[.benchmark]") {
+  std::uint32_t state = 11;
+  EntityCollection entities;
+  std::vector<EntityID> ids = InsertScattered(entities, 100000, state);
+  SpatialIndex index(10.0F, 16384);
+  index.Update(entities);
+  std::vector<EntityID> buffer(1024);
+  std::vector<SpatialNeighbor> nearest(16);
+
+  BENCHMARK("Radius query by filtering every entity") { return BruteForceRadius(entities, 500, 500, 10).size(); };
+  BENCHMARK("SpatialIndex::QueryRadius()") { return index.QueryRadius(500, 500, 10, buffer); };
+  BENCHMARK("SpatialIndex::QueryNearest(), 16 neighbours") { return index.QueryNearest(500, 500, nearest); };
+  BENCHMARK("SpatialIndex::Update(), 1% of the entities moved") {
+    for (std::size_t i = 0; i < ids.size(); i += 100) {
+      entities.At(ids[i]).Get<Position>()->x_coord = NextCoordinate(state);
+    }
+    index.Update(entities);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "ecs/change-tick.h"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query.h"
+#include "ecs/transform-system.h"
+#include "ecs/transform.h"
+#include "jobs/job-system.h"
+using engine::ecs::Changed;
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::LocalTransform;
+using engine::ecs::Query;
+using engine::ecs::Tick;
+using engine::ecs::Transform;
+using engine::ecs::TransformSystem;
+using engine::ecs::View;
+using engine::ecs::With;
+using engine::ecs::Without;
+using engine::jobs::JobSystem;
+
+namespace {
+
+EntityID InsertNode(EntityCollection& entities, const LocalTransform& local,
+                    const EntityID& parent_id = EntityID::GetRootID()) {
+  ComponentCollection data;
+  data.Emplace<LocalTransform>(local);
+  data.Emplace<Transform>();
+  return entities.Insert(std::move(data), parent_id).first;
+}
+
+}  // namespace
+
+TEST_CASE("TransformSystem propagation") {
+  EntityCollection entities;
+  TransformSystem system;
+  EntityID vehicle_id = InsertNode(entities, LocalTransform(10, 0, 0, 2));
+  EntityID turret_id = InsertNode(entities, LocalTransform(1, 1), vehicle_id);
+  EntityID barrel_id = InsertNode(entities, LocalTransform(0, 1), turret_id);
+  EntityID rock_id = InsertNode(entities, LocalTransform(5, 5));
+
+  system.Update(entities);
+  REQUIRE(system.GetLastStatistics().recomputed == 4);
+  REQUIRE(system.GetLastStatistics().skipped == 0);
+  REQUIRE(entities.At(turret_id).Get<Transform>()->x_coord == Approx(12));
+  REQUIRE(entities.At(barrel_id).Get<Transform>()->y_coord == Approx(4));
+  REQUIRE(entities.At(barrel_id).Get<Transform>()->scale == Approx(2));
+
+  SECTION("Clean frames are skipped") {
+    system.Update(entities);
+    REQUIRE(system.GetLastStatistics().recomputed == 0);
+    REQUIRE(system.GetLastStatistics().skipped == 4);
+  }
+  SECTION("Dirty subtrees are recomputed") {
+    auto* local = entities.At(turret_id).Get<LocalTransform>();
+    local->rotation = 1.5707964F;
+    local->MarkDirty();
+    system.Update(entities);
+    REQUIRE(system.GetLastStatistics().recomputed == 2);
+    REQUIRE(system.GetLastStatistics().skipped == 2);
+    REQUIRE(entities.At(barrel_id).Get<Transform>()->x_coord == Approx(10));
+    REQUIRE(entities.At(barrel_id).Get<Transform>()->y_coord == Approx(2));
+    REQUIRE(entities.At(rock_id).Get<Transform>()->x_coord == Approx(5));
+  }
+  SECTION("Parents are only read") {
+    Tick since = entities.GetChangeTick();
+    entities.AdvanceChangeTick();
+    entities.At(barrel_id).Get<LocalTransform>()->MarkDirty();
+    system.Update(entities);
+    std::vector<EntityID> changed;
+    Query<With<const Transform>, Without<>, Changed<Transform>>(entities, since)
+        .Each([&changed](const EntityID& id, const Transform&) { changed.push_back(id); });
+    REQUIRE(changed == std::vector<EntityID>{barrel_id});
+  }
+  SECTION("Reparented entities") {
+    REQUIRE(entities.SetParent(barrel_id, rock_id) == true);
+    entities.At(barrel_id).Get<LocalTransform>()->MarkDirty();
+    system.Update(entities);
+    REQUIRE(system.GetLastStatistics().recomputed == 1);
+    REQUIRE(entities.At(barrel_id).Get<Transform>()->x_coord == Approx(5));
+    REQUIRE(entities.At(barrel_id).Get<Transform>()->y_coord == Approx(6));
+  }
+}
+
+TEST_CASE("TransformSystem parallel roots") {
+  constexpr std::size_t kRootCount = 1000;
+  constexpr std::size_t kChildCount = 4;
+  EntityCollection entities;
+  std::vector<EntityID> roots;
+  for (std::size_t i = 0; i < kRootCount; ++i) {
+    roots.push_back(InsertNode(entities, LocalTransform(static_cast<float>(i), 0)));
+    for (std::size_t j = 0; j < kChildCount; ++j) {
+      static_cast<void>(InsertNode(entities, LocalTransform(0, static_cast<float>(j)), roots.back()));
+    }
+  }
+
+  JobSystem jobs(4);
+  TransformSystem system(&jobs);
+  system.Update(entities);
+  REQUIRE(system.GetLastStatistics().recomputed == kRootCount * (kChildCount + 1));
+
+  for (std::size_t i = 0; i < kRootCount; i += 2) {
+    entities.At(roots[i]).Get<LocalTransform>()->MarkDirty();
+  }
+  system.Update(entities);
+  REQUIRE(system.GetLastStatistics().recomputed == kRootCount / 2 * (kChildCount + 1));
+  REQUIRE(system.GetLastStatistics().skipped == kRootCount / 2 * (kChildCount + 1));
+
+  std::size_t matching = 0;
+  entities.GetHierarchy().ForEach([&entities, &matching](const EntityID& id) {
+    const auto* world = std::as_const(entities).At(id).Get<Transform>();
+    const auto* local = std::as_const(entities).At(id).Get<LocalTransform>();
+    EntityID parent_id = entities.GetParent(id);
+    float expected_x = local->x_coord;
+    if (parent_id != EntityID::GetRootID()) {
+      expected_x = std::as_const(entities).At(parent_id).Get<Transform>()->x_coord;
+    }
+    matching += world->x_coord == expected_x ? 1 : 0;
+  });
+  REQUIRE(matching == kRootCount * (kChildCount + 1));
+}
+
+TEST_CASE("TransformSystem parallel roots in one chunk") {
+  // Childless roots are packed into one chunk, so jobs stamp changes of rows of the same chunk concurrently.
+  constexpr std::size_t kRootCount = 256;
+  EntityCollection entities;
+  std::vector<EntityID> roots;
+  for (std::size_t i = 0; i < kRootCount; ++i) {
+    roots.push_back(InsertNode(entities, LocalTransform(static_cast<float>(i), 0)));
+  }
+  std::size_t chunk_count = 0;
+  View<const Transform>(entities).EachChunk(
+      [&chunk_count](std::span<const EntityID>, std::span<const Transform>) { ++chunk_count; });
+  REQUIRE(chunk_count == 1);
+
+  JobSystem jobs(4);
+  TransformSystem system(&jobs);
+  for (std::size_t frame = 0; frame < 20; ++frame) {
+    Tick since = entities.GetChangeTick();
+    entities.AdvanceChangeTick();
+    for (const EntityID& root_id : roots) {
+      entities.At(root_id).Get<LocalTransform>()->MarkDirty();
+    }
+    system.Update(entities);
+    REQUIRE(system.GetLastStatistics().recomputed == kRootCount);
+
+    std::size_t changed = 0;
+    Query<With<const Transform>, Without<>, Changed<Transform>>(entities, since)
+        .Each([&changed](const EntityID&, const Transform&) { ++changed; });
+    REQUIRE(changed == kRootCount);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+struct NetworkID {
+  std::uint32_t value{0};
+};
+
+struct Faction {
+  int rank{0};
+  float morale{1.0F};
+};
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/entity-ref.h"
+#include "ecs/query.h"
+#include "ecs/snapshot-ring.h"
+#include "ecs/value-index.h"
+using engine::ecs::ComponentCollection;
+using engine::ecs::ConstEntityRef;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::HashIndex;
+using engine::ecs::OrderedIndex;
+using engine::ecs::SnapshotRing;
+using engine::ecs::View;
+
+namespace {
+
+using NetworkIndex = HashIndex<&NetworkID::value>;
+using RankIndex = OrderedIndex<&Faction::rank>;
+
+std::vector<EntityID> InsertPlayers(EntityCollection& entities, std::size_t count, std::uint32_t key_count) {
+  std::vector<EntityID> ids;
+  for (std::size_t i = 0; i < count; ++i) {
+    ComponentCollection data;
+    data.Emplace<NetworkID>(static_cast<std::uint32_t>(i % key_count));
+    if (i % 3 == 0) {
+      data.Emplace<Faction>(static_cast<int>(i % 100), 1.0F);
+    }
+    ids.push_back(entities.Insert(std::move(data)).first);
+  }
+  return ids;
+}
+
+std::vector<EntityID> Sorted(std::span<const EntityID> ids) {
+  std::vector<EntityID> sorted(ids.begin(), ids.end());
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+// Checks lookups of every key against a scan of the whole collection.
+void RequireMatchesCollection(const NetworkIndex& index, EntityCollection& entities, std::uint32_t key_count) {
+  REQUIRE(index.Size() == View<const NetworkID>(entities).Count());
+  for (std::uint32_t key = 0; key <= key_count; ++key) {
+    std::vector<EntityID> expected = std::as_const(entities).Filter([key](const ConstEntityRef& entity) {
+      const auto* network_id = entity.Get<NetworkID>();
+      return network_id != nullptr && network_id->value == key;
+    });
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(Sorted(index.Find(key)) == expected);
+  }
+}
+
+void RequireMatchesCollection(const RankIndex& index, EntityCollection& entities) {
+  REQUIRE(index.Size() == View<const Faction>(entities).Count());
+  for (auto [min, max] : {std::pair{0, 99}, std::pair{10, 20}, std::pair{-5, 3}, std::pair{42, 42}, std::pair{7, 6}}) {
+    std::vector<EntityID> expected = std::as_const(entities).Filter([min, max](const ConstEntityRef& entity) {
+      const auto* faction = entity.Get<Faction>();
+      return faction != nullptr && faction->rank >= min && faction->rank <= max;
+    });
+    std::sort(expected.begin(), expected.end());
+    std::vector<EntityID> found;
+    int previous = min;
+    index.ForEachInRange(min, max, [&](const EntityID& entity_id, int rank) {
+      REQUIRE(rank >= previous);
+      REQUIRE(std::as_const(entities).At(entity_id).Get<Faction>()->rank == rank);
+      previous = rank;
+      found.push_back(entity_id);
+    });
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == expected);
+    REQUIRE(index.CountInRange(min, max) == expected.size());
+  }
+}
+
+}  // namespace
+
+TEST_CASE("HashIndex") {
+  EntityCollection entities;
+  std::vector<EntityID> ids = InsertPlayers(entities, 1000, 64);
+  NetworkIndex index;
+  index.Update(entities);
+  REQUIRE(index.GetLastStatistics().inserted == ids.size());
+  REQUIRE(index.KeyCount() == 64);
+  RequireMatchesCollection(index, entities, 64);
+
+  SECTION("Only entities whose key changed are moved") {
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().unchanged == 0);
+    REQUIRE(index.GetLastStatistics().rekeyed == 0);
+
+    static_cast<void>(entities.At(ids[0]).Get<NetworkID>());
+    entities.At(ids[1]).Get<NetworkID>()->value = 64;
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().unchanged == 1);
+    REQUIRE(index.GetLastStatistics().rekeyed == 1);
+    REQUIRE(index.Find(64).size() == 1);
+    REQUIRE(index.Find(64)[0] == ids[1]);
+    RequireMatchesCollection(index, entities, 64);
+  }
+  SECTION("Structural changes are followed") {
+    for (std::size_t i = 0; i < 100; ++i) {
+      entities.Remove<NetworkID>(ids[i]);
+    }
+    for (std::size_t i = 100; i < 300; ++i) {
+      entities.Erase(ids[i]);
+    }
+    // The new entities reuse the indices of the erased ones.
+    std::vector<EntityID> added = InsertPlayers(entities, 150, 64);
+    entities.Emplace<NetworkID>(ids[0], 7U);
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().removed == 299);
+    REQUIRE(index.GetLastStatistics().inserted == 150);
+    REQUIRE(index.GetLastStatistics().rekeyed + index.GetLastStatistics().unchanged == 1);
+    RequireMatchesCollection(index, entities, 64);
+
+    entities.Clear();
+    index.Update(entities);
+    REQUIRE(index.Size() == 0);
+    REQUIRE(index.KeyCount() == 0);
+    REQUIRE(index.Find(7).empty());
+  }
+  SECTION("Another collection rebuilds the index") {
+    EntityCollection other;
+    InsertPlayers(other, 10, 5);
+    index.Update(other);
+    REQUIRE(index.GetLastStatistics().inserted == 10);
+    RequireMatchesCollection(index, other, 5);
+  }
+}
+
+TEST_CASE("OrderedIndex") {
+  EntityCollection entities;
+  std::vector<EntityID> ids = InsertPlayers(entities, 900, 64);
+  RankIndex index;
+  index.Update(entities);
+  REQUIRE(index.GetLastStatistics().inserted == 300);
+  RequireMatchesCollection(index, entities);
+
+  SECTION("Writes to other fields keep the key") {
+    entities.At(ids[3]).Get<Faction>()->morale = 0.5F;
+    entities.At(ids[6]).Get<Faction>()->rank = -1;
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().unchanged == 1);
+    REQUIRE(index.GetLastStatistics().rekeyed == 1);
+    REQUIRE(index.CountInRange(-1, -1) == 1);
+    RequireMatchesCollection(index, entities);
+  }
+  SECTION("Structural changes are followed") {
+    for (std::size_t i = 0; i < 90; i += 3) {
+      entities.Remove<Faction>(ids[i]);
+    }
+    for (std::size_t i = 1; i < 900; i += 3) {
+      entities.Emplace<Faction>(ids[i], 50, 1.0F);
+    }
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().removed == 30);
+    REQUIRE(index.GetLastStatistics().inserted == 300);
+    RequireMatchesCollection(index, entities);
+  }
+  SECTION("Rollbacks are followed") {
+    SnapshotRing ring(1);
+    ring.Save(entities);
+    entities.Emplace<Faction>(ids[1], 50, 1.0F);
+    index.Update(entities);
+    REQUIRE(index.Size() == 301);
+
+    // The restored entity loses its Faction without a removal record.
+    REQUIRE(ring.Restore(entities) == true);
+    index.Update(entities);
+    REQUIRE(index.GetLastStatistics().removed == 1);
+    RequireMatchesCollection(index, entities);
+  }
+}
+
+// Run with `ValueIndexTesting [benchmark]`.
+TEST_CASE("ValueIndex lookup time", "[.benchmark]") {
+  EntityCollection entities;
+  std::vector<EntityID> ids = InsertPlayers(entities, 100000, 50000);
+  NetworkIndex network_index;
+  network_index.Update(entities);
+  RankIndex rank_index;
+  rank_index.Update(entities);
+  const EntityCollection& const_entities = entities;
+
+  BENCHMARK("Equality lookup by EntityCollection::Filter()") {
+    return const_entities
+        .Filter([](const ConstEntityRef& entity) {
+          const auto* network_id = entity.Get<NetworkID>();
+          return network_id != nullptr && network_id->value == 1234;
+        })
+        .size();
+  };
+  BENCHMARK("HashIndex::Find()") { return network_index.Find(1234).size(); };
+  BENCHMARK("Range count by EntityCollection::CountIf()") {
+    return entities.CountIf([](const ConstEntityRef& entity) {
+      const auto* faction = entity.Get<Faction>();
+      return faction != nullptr && faction->rank >= 40 && faction->rank <= 45;
+    });
+  };
+  BENCHMARK("OrderedIndex::CountInRange()") { return rank_index.CountInRange(40, 45); };
+  BENCHMARK("HashIndex::Update(), 1% of the keys written") {
+    for (std::size_t i = 0; i < ids.size(); i += 100) {
+      ++entities.At(ids[i]).Get<NetworkID>()->value;
+    }
+    network_index.Update(entities);
+  };
+}
\ No newline at end of file
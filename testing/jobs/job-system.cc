@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "jobs/job-system.h"
+using engine::jobs::JobCounter;
+using engine::jobs::JobSystem;
+
+TEST_CASE("JobSystem Scheduling") {
+  JobSystem jobs(3);
+  REQUIRE(jobs.WorkerCount() == 3);
+
+  SECTION("Method Schedule()") {
+    std::atomic<std::size_t> executed{0};
+    JobCounter counter;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      jobs.Schedule(counter, [&executed] { executed.fetch_add(1); });
+    }
+    jobs.Wait(counter);
+    REQUIRE(counter.IsDone() == true);
+    REQUIRE(executed.load() == 1000);
+  }
+  SECTION("Nested jobs") {
+    std::atomic<std::size_t> executed{0};
+    JobCounter outer;
+    for (std::size_t i = 0; i < 16; ++i) {
+      jobs.Schedule(outer, [&jobs, &executed] {
+        JobCounter inner;
+        for (std::size_t j = 0; j < 16; ++j) {
+          jobs.Schedule(inner, [&executed] { executed.fetch_add(1); });
+        }
+        jobs.Wait(inner);
+      });
+    }
+    jobs.Wait(outer);
+    REQUIRE(executed.load() == 256);
+  }
+  SECTION("Method ParallelFor()") {
+    std::vector<int> visits(10007, 0);
+    jobs.ParallelFor(visits.size(), 64, [&visits](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        visits[i]++;
+      }
+    });
+    REQUIRE(std::accumulate(visits.begin(), visits.end(), 0) == 10007);
+    REQUIRE(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+  }
+}
+
+TEST_CASE("JobSystem Deterministic Reduction") {
+  std::vector<float> values(100000);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = 1.0F / static_cast<float>(i + 1);
+  }
+  auto sum = [&values](JobSystem& jobs) {
+    return jobs.ParallelReduce(
+        values.size(), 1000, 0.0F,
+        [&values](std::size_t begin, std::size_t end) {
+          float partial = 0.0F;
+          for (std::size_t i = begin; i < end; ++i) {
+            partial += values[i];
+          }
+          return partial;
+        },
+        [](float accumulated, float partial) { return accumulated + partial; });
+  };
+
+  JobSystem serial(0);
+  float expected = sum(serial);
+  for (std::size_t worker_count : {1, 2, 7}) {
+    JobSystem jobs(worker_count);
+    for (int repeat = 0; repeat < 5; ++repeat) {
+      REQUIRE(sum(jobs) == expected);
+    }
+  }
+}
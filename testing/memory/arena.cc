@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <cstdint>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "memory/arena.h"
+using engine::memory::Arena;
+
+TEST_CASE("Arena Allocation") {
+  Arena arena(4096);
+
+  SECTION("Method Allocate()") {
+    void* first = arena.Allocate(100, 8);
+    void* second = arena.Allocate(100, 8);
+    REQUIRE(first != second);
+    REQUIRE(arena.BytesUsed() >= 200);
+    REQUIRE(arena.BytesReserved() == 4096);
+    REQUIRE(arena.Statistics().allocations == 2);
+    REQUIRE(arena.Statistics().upstream_allocations == 1);
+  }
+  SECTION("Alignment") {
+    for (std::size_t alignment : {1, 2, 8, 16, 64, 256, 1024}) {
+      static_cast<void>(arena.Allocate(3, 1));
+      void* memory = arena.Allocate(24, alignment);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(memory) % alignment == 0);
+    }
+  }
+  SECTION("Large allocations") {
+    static_cast<void>(arena.Allocate(16, 16));
+    void* memory = arena.Allocate(10000, 16);
+    REQUIRE(memory != nullptr);
+    REQUIRE(arena.BytesReserved() >= 4096 + 10000);
+  }
+}
+
+TEST_CASE("Arena Recycling") {
+  Arena arena(4096);
+  for (std::size_t i = 0; i < 10; ++i) {
+    static_cast<void>(arena.Allocate(1000, 16));
+  }
+  std::size_t reserved = arena.BytesReserved();
+  std::size_t upstream_allocations = arena.Statistics().upstream_allocations;
+
+  SECTION("Method Reset()") {
+    arena.Reset();
+    REQUIRE(arena.BytesUsed() == 0);
+    REQUIRE(arena.BytesReserved() == reserved);
+    for (std::size_t i = 0; i < 10; ++i) {
+      static_cast<void>(arena.Allocate(1000, 16));
+    }
+    REQUIRE(arena.Statistics().upstream_allocations == upstream_allocations);
+    REQUIRE(arena.BytesReserved() == reserved);
+  }
+  SECTION("Method Release()") {
+    arena.Release();
+    REQUIRE(arena.BytesUsed() == 0);
+    REQUIRE(arena.BytesReserved() == 0);
+    static_cast<void>(arena.Allocate(1000, 16));
+    REQUIRE(arena.Statistics().upstream_allocations == upstream_allocations + 1);
+  }
+}
@@ -0,0 +1,162 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "memory/pool-allocator.h"
+using engine::memory::GetPoolStatistics;
+using engine::memory::PoolAllocator;
+using engine::memory::SizeClassPool;
+
+#include "ecs/component-base.h"
+#include "ecs/component-collection.h"
+#include "ecs/component-signature.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+using engine::ecs::ComponentBase;
+using engine::ecs::ComponentCollection;
+using engine::ecs::ComponentSignature;
+using engine::ecs::ComponentSignatureOf;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+
+namespace {
+
+std::size_t global_allocations = 0;  ///< Calls to the global operator new made by the test executable.
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++global_allocations;
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  ++global_allocations;
+  auto align = static_cast<std::size_t>(alignment);
+  if (void* memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+// Once these are inlined, GCC sees free() release memory from operator new, unaware that the replacements match.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t /*size*/) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t /*alignment*/) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  std::free(memory);
+}
+#pragma GCC diagnostic pop
+
+struct Health final : public ComponentBase {
+  int value{100};
+};
+
+struct Velocity final : public ComponentBase {
+  float x{0.0F};
+  float y{0.0F};
+};
+
+TEST_CASE("PoolAllocator Allocation") {
+  SECTION("Block reuse") {
+    PoolAllocator<std::uint64_t> allocator;
+    std::uint64_t* first = allocator.allocate(3);
+    allocator.deallocate(first, 3);
+    std::uint64_t* second = allocator.allocate(3);
+    REQUIRE(first == second);
+    allocator.deallocate(second, 3);
+  }
+  SECTION("Alignment") {
+    PoolAllocator<std::max_align_t> allocator;
+    std::max_align_t* memory = allocator.allocate(1);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(memory) % alignof(std::max_align_t) == 0);
+    allocator.deallocate(memory, 1);
+  }
+  SECTION("Oversized requests") {
+    auto before = GetPoolStatistics();
+    PoolAllocator<std::byte> allocator;
+    std::byte* memory = allocator.allocate(100000);
+    allocator.deallocate(memory, 100000);
+    auto after = GetPoolStatistics();
+    REQUIRE(after.upstream_allocations == before.upstream_allocations + 1);
+    REQUIRE(after.deallocations == before.deallocations + 1);
+  }
+  SECTION("Standard containers") {
+    std::vector<int, PoolAllocator<int>> values;
+    std::unordered_set<int, std::hash<int>, std::equal_to<int>, PoolAllocator<int>> set;
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(i);
+      set.insert(i);
+    }
+    REQUIRE(values.size() == 100);
+    REQUIRE(set.size() == 100);
+    auto shared = std::allocate_shared<Health>(PoolAllocator<Health>{});
+    REQUIRE(shared->value == 100);
+  }
+}
+
+TEST_CASE("SizeClassPool Recycling") {
+  SizeClassPool pool(32);
+  REQUIRE(pool.BlockSize() == 32);
+
+  std::vector<void*> blocks;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    blocks.push_back(pool.Allocate());
+  }
+  for (void* block : blocks) {
+    pool.Deallocate(block);
+  }
+  auto warm = pool.Statistics();
+  for (std::size_t i = 0; i < 1000; ++i) {
+    blocks[i] = pool.Allocate();
+  }
+  for (void* block : blocks) {
+    pool.Deallocate(block);
+  }
+  auto steady = pool.Statistics();
+  REQUIRE(steady.upstream_allocations == warm.upstream_allocations);
+  REQUIRE(steady.allocations == 2000);
+  REQUIRE(steady.deallocations == 2000);
+}
+
+TEST_CASE("Steady state frames") {
+  EntityCollection entities;
+  ComponentSignature signature = ComponentSignatureOf<Health, Velocity>();
+  std::vector<EntityID> spawned;
+  spawned.reserve(256);
+
+  auto frame = [&entities, &signature, &spawned] {
+    ComponentCollection prototype;
+    prototype.Emplace<Health>();
+    prototype.Emplace<Velocity>();
+    auto [single_id, inserted] = entities.Insert(prototype);
+    std::span<const EntityID> batch = entities.InsertBatch(200, signature);
+    spawned.assign(batch.begin(), batch.end());
+    spawned.push_back(single_id);
+    entities.EraseBatch(spawned);
+    return inserted;
+  };
+
+  // The first frame creates the archetype table and grows every buffer to its high-water mark.
+  REQUIRE(frame() == true);
+  REQUIRE(frame() == true);
+
+  std::size_t allocations_before = global_allocations;
+  bool inserted = frame();
+  std::size_t allocations_after = global_allocations;
+  REQUIRE(inserted == true);
+  REQUIRE(allocations_after == allocations_before);
+  REQUIRE(entities.Size() == 0);
+}
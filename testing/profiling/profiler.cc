@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Position {
+  float x_coord{0.0F};
+};
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "ecs/command-buffer.h"
+#include "ecs/component-collection.h"
+#include "ecs/entity-collection.h"
+#include "ecs/entity-id.h"
+#include "ecs/query.h"
+#include "ecs/scheduler.h"
+#include "ecs/system.h"
+#include "jobs/job-system.h"
+#include "profiling/profiler.h"
+using engine::ecs::CommandBuffer;
+using engine::ecs::ComponentCollection;
+using engine::ecs::EntityCollection;
+using engine::ecs::EntityID;
+using engine::ecs::Scheduler;
+using engine::ecs::System;
+using engine::ecs::View;
+using engine::jobs::JobCounter;
+using engine::jobs::JobSystem;
+using engine::profiling::ProfileZone;
+using engine::profiling::Profiler;
+using engine::profiling::ZoneSummary;
+
+namespace {
+
+class IntegrationSystem final : public System {
+ public:
+  IntegrationSystem() : System("Integration") { DeclareWrites<Position>(); }
+
+  void Update(EntityCollection& entities) override {
+    View<Position>(entities).Each([](Position& position) { position.x_coord += 1.0F; });
+  }
+};
+
+const ZoneSummary* FindZone(const std::vector<ZoneSummary>& summaries, const std::string& name) {
+  auto found = std::find_if(summaries.begin(), summaries.end(),
+                            [&name](const ZoneSummary& summary) { return summary.name == name; });
+  return found != summaries.end() ? &*found : nullptr;
+}
+
+}  // namespace
+
+TEST_CASE("Profiler") {
+  Profiler::Clear();
+  Profiler::SetEnabled(true);
+
+  SECTION("Zones are recorded only while enabled") {
+    Profiler::SetEnabled(false);
+    { const ProfileZone zone("Disabled"); }
+    Profiler::SetEnabled(true);
+    { const ProfileZone zone("Enabled"); }
+    std::vector<ZoneSummary> summaries = Profiler::Summarize();
+    REQUIRE(FindZone(summaries, "Disabled") == nullptr);
+    REQUIRE(FindZone(summaries, "Enabled") != nullptr);
+    REQUIRE(FindZone(summaries, "Enabled")->count == 1);
+
+    Profiler::Clear();
+    REQUIRE(Profiler::Summarize().empty());
+  }
+  SECTION("Percentiles use the nearest rank") {
+    for (std::uint64_t duration = 100; duration > 0; --duration) {
+      Profiler::Record("Known", 1000, 1000 + duration);
+    }
+    std::vector<ZoneSummary> summaries = Profiler::Summarize();
+    REQUIRE(summaries.size() == 1);
+    REQUIRE(summaries[0].count == 100);
+    REQUIRE(summaries[0].p50 == std::chrono::nanoseconds(50));
+    REQUIRE(summaries[0].p99 == std::chrono::nanoseconds(99));
+    REQUIRE(summaries[0].max == std::chrono::nanoseconds(100));
+  }
+  SECTION("Rings keep the latest events") {
+    for (std::size_t i = 0; i < Profiler::kThreadCapacity + 10; ++i) {
+      Profiler::Record(i < 10 ? "Oldest" : "Latest", i, i + 1);
+    }
+    std::vector<ZoneSummary> summaries = Profiler::Summarize();
+    REQUIRE(FindZone(summaries, "Oldest") == nullptr);
+    REQUIRE(FindZone(summaries, "Latest")->count == Profiler::kThreadCapacity);
+  }
+  SECTION("Names are interned") {
+    std::string name = "Runtime";
+    const char* interned = Profiler::Intern(name);
+    name = "Changed";
+    REQUIRE(std::string(interned) == "Runtime");
+    REQUIRE(Profiler::Intern("Runtime") == interned);
+  }
+  SECTION("Every thread records into its own ring") {
+    JobSystem jobs(3);
+    JobCounter counter;
+    for (std::size_t i = 0; i < 256; ++i) {
+      jobs.Schedule(counter, [] { const ProfileZone zone("Job"); });
+    }
+    jobs.Wait(counter);
+    REQUIRE(FindZone(Profiler::Summarize(), "Job")->count == 256);
+  }
+  SECTION("Events are exported as a Chrome trace") {
+    Profiler::Record("Quoted \"name\"", 2000, 3500);
+    Profiler::Record("Plain", 1000, 1250);
+    std::ostringstream trace;
+    Profiler::WriteChromeTrace(trace);
+    std::string text = trace.str();
+    REQUIRE(text.find("\"traceEvents\":[") != std::string::npos);
+    REQUIRE(text.find("\"thread_name\"") != std::string::npos);
+    REQUIRE(text.find(R"({"name":"Plain","cat":"engine","ph":"X","ts":0.000,"dur":0.250,)") != std::string::npos);
+    REQUIRE(text.find(R"({"name":"Quoted \"name\"","cat":"engine","ph":"X","ts":1.000,"dur":1.500,)") !=
+            std::string::npos);
+  }
+  Profiler::SetEnabled(false);
+}
+
+#ifdef ENGINE_PROFILING
+TEST_CASE("Profiler zones of the engine") {
+  Profiler::Clear();
+  Profiler::SetEnabled(true);
+  EntityCollection entities;
+  std::vector<EntityID> ids;
+  for (std::size_t i = 0; i < 10; ++i) {
+    ComponentCollection data;
+    data.Emplace<Position>();
+    ids.push_back(entities.Insert(data).first);
+  }
+  Scheduler scheduler;
+  scheduler.Emplace<IntegrationSystem>();
+  scheduler.Run(entities);
+  scheduler.Run(entities);
+  CommandBuffer commands;
+  commands.Erase(ids[0]);
+  commands.Flush(entities);
+  static_cast<void>(entities.Remove<Position>(ids[1]));
+  Profiler::SetEnabled(false);
+
+  std::vector<ZoneSummary> summaries = Profiler::Summarize();
+  REQUIRE(FindZone(summaries, "Integration")->count == 2);
+  REQUIRE(FindZone(summaries, "EntityCollection::Insert")->count == 10);
+  REQUIRE(FindZone(summaries, "CommandBuffer::Flush")->count == 1);
+  REQUIRE(FindZone(summaries, "EntityCollection::Erase") != nullptr);
+  REQUIRE(FindZone(summaries, "EntityCollection::Remove")->count == 1);
+}
+#endif
\ No newline at end of file